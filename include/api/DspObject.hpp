@@ -1,8 +1,6 @@
 #ifndef API_DSP_OBJECT_HPP
 #define API_DSP_OBJECT_HPP
 
-#if !defined __link
-
 #include <arm_dsp_api.h>
 #include "WorkObject.hpp"
 #include "InfoObject.hpp"
@@ -54,6 +52,4 @@ protected:
 
 }
 
-#endif
-
 #endif // API_DSP_OBJECT_HPP
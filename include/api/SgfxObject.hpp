@@ -1,19 +1,54 @@
 #ifndef API_SGFX_OBJECT_HPP
 #define API_SGFX_OBJECT_HPP
 
+#include <sapi/sg.h>
 #include "WorkObject.hpp"
 #include "InfoObject.hpp"
 #include "../var/Data.hpp"
 
 namespace api {
 
+/*! \brief Sgfx Object
+ * \details The Sgfx Object Class holds the sgfx function table
+ * used by all the objects in the sgfx namespace.
+ *
+ * By default, the table is provided by sg_api(). On link builds,
+ * request_sgfx_api() installs a host implementation that draws
+ * bitmaps, rectangles, patterns and horizontal lines a word at a time.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * Bitmap::request_sgfx_api(); //do this once before drawing
+ * \endcode
+ *
+ */
+class SgfxObject {
+public:
+
+	/*! \details Returns the sgfx function table. */
+	static const sg_api_t * sgfx_api(){ return m_sgfx_api ? m_sgfx_api : sg_api(); }
+
+	/*! \details Sets the sgfx function table (null to use sg_api()). */
+	static void set_sgfx_api(const sg_api_t * api){ m_sgfx_api = api; }
+
+	/*! \details Installs the fastest available sgfx function table.
+	 *
+	 * @return Zero on success
+	 */
+	static int request_sgfx_api();
+
+private:
+	static const sg_api_t * m_sgfx_api;
+};
+
 /*! \brief Sgfx Information Object
  *
  * \details
  * \sa sgfx namespace
  *
  */
-class SgfxInfoObject : public virtual InfoObject {
+class SgfxInfoObject : public virtual InfoObject, public SgfxObject {
 
 };
 
@@ -23,7 +58,7 @@ class SgfxInfoObject : public virtual InfoObject {
  *
  * \sa sgfx namespace
  */
-class SgfxWorkObject : public virtual WorkObject {
+class SgfxWorkObject : public virtual WorkObject, public SgfxObject {
 
 };
 
@@ -34,7 +69,7 @@ class SgfxWorkObject : public virtual WorkObject {
  * \sa sgfx namespace
  *
  */
-class SgfxDataObject : public var::Data {
+class SgfxDataObject : public var::Data, public SgfxObject {
 
 };
 
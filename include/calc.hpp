@@ -12,7 +12,9 @@ namespace calc {}
 #include "calc/Checksum.hpp"
 #include "calc/Ema.hpp"
 #include "calc/Lookup.hpp"
+#include "calc/Lz.hpp"
 #include "calc/Pid.hpp"
+#include "calc/PidBank.hpp"
 #include "calc/Rle.hpp"
 
 using namespace calc;
@@ -0,0 +1,222 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef LZ_HPP_
+#define LZ_HPP_
+
+#include "../sys/File.hpp"
+#include "../var/Data.hpp"
+#include "../api/CalcObject.hpp"
+
+
+namespace calc {
+
+/*! \brief LZ77 Compression Class */
+/*! \details This class implements a fast LZ77 style compression
+ * algorithm that works well on text-like data such as logs, messages and fonts.
+ *
+ * The encoded data is a series of sequences. Each sequence
+ * has a token byte followed by a run of literal bytes and a match
+ * (a 16-bit offset to previously decoded data and a length). Decoding only requires
+ * the destination buffer (and the dictionary if one was used) so
+ * it uses very little memory.
+ *
+ * A dictionary is optional. It is data that logically precedes the source
+ * data. Matches can refer to the dictionary so small messages that
+ * share content with the dictionary compress much better. The same dictionary
+ * must be passed to decode() that was passed to encode().
+ *
+ * \code
+ * #include <sapi/calc.hpp>
+ * #include <sapi/var.hpp>
+ *
+ * Data encoded;
+ * Data decoded;
+ * int nbyte;
+ *
+ * nbyte = Lz::encode(encoded, log_data);
+ * if( nbyte > 0 ){
+ *  Lz::decode(decoded, encoded, nbyte);
+ * }
+ * \endcode
+ *
+ */
+class Lz : public api::CalcInfoObject {
+public:
+	Lz();
+
+	/*! \details Encodes a block of data.
+	 *
+	 * @param dest A pointer to the destination data
+	 * @param dest_size Pass the max size of dest, this will hold the number of encoded bytes upon return
+	 * @param src A pointer to the source data
+	 * @param src_size The number of bytes to encode
+	 * @param dictionary A pointer to the dictionary (or zero for none)
+	 * @param dictionary_size The number of bytes in the dictionary
+	 * @return Number of un-encoded bytes that were processed or less than zero if \a dest is too small
+	 *
+	 * The destination will never need more than calc_max_size() bytes.
+	 *
+	 */
+	static int encode(void * dest, s32 & dest_size, const void * src, s32 src_size, const void * dictionary = 0, s32 dictionary_size = 0);
+
+	/*! \details Encodes the data in \a src (all of src.capacity()).
+	 *
+	 * @param dest The destination data (resized as needed)
+	 * @param src The source data
+	 * @param dictionary The dictionary (empty for none)
+	 * @return The number of encoded bytes in \a dest or less than zero on an error
+	 */
+	static int encode(var::Data & dest, const var::Data & src, const var::Data & dictionary = var::Data());
+
+	/*! \details Decodes a block of data.
+	 *
+	 * @param dest A pointer to the destination data
+	 * @param dest_size Pass the max size of dest, this will hold the number of decoded bytes upon return
+	 * @param src A pointer to the encoded data
+	 * @param src_size The number of encoded bytes to process
+	 * @param dictionary A pointer to the dictionary used to encode the data (or zero for none)
+	 * @param dictionary_size The number of bytes in the dictionary
+	 * @return Number of encoded bytes that were processed or less than zero if the data is not valid or \a dest is too small
+	 */
+	static int decode(void * dest, s32 & dest_size, const void * src, s32 src_size, const void * dictionary = 0, s32 dictionary_size = 0);
+
+	/*! \details Decodes \a nbyte bytes of encoded data in \a src.
+	 *
+	 * @param dest The destination data (resized as needed)
+	 * @param src The encoded data
+	 * @param nbyte The number of encoded bytes (the value returned by encode())
+	 * @param dictionary The dictionary used to encode the data (empty for none)
+	 * @return The number of decoded bytes in \a dest or less than zero on an error
+	 */
+	static int decode(var::Data & dest, const var::Data & src, int nbyte, const var::Data & dictionary = var::Data());
+
+	/*! \details Calculates the maximum number of bytes needed to encode \a nbyte bytes. */
+	static int calc_max_size(int nbyte){ return nbyte + nbyte / 255 + 16; }
+
+	/*! \details Calculates the number of bytes encoded data will
+	 * occupy after it is decoded.
+	 *
+	 * @param src A pointer to the encoded data
+	 * @param nbyte The number of encoded bytes
+	 * @return The number of decoded bytes or less than zero if the data is not valid
+	 */
+	static int calc_decoded_size(const void * src, int nbyte);
+
+	enum {
+		MIN_MATCH /*! The minimum number of bytes in a match */ = 4,
+		MAX_OFFSET /*! The maximum distance to a match */ = 65535,
+		HASH_BITS /*! The number of bits used to hash a match candidate */ = 10,
+		HASH_SIZE /*! The number of entries in the encoder's hash table */ = (1<<HASH_BITS)
+	};
+
+protected:
+	/*! \cond */
+	static int encode_block(u8 * dest, s32 & dest_size, const u8 * src, s32 src_size, const u8 * dictionary, s32 dictionary_size, u16 * table);
+	/*! \endcond */
+
+};
+
+/*! \brief LZ77 Compressed File Class
+ * \details This class reads and writes compressed files.
+ *
+ * Data is compressed in blocks of up to BLOCK_SIZE bytes. Each block
+ * uses the previous WINDOW_SIZE bytes of the stream as its dictionary, so
+ * decoding a file only needs about WINDOW_SIZE + 2*BLOCK_SIZE bytes
+ * of memory no matter how big the file is. Blocks that don't compress
+ * are stored as they are.
+ *
+ * A file should be used for either reading or writing (not both).
+ *
+ * \code
+ * #include <sapi/calc.hpp>
+ *
+ * LzFile f;
+ * f.create("/home/log.lz");
+ * f.write(line, strlen(line));
+ * f.close(); //compresses and writes the remaining data
+ *
+ * f.open("/home/log.lz", File::RDONLY);
+ * while( (ret = f.read(buffer, 64)) > 0 ){
+ *  //use the decompressed data
+ * }
+ * f.close();
+ * \endcode
+ *
+ */
+class LzFile : public Lz, public sys::File {
+public:
+
+	/*! \details Constructs a new object. */
+	LzFile();
+
+	enum {
+		WINDOW_SIZE /*! The number of previous bytes that can be referenced by a match */ = 2048,
+		BLOCK_SIZE /*! The maximum number of bytes in a block */ = 1024
+	};
+
+	/*! \details Sets the dictionary for the stream.
+	 *
+	 * @param dictionary A pointer to the dictionary
+	 * @param nbyte The number of bytes in the dictionary (only the last WINDOW_SIZE bytes are used)
+	 * @return Zero on success or less than zero if memory could not be allocated
+	 *
+	 * This must be called before the first read() or write(). The
+	 * same dictionary must be used to read the file as was used to write it.
+	 *
+	 */
+	int set_dictionary(const void * dictionary, int nbyte);
+
+	/*! \details Closes the file after compressing and writing any data that is still buffered. */
+	int close();
+
+	/*! \details Compresses and writes any buffered data to the file.
+	 *
+	 * @return Zero on success or less than zero if the data could not be written
+	 */
+	int flush();
+
+	/*! \details Compresses and writes data to a file.
+	 *
+	 * @param buf The source data
+	 * @param nbyte The number of bytes to compress and write
+	 * @return The number of un-encoded bytes that were written
+	 */
+	int write(const void * buf, int nbyte);
+
+	/*! \details Reads from a file then decompresses data.
+	 *
+	 * @param buf A pointer to the destination memory
+	 * @param nbyte The maximum number of bytes to read
+	 * @return The number of bytes read after decoding
+	 */
+	int read(void * buf, int nbyte);
+
+private:
+	/*! \cond */
+	typedef struct MCU_PACK {
+		u16 encoded_size; //zero if the block is stored without compression
+		u16 decoded_size;
+	} frame_header_t;
+
+	enum {
+		FRAME_SIZE = sizeof(frame_header_t) + BLOCK_SIZE + BLOCK_SIZE / 255 + 16
+	};
+	/*! \endcond */
+
+	int init_buffer();
+	int read_frame();
+	void slide();
+
+	u8 * history() const { return (u8*)m_buffer.data(); }
+	u8 * block() const { return history() + WINDOW_SIZE; }
+	u8 * frame() const { return block() + BLOCK_SIZE; }
+	u16 * table() const { return (u16*)(frame() + FRAME_SIZE); }
+
+	var::Data m_buffer;
+	u32 m_window; //valid bytes of history before block()
+	u32 m_count; //bytes in block()
+	u32 m_offset; //next byte in block() to read
+};
+
+};
+#endif /* LZ_HPP_ */
@@ -0,0 +1,315 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef PID_BANK_HPP_
+#define PID_BANK_HPP_
+
+#include <float.h>
+#include <limits.h>
+#include "../api/CalcObject.hpp"
+#include "../var/Vector.hpp"
+
+namespace calc {
+
+/*! \brief Macro for creating a q16.16 gain value for PidBank_s32 */
+/*! \details The gain can be any value between -32768.0 and 32767.0.
+ */
+#define CALC_PID_Q16(x) ( (s32)((x) * 65536) )
+
+/*! \brief PID Control Loop Bank template class
+ * \details This class holds the state of many PID
+ * control loops that are updated at the same rate.
+ *
+ * The gains and state of all the loops are stored as contiguous
+ * arrays (structure-of-arrays) so that a single call to
+ * calc_control_variable() updates every loop in a tight
+ * loop that the compiler can vectorize.
+ *
+ * Each loop can be enabled or disabled using set_enabled(). The enable
+ * flags are stored as a bit mask with 32 loops per word. A disabled loop
+ * does not write its control variable and its state is not updated.
+ *
+ * The calculation for each loop is the same as Pid_f including
+ * anti-windup: the integral is not accumulated while the
+ * control variable is clamped to the minimum or maximum.
+ *
+ * \sa PidBank_f, PidBank_s32
+ *
+ */
+template<typename T> class PidBank : public api::CalcWorkObject {
+public:
+
+	/*! \details Constructs a new PID bank.
+	 *
+	 * @param count The number of loops in the bank
+	 * @param kp The initial proportional constant for all loops
+	 * @param min The initial minimum control variable for all loops
+	 * @param max The initial maximum control variable for all loops
+	 *
+	 * All loops are enabled with a proportional gain of \a kp, limits
+	 * of \a min and \a max, and zero for all other values.
+	 *
+	 */
+	PidBank(u32 count, T kp, T min, T max){
+		m_count = 0;
+		m_default_kp = kp;
+		m_default_min = min;
+		m_default_max = max;
+		resize(count);
+	}
+
+	/*! \details Changes the number of loops in the bank.
+	 *
+	 * @param count The number of loops
+	 * @return Zero on success or less than zero if memory could not be allocated
+	 *
+	 * All gains, limits and state values are reset to the values passed
+	 * to the constructor when the bank is resized.
+	 *
+	 */
+	int resize(u32 count){
+		if( (m_target.resize(count) < 0) ||
+				(m_error.resize(count) < 0) ||
+				(m_integral.resize(count) < 0) ||
+				(m_kp.resize(count) < 0) ||
+				(m_ki.resize(count) < 0) ||
+				(m_kd.resize(count) < 0) ||
+				(m_max.resize(count) < 0) ||
+				(m_min.resize(count) < 0) ||
+				(m_enabled.resize((count + 31) / 32) < 0) ){
+			m_count = 0;
+			return -1;
+		}
+		m_count = count;
+		m_target.fill(0);
+		m_kp.fill(m_default_kp);
+		m_ki.fill(0);
+		m_kd.fill(0);
+		m_max.fill(m_default_max);
+		m_min.fill(m_default_min);
+		m_enabled.fill(0xffffffff);
+		reset();
+		return 0;
+	}
+
+	/*! \details Returns the number of loops in the bank. */
+	u32 count() const { return m_count; }
+
+	/*! \details Resets the state (integral and error) of all loops. */
+	void reset(){
+		m_error.fill(0);
+		m_integral.fill(0);
+	}
+
+	/*! \details Resets the state of a single loop. */
+	void reset(u32 loop){
+		if( loop < count() ){
+			m_error[loop] = 0;
+			m_integral[loop] = 0;
+		}
+	}
+
+	/*! \details Sets the proportional constant value of \a loop. */
+	void set_kp(u32 loop, T v){ if( loop < count() ){ m_kp[loop] = v; } }
+	/*! \details Sets the integral constant value of \a loop. */
+	void set_ki(u32 loop, T v){ if( loop < count() ){ m_ki[loop] = v; } }
+	/*! \details Sets the differential constant value of \a loop. */
+	void set_kd(u32 loop, T v){ if( loop < count() ){ m_kd[loop] = v; } }
+	/*! \details Sets the maximum allowed value of the control variable of \a loop. */
+	void set_max(u32 loop, T v){ if( loop < count() ){ m_max[loop] = v; } }
+	/*! \details Sets the minimum allowed value of the control variable of \a loop. */
+	void set_min(u32 loop, T v){ if( loop < count() ){ m_min[loop] = v; } }
+	/*! \details Sets the value for the target variable of \a loop. */
+	void set_target(u32 loop, T v){ if( loop < count() ){ m_target[loop] = v; } }
+
+	/*! \details Returns the proportional constant of \a loop. */
+	T kp(u32 loop) const { return loop < count() ? m_kp[loop] : 0; }
+	/*! \details Returns the integral constant of \a loop. */
+	T ki(u32 loop) const { return loop < count() ? m_ki[loop] : 0; }
+	/*! \details Returns the differential constant of \a loop. */
+	T kd(u32 loop) const { return loop < count() ? m_kd[loop] : 0; }
+	/*! \details Returns the maximum value for the control variable of \a loop. */
+	T max(u32 loop) const { return loop < count() ? m_max[loop] : 0; }
+	/*! \details Returns the minimum value for the control variable of \a loop. */
+	T min(u32 loop) const { return loop < count() ? m_min[loop] : 0; }
+	/*! \details Returns the target variable of \a loop. */
+	T target(u32 loop) const { return loop < count() ? m_target[loop] : 0; }
+
+	/*! \details Returns a pointer to the target values of all loops.
+	 *
+	 * This can be used to update all targets with a single copy.
+	 *
+	 */
+	T * target_data(){ return m_target.vector_data(); }
+
+	/*! \details Enables or disables a single loop.
+	 *
+	 * @param loop The loop to enable or disable
+	 * @param value True to enable the loop
+	 *
+	 */
+	void set_enabled(u32 loop, bool value = true){
+		if( loop < count() ){
+			if( value ){
+				m_enabled[loop/32] |= ((u32)1<<(loop%32));
+			} else {
+				m_enabled[loop/32] &= ~((u32)1<<(loop%32));
+			}
+		}
+	}
+
+	/*! \details Returns true if \a loop is enabled. */
+	bool is_enabled(u32 loop) const {
+		if( loop < count() ){
+			return (m_enabled[loop/32] & ((u32)1<<(loop%32))) != 0;
+		}
+		return false;
+	}
+
+	/*! \details Sets the enable mask for 32 loops at a time.
+	 *
+	 * @param word The mask word (loops 32*word to 32*word+31)
+	 * @param mask The enable bits (bit 0 is loop 32*word)
+	 *
+	 */
+	void set_enabled_mask(u32 word, u32 mask){
+		if( word < m_enabled.count() ){
+			m_enabled[word] = mask;
+		}
+	}
+
+	/*! \details Returns the enable mask for loops 32*word to 32*word+31. */
+	u32 enabled_mask(u32 word) const {
+		if( word < m_enabled.count() ){
+			return m_enabled[word];
+		}
+		return 0;
+	}
+
+	/*! \details Calculates the control variables of all enabled loops.
+	 *
+	 * @param present_value An array of count() present values
+	 * @param control_variable An array of count() control variables to write
+	 * @return Zero on success or less than zero if the bank is empty
+	 *
+	 * The control variables of disabled loops are not written. The
+	 * \a present_value and \a control_variable arrays must not overlap.
+	 *
+	 */
+	int calc_control_variable(const T * present_value, T * control_variable){
+		u32 i;
+		u32 words;
+		u32 end;
+
+		if( count() == 0 ){
+			return -1;
+		}
+
+		words = m_enabled.count();
+		for(i=0; i < words; i++){
+			u32 mask = m_enabled[i];
+			end = (i+1)*32;
+			if( end > count() ){ end = count(); }
+			if( mask == 0xffffffff ){
+				//all loops in this word are enabled -- run the fast loop
+				calc_block(i*32, end, present_value, control_variable);
+			} else if( mask ){
+				u32 loop;
+				for(loop = i*32; loop < end; loop++){
+					if( mask & ((u32)1<<(loop%32)) ){
+						calc_block(loop, loop+1, present_value, control_variable);
+					}
+				}
+			}
+		}
+		return 0;
+	}
+
+protected:
+	/*! \cond */
+	/*! \details Updates loops \a begin to \a end - 1. */
+	virtual void calc_block(u32 begin, u32 end, const T * present_value, T * control_variable) = 0;
+
+	var::Vector<T> m_target;
+	var::Vector<T> m_error;
+	var::Vector<T> m_integral;
+	var::Vector<T> m_kp;
+	var::Vector<T> m_ki;
+	var::Vector<T> m_kd;
+	var::Vector<T> m_max;
+	var::Vector<T> m_min;
+	/*! \endcond */
+
+private:
+	var::Vector<u32> m_enabled;
+	u32 m_count;
+	T m_default_kp;
+	T m_default_min;
+	T m_default_max;
+};
+
+/*! \brief PID Control Loop Bank (float)
+ * \details See \ref PidBank for details.
+ *
+ * \code
+ * #include <sapi/calc.hpp>
+ *
+ * PidBank_f bank(24);
+ * float present_value[24];
+ * float control_variable[24];
+ *
+ * for(u32 i=0; i < bank.count(); i++){
+ *  bank.set_kp(i, 1.0f);
+ *  bank.set_ki(i, 0.1f);
+ *  bank.set_max(i, 1000.0f);
+ *  bank.set_min(i, 0.0f);
+ *  bank.set_target(i, 25.0f);
+ * }
+ *
+ * bank.set_enabled(5, false); //loop 5 is not updated
+ *
+ * //read present_value from sensors
+ * bank.calc_control_variable(present_value, control_variable);
+ * \endcode
+ *
+ */
+class PidBank_f : public PidBank<float> {
+public:
+	/*! \details Constructs a bank of \a count floating point PID loops.
+	 *
+	 * The control variables are not limited until set_min() and set_max() are used.
+	 */
+	PidBank_f(u32 count = 0) : PidBank<float>(count, 1.0f, -FLT_MAX, FLT_MAX){}
+
+protected:
+	/*! \cond */
+	void calc_block(u32 begin, u32 end, const float * present_value, float * control_variable);
+	/*! \endcond */
+};
+
+/*! \brief PID Control Loop Bank (s32)
+ * \details This class uses fixed point values. The target,
+ * present value, control variable, minimum and maximum values
+ * are plain s32 values. The gains are in q16.16 format (see \ref CALC_PID_Q16).
+ *
+ * Intermediate products are calculated using s64 values.
+ *
+ * See \ref PidBank for details.
+ *
+ */
+class PidBank_s32 : public PidBank<s32> {
+public:
+	/*! \details Constructs a bank of \a count fixed point PID loops.
+	 *
+	 * The control variables are limited to the s32 range until set_min() and set_max() are used.
+	 */
+	PidBank_s32(u32 count = 0) : PidBank<s32>(count, CALC_PID_Q16(1), INT_MIN, INT_MAX){}
+
+protected:
+	/*! \cond */
+	void calc_block(u32 begin, u32 end, const s32 * present_value, s32 * control_variable);
+	/*! \endcond */
+};
+
+}
+
+#endif /* PID_BANK_HPP_ */
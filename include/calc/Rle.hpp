@@ -48,7 +48,23 @@ public:
 	 */
 	static int calc_size(const void * src, int nbyte);
 
-private:
+	/*! \details Calculates the length of the run at the start of \a src.
+	 *
+	 * @param src A pointer to the source memory
+	 * @param nbyte The number of bytes available in \a src
+	 * @return The number of bytes (up to 255) that are equal to the first byte
+	 *
+	 * The bytes are compared a word at a time.
+	 *
+	 */
+	static int calc_run(const void * src, int nbyte);
+
+	enum {
+		MAX_RUN /*! The maximum number of bytes in a single run */ = 255
+	};
+
+protected:
+	/*! \cond */
 	typedef struct MCU_PACK {
 		u8 size;
 		u8 data;
@@ -58,11 +74,46 @@ private:
 		u32 size;
 		u32 data;
 	} element32_t;
+	/*! \endcond */
 
 };
 
+/*! \brief Run Length Encoded File Class
+ * \details This class reads and writes run length encoded
+ * files.
+ *
+ * Encoded data is buffered so that File::write() is only called
+ * when the buffer is full or when flush() or close() is called. Runs
+ * that span multiple calls to write() are merged.
+ *
+ * A file should be used for either reading or writing (not both).
+ *
+ * \code
+ * #include <sapi/calc.hpp>
+ *
+ * RleFile f;
+ * f.create("/home/data.rle");
+ * f.write(buffer, 1024);
+ * f.write(buffer, 1024);
+ * f.close(); //flushes the remaining encoded data
+ * \endcode
+ *
+ */
 class RleFile : public Rle, public sys::File {
 public:
+
+	/*! \details Constructs a new object. */
+	RleFile();
+
+	/*! \details Closes the file after writing any encoded data that is still buffered. */
+	int close();
+
+	/*! \details Writes any buffered encoded data to the file.
+	 *
+	 * @return Zero on success or less than zero if the data could not be written
+	 */
+	int flush();
+
 	/*! \details Encodes using run length encoding and writes the data to a file.
 	 *
 	 * @param buf The source data
@@ -81,9 +132,14 @@ public:
 
 private:
 	enum {
-		BUF_SIZE = 256
+		BUF_SIZE = 1024
 	};
-	char buf[BUF_SIZE];
+
+	int read_elements();
+
+	element_t m_buf[BUF_SIZE / sizeof(element_t)];
+	u32 m_count; //number of elements in m_buf
+	u32 m_offset; //next element to decode when reading
 };
 
 class RleAppfs : public Rle, public sys::Appfs {
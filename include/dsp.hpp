@@ -16,6 +16,15 @@ namespace dsp {}
 #include "dsp/SignalData.hpp"
 #include "dsp/Transform.hpp"
 #include "dsp/Filter.hpp"
+#include "dsp/Convolution.hpp"
+#include "dsp/FilterPipeline.hpp"
+#include "dsp/BiquadMultichannel.hpp"
+#include "dsp/Stft.hpp"
+#include "dsp/FftBatch.hpp"
+#include "dsp/Resampler.hpp"
+#include "dsp/Goertzel.hpp"
+#include "dsp/Statistics.hpp"
+#include "dsp/Matrix.hpp"
 
 using namespace dsp;
 
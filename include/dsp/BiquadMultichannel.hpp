@@ -0,0 +1,101 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_BIQUAD_MULTICHANNEL_HPP
+#define DSP_BIQUAD_MULTICHANNEL_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Vector.hpp"
+#include "Filter.hpp"
+
+namespace dsp {
+
+/*! \brief Multichannel Biquad Cascade
+ * \details The BiquadMultichannel class applies a biquad cascade to
+ * interleaved frames (L R L R ... or any number of channels) without
+ * de-interleaving the data.
+ *
+ * Coefficients and state are stored with one value per channel
+ * side by side (structure of arrays) so adjacent channels of a frame are
+ * filtered together. On host builds, the 32-bit floating point version filters
+ * 8 (AVX2) or 4 (SSE2) channels per vector.
+ *
+ * All channels can share one set of coefficients or each channel can have
+ * its own (set_coefficients()). The coefficients use the same format as the
+ * mono filters (BiquadCoefficientsQ15, BiquadCoefficientsQ31 and BiquadCoefficientsF32)
+ * and the arithmetic matches the full precision CMSIS direct form I functions
+ * (64-bit accumulator for fixed point).
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * BiquadCoefficientsF32 coefficients(4); //4 stage equalizer
+ * //... design coefficients
+ *
+ * BiquadMultichannelF32 equalizer(8, coefficients); //8 channels, shared coefficients
+ * SignalF32 frames(8*256); //256 interleaved frames
+ *
+ * while( read_samples(frames) ){
+ *   equalizer.process(frames.vector_data(), 256); //in place
+ *   write_samples(frames);
+ * }
+ * \endcode
+ *
+ */
+template<typename T, typename CoefficientsType> class BiquadMultichannel : public api::DspWorkObject {
+public:
+
+    /*! \details Constructs a filter where all channels use \a coefficients.
+     *
+     * @param channels The number of interleaved channels
+     * @param coefficients The coefficients for every channel
+     * @param post_shift The post shift (fixed point only)
+     *
+     */
+    BiquadMultichannel(u8 channels, const CoefficientsType & coefficients, s8 post_shift = 0);
+
+    /*! \details Constructs a filter with zero coefficients. Use set_coefficients()
+     * to assign coefficients to each channel.
+     */
+    BiquadMultichannel(u8 channels, u8 stages, s8 post_shift = 0);
+
+    /*! \details Sets the coefficients of one channel.
+     *
+     * @return Zero on success or -1 if \a channel or the number of stages is not valid
+     */
+    int set_coefficients(u8 channel, const CoefficientsType & coefficients);
+
+    /*! \details Returns the number of channels in each frame. */
+    u8 channels() const { return m_channels; }
+
+    /*! \details Returns the number of stages in the cascade. */
+    u8 stages() const { return m_stages; }
+
+    /*! \details Filters \a frames interleaved frames in place. */
+    void process(T * data, u32 frames);
+
+    /*! \details Filters the interleaved frames in \a input and writes them to \a output.
+     *
+     * @return Zero on success or -1 if the count of \a input is not a multiple of channels()
+     */
+    int process(var::Vector<T> & output, const var::Vector<T> & input);
+
+    /*! \details Clears the state of every channel. */
+    void reset();
+
+private:
+    void initialize(u8 channels, u8 stages, s8 post_shift);
+
+    u8 m_channels;
+    u8 m_stages;
+    s8 m_post_shift;
+    var::Vector<T> m_coefficients; //per stage: b0, b1, b2, a1 and a2 for each channel
+    var::Vector<T> m_state; //per stage: x[n-1], x[n-2], y[n-1] and y[n-2] for each channel
+};
+
+typedef BiquadMultichannel<q15_t, BiquadCoefficientsQ15> BiquadMultichannelQ15;
+typedef BiquadMultichannel<q31_t, BiquadCoefficientsQ31> BiquadMultichannelQ31;
+typedef BiquadMultichannel<float32_t, BiquadCoefficientsF32> BiquadMultichannelF32;
+
+}
+
+#endif // DSP_BIQUAD_MULTICHANNEL_HPP
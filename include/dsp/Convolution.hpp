@@ -0,0 +1,175 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_CONVOLUTION_HPP
+#define DSP_CONVOLUTION_HPP
+
+#include "../api/DspObject.hpp"
+#include "SignalData.hpp"
+#include "Transform.hpp"
+
+namespace dsp {
+
+/*! \brief Fast Convolution for 32-bit Floating Point Signals
+ * \details The ConvolutionF32 class convolves a signal with
+ * an impulse response using FFTs.
+ *
+ * Signals are processed one block at a time (uniformly partitioned
+ * overlap-save). The FFT of the impulse response as well as the overlap
+ * state are kept between calls so long impulse responses can
+ * be applied to a stream with the cost of two FFTs per block.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * SignalF32 impulse_response(4096);
+ * SignalF32 input(256);
+ * SignalF32 output(256);
+ * ...
+ * ConvolutionF32 convolution(impulse_response, 256);
+ * while( read_block(input) ){
+ *   convolution.convolve(output, input); //output is delayed by zero samples
+ *   write_block(output);
+ * }
+ * \endcode
+ *
+ * The static convolve() methods compute the complete convolution of
+ * two signals (overlap-add). SignalF32::convolve() uses them automatically
+ * when is_fft_faster() is true.
+ *
+ */
+class ConvolutionF32 : public api::DspWorkObject {
+public:
+
+    enum {
+        MIN_SAMPLES = 16 /*! Minimum block size (FFT size is twice the block size) */,
+        MAX_SAMPLES = 2048 /*! Maximum block size */
+    };
+
+    /*! \details Constructs a new streaming convolution.
+     *
+     * @param impulse_response The impulse response to apply (copied to the frequency domain)
+     * @param n_samples The number of samples in each block (a power of 2 from 16 to 2048)
+     *
+     * If \a n_samples is not valid, error_number() is set to EINVAL.
+     *
+     */
+    ConvolutionF32(const SignalF32 & impulse_response, u32 n_samples);
+
+    /*! \details Returns the number of samples processed on each call to convolve(). */
+    u32 samples() const { return m_samples; }
+
+    /*! \details Returns the number of partitions used to store the impulse response. */
+    u32 partitions() const { return m_partitions; }
+
+    /*! \details Convolves the next block of the stream.
+     *
+     * @param output Receives samples() output values
+     * @param input The next samples() input values
+     * @return Zero on success or -1 if the signal sizes don't match
+     *
+     * No dynamic memory is allocated.
+     *
+     */
+    int convolve(SignalF32 & output, const SignalF32 & input);
+
+    /*! \details Clears the overlap state (the impulse response is kept). */
+    void reset();
+
+    /*! \details Calculates the full convolution of \a a and \a b using FFTs.
+     *
+     * @param output Receives a.count() + b.count() - 1 values
+     * @return Zero on success or -1 if output is too small
+     *
+     */
+    static int convolve(SignalF32 & output, const SignalF32 & a, const SignalF32 & b);
+
+    /*! \details Returns true if convolving signals of length \a a_count
+     * and \a b_count is estimated to take fewer operations with FFTs than
+     * with direct convolution.
+     */
+    static bool is_fft_faster(u32 a_count, u32 b_count);
+
+    /*! \cond */
+    static void multiply_accumulate(float32_t * accumulator, const float32_t * a, const float32_t * b, u32 fft_samples);
+    /*! \endcond */
+
+private:
+    static u32 calc_fft_samples(u32 count);
+    static u32 calc_log2(u32 value);
+
+    FftRealF32 m_fft;
+    u32 m_samples;
+    u32 m_partitions;
+    u32 m_position;
+    SignalF32 m_impulse_response; //frequency domain partitions
+    SignalF32 m_history; //frequency domain input history (one spectrum per partition)
+    SignalF32 m_input; //the last two blocks of time domain input
+    SignalF32 m_accumulator;
+    SignalF32 m_scratch;
+
+};
+
+/*! \brief Fast Convolution for Fixed Point q1.31 Signals
+ * \details The ConvolutionQ31 class has the same interface as
+ * ConvolutionF32.
+ *
+ * The q1.31 FFT scales its output by 1/N so the frequency domain products
+ * lose too much precision for convolution. The blocks are instead converted to
+ * 32-bit floating point and processed with ConvolutionF32. The output
+ * is scaled like SignalQ31::convolve() and saturated.
+ *
+ */
+class ConvolutionQ31 : public api::DspWorkObject {
+public:
+
+    /*! \details Constructs a new streaming convolution.
+     *
+     * @param impulse_response The impulse response to apply
+     * @param n_samples The number of samples in each block (a power of 2 from 16 to 2048)
+     *
+     */
+    ConvolutionQ31(const SignalQ31 & impulse_response, u32 n_samples);
+
+    /*! \details Returns the number of samples processed on each call to convolve(). */
+    u32 samples() const { return m_convolution.samples(); }
+
+    /*! \details Convolves the next block of the stream.
+     *
+     * @param output Receives samples() output values
+     * @param input The next samples() input values
+     * @return Zero on success or -1 if the signal sizes don't match
+     *
+     */
+    int convolve(SignalQ31 & output, const SignalQ31 & input);
+
+    /*! \details Clears the overlap state (the impulse response is kept). */
+    void reset(){ m_convolution.reset(); }
+
+    /*! \details Calculates the full convolution of \a a and \a b using FFTs.
+     *
+     * @param output Receives a.count() + b.count() - 1 values
+     * @return Zero on success or -1 if output is too small
+     *
+     */
+    static int convolve(SignalQ31 & output, const SignalQ31 & a, const SignalQ31 & b);
+
+    /*! \details See ConvolutionF32::is_fft_faster(). */
+    static bool is_fft_faster(u32 a_count, u32 b_count){ return ConvolutionF32::is_fft_faster(a_count, b_count); }
+
+    /*! \cond */
+    static void convert(SignalF32 & output, const SignalQ31 & input);
+    static void convert(SignalQ31 & output, const SignalF32 & input);
+    /*! \endcond */
+
+private:
+    static SignalF32 convert(const SignalQ31 & input);
+
+    ConvolutionF32 m_convolution;
+    SignalF32 m_input;
+    SignalF32 m_output;
+
+};
+
+}
+
+#endif // DSP_CONVOLUTION_HPP
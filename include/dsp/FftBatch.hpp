@@ -0,0 +1,133 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_FFT_BATCH_HPP
+#define DSP_FFT_BATCH_HPP
+
+#include <pthread.h>
+#include "../api/DspObject.hpp"
+#include "SignalData.hpp"
+#include "Transform.hpp"
+
+namespace dsp {
+
+/*! \brief Batch Real FFT for Multichannel 32-bit Floating Point Signals
+ * \details The FftBatchRealF32 class applies the same real FFT to
+ * many channels with one call.
+ *
+ * The time domain buffer holds channels() * samples() values and can be
+ * channel major (all samples of channel 0, then channel 1, ...) or
+ * interleaved (sample 0 of each channel, then sample 1, ...).
+ *
+ * The frequency domain buffer is always channel major: channel \a c
+ * starts at c * samples() and uses the same packing as FftRealF32
+ * ([DC, Nyquist, re1, im1, re2, im2, ...]).
+ *
+ * When \a threads is more than one, the channels are divided into contiguous
+ * groups and each group is transformed by a worker sys::Thread (the calling thread
+ * transforms the first group). Each channel is computed with the same code
+ * and twiddle tables so the output does not depend on the number of threads.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * FftBatchRealF32 fft(1024, 32, 4); //32 channels of 1024 samples on 4 threads
+ * SignalF32 frame(32*1024); //interleaved from an ADC
+ * SignalF32 spectrum(32*1024);
+ *
+ * fft.transform(spectrum, frame, FftBatchRealF32::INTERLEAVED);
+ * //channel 5 bin 3 is (spectrum[5*1024 + 6], spectrum[5*1024 + 7])
+ * \endcode
+ *
+ * All memory is allocated and the worker threads are created by the constructor.
+ * The workers wait for a batch between calls to transform() and exit when the
+ * object is destroyed. If a worker can't be created, its channels are transformed
+ * by the calling thread. transform() must not be called by more than one thread at a time.
+ *
+ */
+class FftBatchRealF32 : public api::DspWorkObject {
+public:
+
+    /*! \details Layout of the time domain buffer */
+    enum layout {
+        CHANNEL_MAJOR /*! Samples of each channel are contiguous */,
+        INTERLEAVED /*! Channels of each sample are contiguous */
+    };
+
+    enum {
+        MAX_THREADS = 8 /*! Maximum number of threads used to transform a batch */
+    };
+
+    /*! \details Constructs a new batch transform.
+     *
+     * @param n_samples The number of samples in each channel (a power of 2 from 32 to 4096)
+     * @param channels The number of channels in each batch
+     * @param threads The number of threads to use (1 to MAX_THREADS)
+     *
+     */
+    FftBatchRealF32(u32 n_samples, u32 channels, u32 threads = 1);
+
+    ~FftBatchRealF32();
+
+    /*! \details Returns the number of samples in each channel. */
+    u32 samples() const { return m_fft.samples(); }
+
+    /*! \details Returns the number of channels in each batch. */
+    u32 channels() const { return m_channels; }
+
+    /*! \details Returns the number of threads used for each batch. */
+    u32 threads() const { return m_threads; }
+
+    /*! \details Transforms each channel.
+     *
+     * @param output Destination (channels() * samples() values)
+     * @param input Source (channels() * samples() values, not modified)
+     * @param time_layout The layout of the time domain buffer (\a input for a forward transform and \a output for an inverse)
+     * @param is_inverse True to calculate the inverse transform
+     * @return Zero on success or -1 if the signal sizes don't match
+     *
+     */
+    int transform(SignalF32 & output, const SignalF32 & input, enum layout time_layout = CHANNEL_MAJOR, bool is_inverse = false);
+
+private:
+    /*! \cond */
+    typedef struct {
+        const float32_t * input;
+        float32_t * output;
+        float32_t * scratch;
+        u32 first;
+        u32 last;
+        enum layout time_layout;
+        bool is_inverse;
+    } job_t;
+    /*! \endcond */
+
+    class Worker;
+
+    //copies would share the workers
+    FftBatchRealF32(const FftBatchRealF32 & a);
+    FftBatchRealF32 & operator = (const FftBatchRealF32 & a);
+
+    static void * execute_worker(void * args);
+    void transform_channels(const job_t & job);
+
+    FftRealF32 m_fft;
+    u32 m_channels;
+    u32 m_threads;
+    SignalF32 m_scratch; //two samples() buffers per thread
+
+    //workers 1 to threads() - 1 (the calling thread is worker 0)
+    Worker * m_workers;
+    job_t m_jobs[MAX_THREADS];
+    u32 m_groups;
+    u32 m_batch; //incremented to start each batch
+    u32 m_pending; //workers that haven't finished the batch
+    bool m_is_stopping;
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_start;
+    pthread_cond_t m_done;
+
+};
+
+}
+
+#endif // DSP_FFT_BATCH_HPP
@@ -80,12 +80,12 @@ public:
 
     u8 stages() const { return count() / 5; }
 
-    q31_t & b0(u32 stage){ return at(stage*6 + 0); }
-    q31_t & b1(u32 stage){ return at(stage*6 + 1); }
-    q31_t & b2(u32 stage){ return at(stage*6 + 2); }
+    q31_t & b0(u32 stage){ return at(stage*5 + 0); }
+    q31_t & b1(u32 stage){ return at(stage*5 + 1); }
+    q31_t & b2(u32 stage){ return at(stage*5 + 2); }
 
-    q31_t & a1(u32 stage){ return at(stage*6 + 3); }
-    q31_t & a2(u32 stage){ return at(stage*6 + 4); }
+    q31_t & a1(u32 stage){ return at(stage*5 + 3); }
+    q31_t & a2(u32 stage){ return at(stage*5 + 4); }
 
 private:
 
@@ -108,12 +108,12 @@ public:
 
     u8 stages() const { return count() / 5; }
 
-    float32_t & b0(u32 stage){ return at(stage*6 + 0); }
-    float32_t & b1(u32 stage){ return at(stage*6 + 1); }
-    float32_t & b2(u32 stage){ return at(stage*6 + 2); }
+    float32_t & b0(u32 stage){ return at(stage*5 + 0); }
+    float32_t & b1(u32 stage){ return at(stage*5 + 1); }
+    float32_t & b2(u32 stage){ return at(stage*5 + 2); }
 
-    float32_t & a1(u32 stage){ return at(stage*6 + 3); }
-    float32_t & a2(u32 stage){ return at(stage*6 + 4); }
+    float32_t & a1(u32 stage){ return at(stage*5 + 3); }
+    float32_t & a2(u32 stage){ return at(stage*5 + 4); }
 
 private:
 
@@ -132,6 +132,7 @@ private:
 class FirDecimateFilterQ31 : public Filter<arm_fir_decimate_instance_q31> {
 public:
     FirDecimateFilterQ31(const SignalQ31 & coefficients, u8 M, u32 n_samples);
+    u32 samples() const { return m_state.count(); }
 
 private:
     SignalQ31 m_state;
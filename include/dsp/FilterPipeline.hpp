@@ -0,0 +1,271 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_FILTER_PIPELINE_HPP
+#define DSP_FILTER_PIPELINE_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Ring.hpp"
+#include "Filter.hpp"
+
+namespace dsp {
+
+/*! \brief Filter Stage
+ * \details A FilterStage is one step of a FilterPipeline.
+ *
+ * Stages process data in place and keep their state between
+ * calls so a stream can be processed in chunks of any length.
+ *
+ */
+template<typename T> class FilterStage : public api::DspWorkObject {
+public:
+    virtual ~FilterStage(){}
+
+    /*! \details Processes \a count samples in place.
+     *
+     * @param data The samples to process (overwritten with the output)
+     * @param count The number of input samples
+     * @return The number of output samples (less than \a count for decimators)
+     *
+     */
+    virtual u32 process(T * data, u32 count) = 0;
+
+    /*! \details Resets any state held by the stage. */
+    virtual void reset(){}
+};
+
+/*! \brief FIR Filter Stage
+ * \details The FirStage class applies an FIR filter (FirFilterQ15, FirFilterQ31
+ * or FirFilterF32) to a stream. The filter holds the state and must
+ * remain valid while the stage is used.
+ *
+ * Chunks longer than the block size the filter was created with
+ * are processed in several calls.
+ *
+ */
+template<typename T, typename FilterType> class FirStage : public FilterStage<T> {
+public:
+    FirStage(const FilterType & filter) : m_filter(filter){}
+    u32 process(T * data, u32 count);
+
+private:
+    const FilterType & m_filter;
+};
+
+typedef FirStage<q15_t, FirFilterQ15> FirStageQ15;
+typedef FirStage<q31_t, FirFilterQ31> FirStageQ31;
+typedef FirStage<float32_t, FirFilterF32> FirStageF32;
+
+/*! \brief Biquad Filter Stage
+ * \details The BiquadStage class applies a biquad cascade (BiquadFilterQ15,
+ * BiquadFilterQ31 or BiquadFilterF32) to a stream.
+ *
+ */
+template<typename T, typename FilterType> class BiquadStage : public FilterStage<T> {
+public:
+    BiquadStage(const FilterType & filter) : m_filter(filter){}
+    u32 process(T * data, u32 count);
+
+private:
+    const FilterType & m_filter;
+};
+
+typedef BiquadStage<q15_t, BiquadFilterQ15> BiquadStageQ15;
+typedef BiquadStage<q31_t, BiquadFilterQ31> BiquadStageQ31;
+typedef BiquadStage<float32_t, BiquadFilterF32> BiquadStageF32;
+
+/*! \brief Gain Stage
+ * \details The GainStage class scales each sample.
+ *
+ * For fixed point types the gain is \a scale_fraction * 2^shift (like SignalQ15::scale()).
+ * The shift is ignored for floating point.
+ *
+ */
+template<typename T> class GainStage : public FilterStage<T> {
+public:
+    GainStage(T scale_fraction, s8 shift = 0){
+        m_scale_fraction = scale_fraction;
+        m_shift = shift;
+    }
+
+    void set_gain(T scale_fraction, s8 shift = 0){
+        m_scale_fraction = scale_fraction;
+        m_shift = shift;
+    }
+
+    u32 process(T * data, u32 count);
+
+private:
+    T m_scale_fraction;
+    s8 m_shift;
+};
+
+typedef GainStage<q15_t> GainStageQ15;
+typedef GainStage<q31_t> GainStageQ31;
+typedef GainStage<float32_t> GainStageF32;
+
+/*! \brief Decimate Stage
+ * \details The DecimateStage class keeps every Nth sample of the
+ * stream. It should follow a low pass (anti-aliasing) stage.
+ *
+ * The decimation phase is kept between calls so chunks
+ * don't need to be a multiple of the factor.
+ *
+ */
+template<typename T> class DecimateStage : public FilterStage<T> {
+public:
+    DecimateStage(u32 factor){
+        m_factor = factor ? factor : 1;
+        m_phase = 0;
+    }
+
+    u32 process(T * data, u32 count);
+    void reset(){ m_phase = 0; }
+
+private:
+    u32 m_factor;
+    u32 m_phase;
+};
+
+typedef DecimateStage<q15_t> DecimateStageQ15;
+typedef DecimateStage<q31_t> DecimateStageQ31;
+typedef DecimateStage<float32_t> DecimateStageF32;
+
+/*! \brief FIR Decimate Stage for q1.31
+ * \details The FirDecimateStageQ31 class filters and decimates
+ * using a FirDecimateFilterQ31 (only the outputs that are kept are calculated).
+ *
+ * Samples that don't complete a group of M are held until the next call.
+ *
+ */
+class FirDecimateStageQ31 : public FilterStage<q31_t> {
+public:
+    FirDecimateStageQ31(const FirDecimateFilterQ31 & filter);
+    u32 process(q31_t * data, u32 count);
+    void reset(){ m_pending_count = 0; }
+
+private:
+    enum { MAX_FACTOR = 16 };
+    const FirDecimateFilterQ31 & m_filter;
+    q31_t m_pending[MAX_FACTOR];
+    u32 m_pending_count;
+};
+
+/*! \brief Filter Pipeline
+ * \details The FilterPipeline class chains filter stages
+ * to process a continuous stream.
+ *
+ * All memory is allocated when the pipeline is constructed. Each stage
+ * works in place on the same buffer so no memory is allocated
+ * while processing.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * FirFilterF32 anti_alias(coefficients, 256);
+ * BiquadFilterF32 notch(notch_coefficients);
+ *
+ * FirStageF32 fir(anti_alias);
+ * DecimateStageF32 decimate(4);
+ * BiquadStageF32 biquad(notch);
+ * GainStageF32 gain(0.5f);
+ *
+ * FilterPipelineF32 pipeline(256);
+ * pipeline.append(fir);
+ * pipeline.append(decimate);
+ * pipeline.append(biquad);
+ * pipeline.append(gain);
+ *
+ * //samples are pushed to input by a driver callback
+ * pipeline.process(input, output); //input and output are Ring<float32_t>
+ * \endcode
+ *
+ * For multichannel streams, use one pipeline (and one set of filters) per channel.
+ *
+ */
+template<typename T> class FilterPipeline : public api::DspWorkObject {
+public:
+
+    enum {
+        MAX_STAGES = 8 /*! Maximum number of stages in a pipeline */
+    };
+
+    /*! \details Constructs a new pipeline.
+     *
+     * @param n_samples The number of samples to read from a Ring on each pass
+     *
+     */
+    FilterPipeline(u32 n_samples){
+        m_count = 0;
+        m_buffer.resize(n_samples);
+    }
+
+    /*! \details Appends a stage to the end of the pipeline.
+     *
+     * @return Zero on success or -1 if the pipeline already has MAX_STAGES stages
+     *
+     */
+    int append(FilterStage<T> & stage){
+        if( m_count == MAX_STAGES ){ return -1; }
+        m_stages[m_count++] = &stage;
+        return 0;
+    }
+
+    /*! \details Returns the number of stages in the pipeline. */
+    u32 stages() const { return m_count; }
+
+    /*! \details Returns the number of samples read from a Ring on each pass. */
+    u32 samples() const { return m_buffer.count(); }
+
+    /*! \details Processes \a count samples in place.
+     *
+     * @return The number of output samples (written to the start of \a data)
+     */
+    u32 process(T * data, u32 count){
+        u32 i;
+        for(i=0; i < m_count; i++){
+            count = m_stages[i]->process(data, count);
+        }
+        return count;
+    }
+
+    /*! \details Processes all the samples available in \a input
+     * and writes the output to \a output.
+     *
+     * @return The number of samples written to \a output
+     *
+     * All of \a input is consumed. If \a output fills up (and doesn't allow
+     * overflow), the output samples that don't fit are dropped. The return value
+     * is less than the number of output samples produced when this happens.
+     *
+     */
+    u32 process(var::Ring<T> & input, var::Ring<T> & output){
+        u32 total = 0;
+        int count;
+        while( (count = input.read(m_buffer.vector_data(), m_buffer.count())) > 0 ){
+            count = process(m_buffer.vector_data(), count);
+            total += output.write(m_buffer.vector_data_const(), count);
+        }
+        return total;
+    }
+
+    /*! \details Resets the state of each stage. */
+    void reset(){
+        u32 i;
+        for(i=0; i < m_count; i++){
+            m_stages[i]->reset();
+        }
+    }
+
+private:
+    FilterStage<T> * m_stages[MAX_STAGES];
+    u32 m_count;
+    var::Vector<T> m_buffer;
+};
+
+typedef FilterPipeline<q15_t> FilterPipelineQ15;
+typedef FilterPipeline<q31_t> FilterPipelineQ31;
+typedef FilterPipeline<float32_t> FilterPipelineF32;
+
+}
+
+#endif // DSP_FILTER_PIPELINE_HPP
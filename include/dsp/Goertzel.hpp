@@ -0,0 +1,122 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_GOERTZEL_HPP
+#define DSP_GOERTZEL_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Vector.hpp"
+#include "../var/Ring.hpp"
+#include "SignalData.hpp"
+
+namespace dsp {
+
+/*! \cond */
+template<typename T> struct GoertzelState {
+    typedef s64 state_type; //q1.31 with 32 guard bits
+    typedef s32 coefficient_type; //q2.29
+};
+
+template<> struct GoertzelState<float32_t> {
+    typedef float32_t state_type;
+    typedef float32_t coefficient_type;
+};
+/*! \endcond */
+
+/*! \brief Goertzel Filter Bank
+ * \details The GoertzelBank class calculates the power at a set of
+ * frequencies over blocks of block_size() samples. When only a few bins
+ * are needed (DTMF, tone detection, machine monitoring), this is much
+ * cheaper than calculating the FFT of each block.
+ *
+ * The coefficients and states are stored as arrays (one value per bin) so
+ * each input sample updates all the bins in one pass. On host builds,
+ * the 32-bit floating point version updates 4 (SSE2) or 8 (AVX2) bins at a time.
+ *
+ * Input can be passed in chunks of any length. The state is kept between
+ * calls and power() is updated each time a block is complete.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * const float32_t dtmf[] = { 697, 770, 852, 941, 1209, 1336, 1477, 1633 };
+ * var::Vector<float32_t> frequencies(8);
+ * memcpy(frequencies.vector_data(), dtmf, sizeof(dtmf));
+ *
+ * GoertzelBankQ15 bank(frequencies, 8000.0f, 205);
+ * SignalQ15 input(160);
+ *
+ * while( read_samples(input) ){
+ *   if( bank.process(input) ){
+ *     //bank.power()[i] is the power of frequency i in the last block
+ *   }
+ * }
+ * \endcode
+ *
+ * The power is the squared amplitude of a sine wave at the
+ * frequency (1.0 for a full scale tone).
+ *
+ * The fixed point versions update 64-bit states with q2.29 coefficients.
+ * Bins near DC grow with the square of the block size so blocks
+ * should be no longer than 8192 samples.
+ *
+ */
+template<typename T> class GoertzelBank : public api::DspWorkObject {
+public:
+
+    /*! \details Constructs a new filter bank.
+     *
+     * @param frequencies The frequency of each bin
+     * @param sample_rate The sample rate in the same units as \a frequencies
+     * @param block_size The number of samples in each block
+     *
+     */
+    GoertzelBank(const var::Vector<float32_t> & frequencies, float32_t sample_rate, u32 block_size);
+
+    /*! \details Returns the number of frequencies. */
+    u32 bins() const { return m_bins; }
+
+    /*! \details Returns the number of samples in each block. */
+    u32 block_size() const { return m_block_size; }
+
+    /*! \details Returns the power of each bin for the last complete block. */
+    const var::Vector<float32_t> & power() const { return m_power; }
+
+    /*! \details Processes \a input (any length).
+     *
+     * @return The number of blocks completed
+     *
+     */
+    u32 process(const var::Vector<T> & input);
+
+    /*! \details Processes \a input and writes bins() power values to \a output for
+     * each complete block.
+     *
+     * @return The number of blocks completed
+     */
+    u32 process(var::Ring<float32_t> & output, const var::Vector<T> & input);
+
+    /*! \details Discards the partial block. */
+    void reset();
+
+private:
+    typedef typename GoertzelState<T>::state_type state_type;
+    typedef typename GoertzelState<T>::coefficient_type coefficient_type;
+
+    u32 process(const T * input, u32 count, var::Ring<float32_t> * ring);
+    void calculate_power();
+
+    u32 m_bins;
+    u32 m_block_size;
+    u32 m_fill; //samples in the current block
+    var::Vector<coefficient_type> m_coefficient; //2*cos(w) for each bin (padded to a multiple of 8)
+    var::Vector<state_type> m_state; //s[n-1] for all bins followed by s[n-2] for all bins
+    var::Vector<float32_t> m_power;
+};
+
+typedef GoertzelBank<q15_t> GoertzelBankQ15;
+typedef GoertzelBank<q31_t> GoertzelBankQ31;
+typedef GoertzelBank<float32_t> GoertzelBankF32;
+
+}
+
+#endif // DSP_GOERTZEL_HPP
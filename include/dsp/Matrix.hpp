@@ -1,119 +1,255 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
 #ifndef DSP_MATRIX_HPP
 #define DSP_MATRIX_HPP
 
 #include "../api/DspObject.hpp"
 #include "../var/Vector.hpp"
 
+namespace dsp {
+
+/*! \brief Matrix Template Class
+ * \details The Matrix class stores the elements of a matrix in
+ * row major order along with the CMSIS matrix instance.
+ *
+ * Use MatrixQ15, MatrixQ31 or MatrixF32 to perform calculations.
+ *
+ */
 template<typename T, typename M> class Matrix : public var::Vector<T>, public api::DspWorkObject {
 public:
 
-    Matrix(){}
-    Matrix(u16 rows, u16 columns){
-        var::Vector<T>::resize(rows * columns);
-    }
+    /*! \details Constructs an empty matrix. */
+    Matrix(){ set_size(0, 0); }
 
-    u16 rows() const { return instance()->numRows; }
-    u16 columns() const { return instance()->numCols; }
+    /*! \details Constructs a matrix with uninitialized elements. */
+    Matrix(u16 rows, u16 columns){ set_size(rows, columns); }
 
-    M * instance(){ return &m_instance; }
-    const M * instance(){ return &m_instance; }
+    /*! \details Constructs a copy of \a a (the working memory is not copied). */
+    Matrix(const Matrix & a) : var::Vector<T>(a){ m_instance = a.m_instance; }
 
-private:
-    M m_instance;
+    /*! \details Assigns the elements of \a a (the working memory is not copied). */
+    Matrix & operator = (const Matrix & a){
+        var::Vector<T>::operator = (a);
+        m_instance = a.m_instance;
+        return *this;
+    }
 
-};
+    /*! \details Returns the number of rows. */
+    u16 rows() const { return m_instance.numRows; }
+
+    /*! \details Returns the number of columns. */
+    u16 columns() const { return m_instance.numCols; }
+
+    /*! \details Returns true if the matrix has the same number of rows and columns. */
+    bool is_square() const { return rows() == columns(); }
+
+    /*! \details Changes the size of the matrix.
+     *
+     * @return Zero on success or -1 if memory could not be allocated
+     *
+     * The elements are not initialized. Memory is only
+     * allocated if the new size is larger than the current capacity.
+     *
+     */
+    int set_size(u16 rows, u16 columns){
+        if( var::Vector<T>::resize((u32)rows * columns) < 0 ){
+            return -1;
+        }
+        m_instance.numRows = rows;
+        m_instance.numCols = columns;
+        return 0;
+    }
 
-class MatrixQ15 : public Matrix<q15_t, arm_matrix_instance_q15> {
-public:
+    /*! \details Accesses the element at \a row and \a column. */
+    T & at(u16 row, u16 column){ return var::Vector<T>::vector_data()[(u32)row*columns() + column]; }
 
-    MatrixQ15(){
-        arm_dsp_api_q15()->mat_init(instance(), 0, 0, 0);
-    }
+    /*! \details Accesses the element at \a row and \a column (read only). */
+    const T & at(u16 row, u16 column) const { return var::Vector<T>::vector_data_const()[(u32)row*columns() + column]; }
 
-    MatrixQ15(u16 rows, u16 columns) : Matrix<q31_t>(rows, columns){
-        arm_dsp_api_q15()->mat_init(instance(), rows, columns, vector_data());
+    /*! \details Returns the CMSIS instance. */
+    const M * instance() const {
+        //the data may have moved since the last call (copy, transfer or resize)
+        m_instance.pData = (T*)var::Vector<T>::vector_data_const();
+        return &m_instance;
     }
 
-    MatrixQ15 operator + (const MatrixQ15 & a) const {
-        MatrixQ15 ret(rows(), columns());
-        arm_dsp_api_q15()->mat_add(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
+protected:
+    M * instance(){
+        m_instance.pData = var::Vector<T>::vector_data();
+        return &m_instance;
     }
 
-    MatrixQ15 operator - (const MatrixQ15 & a) const {
-        MatrixQ15 ret(rows(), columns());
-        arm_dsp_api_q15()->mat_sub(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
+    /*! \details Returns working memory for \a count elements or zero if it can't be allocated.
+     *
+     * The memory is kept between calls so it is only allocated when a larger size is needed.
+     */
+    T * scratch(u32 count) const {
+        if( m_scratch.resize(count) < 0 ){
+            return 0;
+        }
+        return m_scratch.vector_data();
     }
 
 private:
+    mutable M m_instance;
+    mutable var::Vector<T> m_scratch;
 
+};
 
+/*! \brief Matrix q1.15
+ * \details The MatrixQ15 class performs matrix operations
+ * on q1.15 fixed point values.
+ *
+ * Each operation has a version that returns a new matrix and a
+ * version that writes to \a output. The \a output matrix is sized as needed (memory is only
+ * allocated if it doesn't already have enough capacity) so the
+ * same output can be reused without allocating. For add(), subtract()
+ * and scale(), \a output can be the same object (in place).
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * MatrixQ15 a(4,4);
+ * MatrixQ15 b(4,4);
+ * MatrixQ15 c;
+ *
+ * a.multiply(c, b); //c = a * b
+ * c.scale(c, 16384); //c = c * 0.5 in place
+ * \endcode
+ *
+ * The product is accumulated in 64-bits and saturated.
+ *
+ * multiply() keeps the transpose of \a a in working memory that belongs to this object
+ * (and inverse() does the same with its source in MatrixF32) so the same matrix
+ * should not be multiplied or inverted by more than one thread at a time.
+ *
+ */
+class MatrixQ15 : public Matrix<q15_t, arm_matrix_instance_q15> {
+public:
+    MatrixQ15(){}
+    MatrixQ15(u16 rows, u16 columns) : Matrix(rows, columns){}
+
+    MatrixQ15 operator + (const MatrixQ15 & a) const;
+    MatrixQ15 operator - (const MatrixQ15 & a) const;
+    MatrixQ15 operator * (const MatrixQ15 & a) const;
+    MatrixQ15 & operator += (const MatrixQ15 & a);
+    MatrixQ15 & operator -= (const MatrixQ15 & a);
+    MatrixQ15 & operator *= (const MatrixQ15 & a);
+
+    /*! \details Calculates \a output = this + \a a.
+     *
+     * @return Zero on success or -1 if the sizes don't match (error_number() is EINVAL)
+     */
+    int add(MatrixQ15 & output, const MatrixQ15 & a) const;
+
+    /*! \details Calculates \a output = this - \a a. */
+    int subtract(MatrixQ15 & output, const MatrixQ15 & a) const;
+
+    /*! \details Calculates \a output = this * \a a.
+     *
+     * @return Zero on success or -1 if columns() doesn't match \a a.rows()
+     */
+    int multiply(MatrixQ15 & output, const MatrixQ15 & a) const;
+
+    MatrixQ15 transpose() const;
+    /*! \details Writes the transpose to \a output (which can be this object). */
+    int transpose(MatrixQ15 & output) const;
+
+    MatrixQ15 inverse() const;
+    /*! \details Writes the inverse to \a output.
+     *
+     * The inverse is calculated in floating point then
+     * converted back to q1.15 with saturation.
+     *
+     * @return Zero on success or -1 if the matrix is not square or is singular
+     */
+    int inverse(MatrixQ15 & output) const;
+
+    MatrixQ15 scale(q15_t scale_fraction, s8 shift = 0) const;
+    /*! \details Multiplies each element by \a scale_fraction * 2^\a shift. */
+    int scale(MatrixQ15 & output, q15_t scale_fraction, s8 shift = 0) const;
 
 };
 
+/*! \brief Matrix q1.31
+ * \details The MatrixQ31 class has the same interface
+ * as MatrixQ15.
+ *
+ * The product is accumulated in 64-bits and truncated to q1.31 without
+ * saturation (like the CMSIS function) so inputs should be scaled
+ * down by log2(columns()) bits to avoid overflow.
+ *
+ */
 class MatrixQ31 : public Matrix<q31_t, arm_matrix_instance_q31> {
 public:
+    MatrixQ31(){}
+    MatrixQ31(u16 rows, u16 columns) : Matrix(rows, columns){}
 
-    MatrixQ31(){
-        arm_dsp_api_q31()->mat_init(instance(), 0, 0, 0);
-    }
+    MatrixQ31 operator + (const MatrixQ31 & a) const;
+    MatrixQ31 operator - (const MatrixQ31 & a) const;
+    MatrixQ31 operator * (const MatrixQ31 & a) const;
+    MatrixQ31 & operator += (const MatrixQ31 & a);
+    MatrixQ31 & operator -= (const MatrixQ31 & a);
+    MatrixQ31 & operator *= (const MatrixQ31 & a);
 
-    MatrixQ31(u16 rows, u16 columns) : Matrix<q31_t>(rows, columns){
-        arm_dsp_api_q31()->mat_init(instance(), rows, columns, vector_data());
-    }
+    int add(MatrixQ31 & output, const MatrixQ31 & a) const;
+    int subtract(MatrixQ31 & output, const MatrixQ31 & a) const;
+    int multiply(MatrixQ31 & output, const MatrixQ31 & a) const;
 
-    MatrixQ31 operator + (const MatrixQ31 & a) const {
-        MatrixQ31 ret(rows(), columns());
-        arm_dsp_api_q31()->mat_add(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
-    }
-
-    MatrixQ31 operator - (const MatrixQ31 & a) const {
-        MatrixQ31 ret(rows(), columns());
-        arm_dsp_api_q31()->mat_sub(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
-    }
-
-private:
+    MatrixQ31 transpose() const;
+    int transpose(MatrixQ31 & output) const;
 
+    MatrixQ31 inverse() const;
+    int inverse(MatrixQ31 & output) const;
 
+    MatrixQ31 scale(q31_t scale_fraction, s8 shift = 0) const;
+    int scale(MatrixQ31 & output, q31_t scale_fraction, s8 shift = 0) const;
 
 };
 
+/*! \brief Matrix 32-bit Floating Point
+ * \details The MatrixF32 class has the same interface
+ * as MatrixQ15.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * //Kalman gain: K = P * H' * inverse(H * P * H' + R)
+ * MatrixF32 ht = h.transpose();
+ * MatrixF32 k = p * ht * (h * p * ht + r).inverse();
+ * \endcode
+ *
+ */
 class MatrixF32 : public Matrix<float32_t, arm_matrix_instance_f32> {
 public:
+    MatrixF32(){}
+    MatrixF32(u16 rows, u16 columns) : Matrix(rows, columns){}
 
-    MatrixF32(){
-        arm_dsp_api_f32()->mat_init(instance(), 0, 0, 0);
-    }
+    MatrixF32 operator + (const MatrixF32 & a) const;
+    MatrixF32 operator - (const MatrixF32 & a) const;
+    MatrixF32 operator * (const MatrixF32 & a) const;
+    MatrixF32 & operator += (const MatrixF32 & a);
+    MatrixF32 & operator -= (const MatrixF32 & a);
+    MatrixF32 & operator *= (const MatrixF32 & a);
 
-    MatrixF32(u16 rows, u16 columns) : Matrix<float32_t>(rows, columns){
-        arm_dsp_api_f32()->mat_init(instance(), rows, columns, vector_data());
-    }
-
-    MatrixF32 operator + (const MatrixF32 & a) const {
-        MatrixF32 ret(rows(), columns());
-        arm_dsp_api_f32()->mat_add(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
-    }
+    int add(MatrixF32 & output, const MatrixF32 & a) const;
+    int subtract(MatrixF32 & output, const MatrixF32 & a) const;
+    int multiply(MatrixF32 & output, const MatrixF32 & a) const;
 
-    MatrixF32 operator - (const MatrixF32 & a) const {
-        MatrixF32 ret(rows(), columns());
-        arm_dsp_api_f32()->mat_sub(instance(), a.instance(), ret.instance());
-        ret.set_transfer_ownership();
-        return ret;
-    }
+    MatrixF32 transpose() const;
+    int transpose(MatrixF32 & output) const;
 
-private:
+    MatrixF32 inverse() const;
+    int inverse(MatrixF32 & output) const;
 
+    MatrixF32 scale(float32_t value) const;
+    int scale(MatrixF32 & output, float32_t value) const;
 
+    /*! \details Sets the matrix to the identity (must be square). */
+    void set_identity();
 
 };
 
+}
+
 #endif // DSP_MATRIX_HPP
@@ -0,0 +1,116 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_RESAMPLER_HPP
+#define DSP_RESAMPLER_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Vector.hpp"
+#include "SignalData.hpp"
+
+namespace dsp {
+
+/*! \brief Polyphase Resampler
+ * \details The Resampler class changes the sample rate of a stream
+ * by the rational factor up()/down() (interpolation, decimation or both).
+ *
+ * The anti-aliasing filter is designed once when the object is constructed
+ * and stored as up() polyphase branches so only the outputs that are
+ * kept are calculated. The delay line and phase are kept between calls
+ * so a stream can be processed in chunks of any length.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * ResamplerQ15 resampler(16000, 44100); //44.1kHz to 16kHz (reduced to 160/441)
+ * SignalQ15 input(512);
+ * SignalQ15 output;
+ *
+ * while( read_samples(input) ){
+ *   resampler.process(output, input); //output count varies from call to call
+ *   write_samples(output);
+ * }
+ * \endcode
+ *
+ * Fixed point types use a 64-bit accumulator and saturate the output.
+ * Use one resampler per channel.
+ *
+ */
+template<typename T> class Resampler : public api::DspWorkObject {
+public:
+
+    /*! \details Constructs a new resampler and designs a windowed sinc filter.
+     *
+     * @param up The interpolation factor (or the output rate)
+     * @param down The decimation factor (or the input rate)
+     * @param zero_crossings Zero crossings of the sinc on each side (filter quality)
+     *
+     * The ratio is reduced so rates can be passed directly. The filter has
+     * 2 * \a zero_crossings * max(up, down) taps rounded up to a multiple of up().
+     *
+     */
+    Resampler(u32 up, u32 down, u32 zero_crossings = 16);
+
+    /*! \details Constructs a new resampler with a prototype filter.
+     *
+     * @param up The interpolation factor
+     * @param down The decimation factor
+     * @param coefficients Low pass filter designed at \a up times the input rate (with a gain of \a up)
+     *
+     */
+    Resampler(u32 up, u32 down, const var::Vector<T> & coefficients);
+
+    /*! \details Returns the interpolation factor (after reduction). */
+    u32 up() const { return m_up; }
+
+    /*! \details Returns the decimation factor (after reduction). */
+    u32 down() const { return m_down; }
+
+    /*! \details Returns the number of taps in each polyphase branch. */
+    u32 taps() const { return m_taps; }
+
+    /*! \details Returns the number of samples the next call to process()
+     * will produce for \a input_count samples.
+     */
+    u32 calculate_output_count(u32 input_count) const;
+
+    /*! \details Resamples \a count samples.
+     *
+     * @param output Destination with room for calculate_output_count(\a count) samples
+     * @param input Source samples
+     * @param count The number of samples in \a input
+     * @return The number of samples written to \a output
+     *
+     */
+    u32 process(T * output, const T * input, u32 count);
+
+    /*! \details Resamples \a input and sets the count of \a output to the
+     * number of samples produced.
+     *
+     * @return The number of output samples or -1 if \a output could not be resized
+     *
+     */
+    int process(var::Vector<T> & output, const var::Vector<T> & input);
+
+    /*! \details Clears the delay line and phase (the filter is kept). */
+    void reset();
+
+private:
+    void set_ratio(u32 up, u32 down);
+    int set_coefficients(const T * coefficients, u32 count);
+
+    u32 m_up;
+    u32 m_down;
+    u32 m_taps;
+    u32 m_phase; //position of the next output (in units of the interpolated rate) ahead of the newest input
+    u32 m_position; //newest sample in m_delay
+    var::Vector<T> m_coefficients; //up() branches of taps() coefficients
+    var::Vector<T> m_delay; //taps() samples stored twice so each window is contiguous
+};
+
+typedef Resampler<q15_t> ResamplerQ15;
+typedef Resampler<q31_t> ResamplerQ31;
+typedef Resampler<float32_t> ResamplerF32;
+
+}
+
+#endif // DSP_RESAMPLER_HPP
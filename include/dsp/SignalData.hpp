@@ -1,8 +1,11 @@
 #ifndef DSP_SIGNAL_DATA_HPP
 #define DSP_SIGNAL_DATA_HPP
 
+#include <cerrno>
+#include <cstring>
 #include "../api/DspObject.hpp"
 #include "../var/Vector.hpp"
+#include "SignalExpression.hpp"
 
 namespace dsp {
 
@@ -144,98 +147,67 @@ public:
  * class.
  *
  */
-template<typename T, typename BigType> class SignalData : public var::Vector<T>, public api::DspWorkObject {
+template<typename T, typename BigType> class SignalData : public var::Vector<T>, public api::DspWorkObject, public SignalExpression<T, SignalData<T, BigType> > {
 public:
     SignalData(){}
     SignalData(int count) : var::Vector<T>(count){}
 
-    /*! \details Performs element-wise addition.
+    /*! \details Constructs a signal by evaluating \a expression.
      *
-     * Operators are not implemented on complex signals.
-     *
-     * \note This operator uses dynamic memory allocation
+     * The expression is evaluated in a single pass. The only memory
+     * allocated is for this signal.
      *
      */
-    SignalData operator + (const SignalData & a ) const { return add(a); }
-
-    /*! \details Performs element-wise addition.
-     *
-     * Operators are not implemented on complex signals.
-     */
-    SignalData & operator += (const SignalData & a ){ return add_assign(a); }
+    template<typename E> SignalData(const SignalExpression<T, E> & expression){
+        assign(expression);
+    }
 
-    /*! \details Adds a constant value to all elements.
-     *
-     * Operators are not implemented on complex signals.
+    /*! \details Assigns the result of \a expression to this signal.
      *
-     * \note This operator uses dynamic memory allocation
-     */
-    SignalData operator + (const T & a ) const { return add(a); }
-
-    /*! \details Adds a constant value to all elements in this signal. */
-    SignalData & operator += (const T & a ){ return add_assign(a); }
-
-    /*! \details Performs element-wise subtraction.
+     * \code
+     * SignalQ15 a(256), b(256), c(256), d(256);
+     * ...
+     * d = a + b * c - 100; //evaluated in one pass with no temporary signals
+     * \endcode
      *
      * Operators are not implemented on complex signals.
      *
-     * \note This operator uses dynamic memory allocation
      */
-    SignalData operator - (const SignalData & a) const { return subtract(a); }
+    template<typename E> SignalData & operator = (const SignalExpression<T, E> & expression){
+        return assign(expression);
+    }
 
-    /*! \details Performs element-wise subtraction and saves the result in this signal.
+    /*! \details Performs element-wise addition and saves the result in this signal.
      *
+     * \a a may be a signal or an expression of signals.
      *
      * Operators are not implemented on complex signals.
-     *
-     *
      */
-    SignalData & operator -= (const SignalData & a){ return subtract_assign(a); }
+    template<typename E> SignalData & operator += (const SignalExpression<T, E> & a ){ return assign(*this + a); }
 
-    /*! \details Subtracts a scalar value from each element.
-     *
+    /*! \details Adds a constant value to all elements in this signal. */
+    SignalData & operator += (const T & a ){ return assign(*this + a); }
+
+    /*! \details Performs element-wise subtraction and saves the result in this signal.
      *
      * Operators are not implemented on complex signals.
      *
-     *
-     * \note This operator uses dynamic memory allocation
      */
-    SignalData operator - (const T & a) const { return add(-a); }
+    template<typename E> SignalData & operator -= (const SignalExpression<T, E> & a){ return assign(*this - a); }
 
     /*! \details Subtracts a scalar value from each element in this signal.
      *
      * Operators are not implemented on complex signals.
      *
      */
-    SignalData & operator -= (const T & a){ return add_assign(-a); }
-
-    /*!
-     * \details Calculates element-by-element multiplication.
-     *
-     * \param a The second operand of the multiply operation
-     * \return A new signal containing the product of \a a and this signal.
-     *
-     * This operator requires the use of dynamic memory allocation. operator *=() does not.
-     *
-     */
-    SignalData operator * (const SignalData & a ) const { return multiply(a); }
+    SignalData & operator -= (const T & a){ return assign(*this - a); }
 
     /*! \details Multiples this with \a and stores the result in this signal.
      *
-     * @param a The signal to multiply with.
-     *
-     * This is faster than operator *() because no dynamic memory allocation is used.
+     * @param a The signal (or expression) to multiply with.
      *
      */
-    SignalData & operator *= (const SignalData & a ){ return multiply_assign(a); }
-
-    /*! \details Multiplies each element by a scaling value.
-     *
-     *
-     * Operators are not implemented on complex signals.
-     *
-     */
-    SignalData operator * (const T & value) const { return multiply(value); }
+    template<typename E> SignalData & operator *= (const SignalExpression<T, E> & a ){ return assign(*this * a); }
 
     /*! \details Multiplies each element of this signal by a scalar value.
      *
@@ -243,46 +215,21 @@ public:
      * Operators are not implemented on complex signals.
      *
      */
-    SignalData & operator *= (const T & value){ return multiply_assign(value); }
-
-    /*! \details Shifts this signal.
-     *
-     * @param value Number of bits to left shift
-     * @return A new signal with each element equal to this << value
-     *
-     * \note This operator uses dynamic memory allocation.
-     *
-     * Operators are not implemented on complex signals. Shift is not available for any floating-point types.
-     *
-     */
-    SignalData operator << (s8 value) const { return shift(value); }
-
-    /*! \details Shifts this signal.
-     *
-     * @param value Number of bits to left shift
-     * @return A new signal with each element equal to this >> value
-     *
-     * Operators are not implemented on complex signals. Shift is not available for any floating-point types.
-     *
-     * \note This operator uses dynamic memory allocation.
-     *
-     *
-     */
-    SignalData operator >> (s8 value) const { return shift(-1*value); }
+    SignalData & operator *= (const T & value){ return assign(*this * value); }
 
     /*! \details Shifts this signal \a value bits to the left.
      *
      * Operators are not implemented on complex signals. Shift is not available for any floating-point types.
      *
      */
-    SignalData & operator <<= (s8 value){ return shift_assign(value); }
+    SignalData & operator <<= (s8 value){ return assign(*this << value); }
 
     /*! \details Shifts this signal \a value bits to the right.
      *
      * Operators are not implemented on complex signals. Shift is not available for any floating-point types.
      *
      */
-    SignalData & operator >>= (s8 value){ return shift_assign(-1*value); }
+    SignalData & operator >>= (s8 value){ return assign(*this >> value); }
 
     /*! \details Returns true if this signal is equivalent as \a a. */
     bool operator == (const SignalData & a) const {
@@ -456,6 +403,51 @@ public:
 
 protected:
 
+    template<typename E> SignalData & assign(const SignalExpression<T, E> & expression){
+        const E & e = expression.expression();
+        const u32 n = e.count();
+        T * dest;
+
+        if( n*sizeof(T) > this->capacity() ){
+            //growing reallocates and this signal may be an operand of the expression so it is evaluated into new memory first
+            var::Vector<T> result;
+            if( result.resize(n) < 0 ){
+                this->set_error_number(ENOMEM);
+                return *this;
+            }
+            dest = result.vector_data();
+            for(u32 i=0; i < n; i++){
+                dest[i] = e.at(i);
+            }
+            if( this->resize(n) < 0 ){
+                set_resize_error();
+                return *this;
+            }
+            memcpy(this->vector_data(), dest, n*sizeof(T));
+            return *this;
+        }
+
+        //Vector::resize() doesn't reallocate to shrink so operands stay valid
+        if( (this->count() != n) && (this->resize(n) < 0) ){
+            set_resize_error();
+            return *this;
+        }
+        dest = this->vector_data();
+        for(u32 i=0; i < n; i++){
+            dest[i] = e.at(i);
+        }
+        return *this;
+    }
+
+    //memory that wasn't allocated by this object (see Data::set()) can't be resized
+    void set_resize_error(){
+        if( (this->is_internally_managed() == false) && this->capacity() ){
+            this->set_error_number(EINVAL);
+        } else {
+            this->set_error_number(ENOMEM);
+        }
+    }
+
 private:
 
 };
@@ -492,6 +484,13 @@ public:
         return *this;
     }
 
+    template<typename E> SignalQ15(const SignalExpression<q15_t, E> & expression) : SignalData(expression){}
+
+    template<typename E> SignalQ15 & operator = (const SignalExpression<q15_t, E> & expression){
+        assign(expression);
+        return *this;
+    }
+
     q15_t mean() const;
     q63_t power() const;
     q15_t variance() const;
@@ -611,6 +610,13 @@ public:
         return *this;
     }
 
+    template<typename E> SignalQ31(const SignalExpression<q31_t, E> & expression) : SignalData(expression){}
+
+    template<typename E> SignalQ31 & operator = (const SignalExpression<q31_t, E> & expression){
+        assign(expression);
+        return *this;
+    }
+
     q31_t mean() const;
     q63_t power() const;
     q31_t variance() const;
@@ -733,6 +739,13 @@ public:
         return *this;
     }
 
+    template<typename E> SignalF32(const SignalExpression<float32_t, E> & expression) : SignalData(expression){}
+
+    template<typename E> SignalF32 & operator = (const SignalExpression<float32_t, E> & expression){
+        assign(expression);
+        return *this;
+    }
+
     float32_t mean() const;
     float32_t power() const;
     float32_t variance() const;
@@ -0,0 +1,278 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_SIGNAL_EXPRESSION_HPP
+#define DSP_SIGNAL_EXPRESSION_HPP
+
+#include "../api/DspObject.hpp"
+
+namespace dsp {
+
+template<typename T, typename BigType> class SignalData;
+
+/*! \brief Signal Operation Template
+ * \details The SignalOperation class defines the element-wise
+ * arithmetic used by signal expressions. The fixed-point
+ * specializations saturate the same way as the CMSIS
+ * vector functions (arm_add_q15(), arm_mult_q31(), arm_scale_q15(), etc).
+ *
+ * Operators are not implemented on complex signals so only q15_t, q31_t
+ * and float32_t are specialized.
+ *
+ */
+template<typename T> class SignalOperation {};
+
+template<> class SignalOperation<q15_t> {
+public:
+    static q15_t saturate(s32 value){
+        if( value > 32767 ){ return 32767; }
+        if( value < -32768 ){ return -32768; }
+        return value;
+    }
+    static q15_t add(q15_t a, q15_t b){ return saturate((s32)a + b); }
+    static q15_t subtract(q15_t a, q15_t b){ return saturate((s32)a - b); }
+    static q15_t multiply(q15_t a, q15_t b){ return saturate(((s32)a * b) >> 15); }
+    static q15_t scale(q15_t a, q15_t scale_fraction){ return saturate(((s32)a * scale_fraction) >> 15); }
+    static q15_t shift(q15_t a, s8 value){
+        if( value >= 0 ){ return saturate((s32)a * (1<<value)); }
+        return a >> -value;
+    }
+};
+
+template<> class SignalOperation<q31_t> {
+public:
+    static q31_t saturate(s64 value){
+        if( value > 2147483647LL ){ return 2147483647; }
+        if( value < -2147483648LL ){ return -2147483647 - 1; }
+        return value;
+    }
+    static q31_t add(q31_t a, q31_t b){ return saturate((s64)a + b); }
+    static q31_t subtract(q31_t a, q31_t b){ return saturate((s64)a - b); }
+    static q31_t multiply(q31_t a, q31_t b){
+        q31_t value = ((q63_t)a * b) >> 32;
+        if( value > 0x3fffffff ){ value = 0x3fffffff; }
+        return value * 2;
+    }
+    static q31_t scale(q31_t a, q31_t scale_fraction){ return saturate((((q63_t)a * scale_fraction) >> 32) * 2); }
+    static q31_t shift(q31_t a, s8 value){
+        if( value >= 0 ){ return saturate((s64)a * ((s64)1<<value)); }
+        return a >> -value;
+    }
+};
+
+template<> class SignalOperation<float32_t> {
+public:
+    static float32_t add(float32_t a, float32_t b){ return a + b; }
+    static float32_t subtract(float32_t a, float32_t b){ return a - b; }
+    static float32_t multiply(float32_t a, float32_t b){ return a * b; }
+    static float32_t scale(float32_t a, float32_t scale_fraction){ return a * scale_fraction; }
+};
+
+/*! \brief Signal Expression Template
+ * \details The SignalExpression class is the base of
+ * lazily evaluated element-wise signal operations.
+ *
+ * Operators on signals return expression objects rather than
+ * new signals. The expression is evaluated in a single pass when it is assigned
+ * to a signal so no intermediate signals are allocated.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * SignalF32 a(4096);
+ * SignalF32 b(4096);
+ * SignalF32 c(4096);
+ * ...
+ * SignalF32 d = a + b * 0.5f - c; //one loop, one allocation (for d)
+ * c += a * b; //one loop, no allocation
+ * \endcode
+ *
+ * Operands are only referenced by the expression so the signals used must
+ * be valid until the expression is assigned.
+ *
+ */
+template<typename T, typename E> class SignalExpression {
+public:
+    typedef T value_type;
+
+    /*! \details Returns a reference to the derived expression. */
+    const E & expression() const { return static_cast<const E &>(*this); }
+
+};
+
+/*! \brief Signal Term
+ * \details The SignalTerm class references the data of a signal
+ * within an expression.
+ */
+template<typename T> class SignalTerm : public SignalExpression<T, SignalTerm<T> > {
+public:
+    SignalTerm(const T * data, u32 count){ m_data = data; m_count = count; }
+
+    template<typename BigType> SignalTerm(const SignalData<T, BigType> & signal){
+        m_data = signal.vector_data_const();
+        m_count = signal.count();
+    }
+
+    u32 count() const { return m_count; }
+    T at(u32 i) const { return m_data[i]; }
+
+private:
+    const T * m_data;
+    u32 m_count;
+};
+
+/*! \cond */
+//signals are referenced by expressions using a SignalTerm, everything else is stored by value
+template<typename E> class SignalOperand {
+public:
+    typedef E type;
+};
+
+template<typename T, typename BigType> class SignalOperand< SignalData<T, BigType> > {
+public:
+    typedef SignalTerm<T> type;
+};
+
+template<typename T> class SignalAdd {
+public:
+    static T calculate(T a, T b){ return SignalOperation<T>::add(a, b); }
+};
+
+template<typename T> class SignalSubtract {
+public:
+    static T calculate(T a, T b){ return SignalOperation<T>::subtract(a, b); }
+};
+
+template<typename T> class SignalMultiply {
+public:
+    static T calculate(T a, T b){ return SignalOperation<T>::multiply(a, b); }
+};
+
+template<typename T> class SignalScale {
+public:
+    static T calculate(T a, T b){ return SignalOperation<T>::scale(a, b); }
+};
+/*! \endcond */
+
+/*! \brief Signal Binary Expression
+ * \details The SignalBinaryExpression class applies \a Operation
+ * to each pair of elements of two expressions.
+ */
+template<typename T, typename L, typename R, typename Operation> class SignalBinaryExpression :
+        public SignalExpression<T, SignalBinaryExpression<T, L, R, Operation> > {
+public:
+    SignalBinaryExpression(const L & a, const R & b) : m_a(a), m_b(b){}
+
+    u32 count() const {
+        return m_a.count() < m_b.count() ? m_a.count() : m_b.count();
+    }
+
+    T at(u32 i) const { return Operation::calculate(m_a.at(i), m_b.at(i)); }
+
+private:
+    typename SignalOperand<L>::type m_a;
+    typename SignalOperand<R>::type m_b;
+};
+
+/*! \brief Signal Scalar Expression
+ * \details The SignalScalarExpression class applies \a Operation
+ * to each element of an expression and a constant value.
+ */
+template<typename T, typename L, typename Operation> class SignalScalarExpression :
+        public SignalExpression<T, SignalScalarExpression<T, L, Operation> > {
+public:
+    SignalScalarExpression(const L & a, T value) : m_a(a), m_value(value){}
+
+    u32 count() const { return m_a.count(); }
+    T at(u32 i) const { return Operation::calculate(m_a.at(i), m_value); }
+
+private:
+    typename SignalOperand<L>::type m_a;
+    T m_value;
+};
+
+/*! \brief Signal Shift Expression
+ * \details The SignalShiftExpression class shifts each element
+ * of a fixed-point expression (positive values shift left).
+ */
+template<typename T, typename L> class SignalShiftExpression :
+        public SignalExpression<T, SignalShiftExpression<T, L> > {
+public:
+    SignalShiftExpression(const L & a, s8 value) : m_a(a), m_value(value){}
+
+    u32 count() const { return m_a.count(); }
+    T at(u32 i) const { return SignalOperation<T>::shift(m_a.at(i), m_value); }
+
+private:
+    typename SignalOperand<L>::type m_a;
+    s8 m_value;
+};
+
+/*! \details Performs element-wise (saturating) addition. */
+template<typename T, typename L, typename R> SignalBinaryExpression<T, L, R, SignalAdd<T> >
+operator + (const SignalExpression<T, L> & a, const SignalExpression<T, R> & b){
+    return SignalBinaryExpression<T, L, R, SignalAdd<T> >(a.expression(), b.expression());
+}
+
+/*! \details Adds a constant value to all elements. */
+template<typename T, typename L> SignalScalarExpression<T, L, SignalAdd<T> >
+operator + (const SignalExpression<T, L> & a, typename SignalExpression<T, L>::value_type value){
+    return SignalScalarExpression<T, L, SignalAdd<T> >(a.expression(), value);
+}
+
+/*! \details Adds a constant value to all elements. */
+template<typename T, typename L> SignalScalarExpression<T, L, SignalAdd<T> >
+operator + (typename SignalExpression<T, L>::value_type value, const SignalExpression<T, L> & a){
+    return SignalScalarExpression<T, L, SignalAdd<T> >(a.expression(), value);
+}
+
+/*! \details Performs element-wise (saturating) subtraction. */
+template<typename T, typename L, typename R> SignalBinaryExpression<T, L, R, SignalSubtract<T> >
+operator - (const SignalExpression<T, L> & a, const SignalExpression<T, R> & b){
+    return SignalBinaryExpression<T, L, R, SignalSubtract<T> >(a.expression(), b.expression());
+}
+
+/*! \details Subtracts a constant value from all elements. */
+template<typename T, typename L> SignalScalarExpression<T, L, SignalSubtract<T> >
+operator - (const SignalExpression<T, L> & a, typename SignalExpression<T, L>::value_type value){
+    return SignalScalarExpression<T, L, SignalSubtract<T> >(a.expression(), value);
+}
+
+/*! \details Performs element-by-element multiplication. */
+template<typename T, typename L, typename R> SignalBinaryExpression<T, L, R, SignalMultiply<T> >
+operator * (const SignalExpression<T, L> & a, const SignalExpression<T, R> & b){
+    return SignalBinaryExpression<T, L, R, SignalMultiply<T> >(a.expression(), b.expression());
+}
+
+/*! \details Multiplies each element by a scaling value. */
+template<typename T, typename L> SignalScalarExpression<T, L, SignalScale<T> >
+operator * (const SignalExpression<T, L> & a, typename SignalExpression<T, L>::value_type value){
+    return SignalScalarExpression<T, L, SignalScale<T> >(a.expression(), value);
+}
+
+/*! \details Multiplies each element by a scaling value. */
+template<typename T, typename L> SignalScalarExpression<T, L, SignalScale<T> >
+operator * (typename SignalExpression<T, L>::value_type value, const SignalExpression<T, L> & a){
+    return SignalScalarExpression<T, L, SignalScale<T> >(a.expression(), value);
+}
+
+/*! \details Shifts each element \a value bits to the left.
+ *
+ * Shift is not available for any floating-point types.
+ */
+template<typename T, typename L> SignalShiftExpression<T, L>
+operator << (const SignalExpression<T, L> & a, s8 value){
+    return SignalShiftExpression<T, L>(a.expression(), value);
+}
+
+/*! \details Shifts each element \a value bits to the right.
+ *
+ * Shift is not available for any floating-point types.
+ */
+template<typename T, typename L> SignalShiftExpression<T, L>
+operator >> (const SignalExpression<T, L> & a, s8 value){
+    return SignalShiftExpression<T, L>(a.expression(), -1*value);
+}
+
+}
+
+#endif // DSP_SIGNAL_EXPRESSION_HPP
@@ -0,0 +1,121 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_STATISTICS_HPP
+#define DSP_STATISTICS_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Vector.hpp"
+#include "SignalData.hpp"
+
+namespace dsp {
+
+/*! \brief Online Statistics
+ * \details The Statistics class calculates the mean, variance, standard deviation,
+ * RMS, minimum and maximum of a stream in a single pass.
+ *
+ * Unlike SignalQ15::mean(), SignalQ15::variance() and so on (which each
+ * read the whole signal), update() reads each sample once and can be called
+ * block by block. Each block is summarized then combined with the running
+ * values using the parallel form of Welford's algorithm, so the variance
+ * stays accurate over long streams.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * StatisticsQ15 statistics;
+ * SignalQ15 input(256);
+ *
+ * while( read_samples(input) ){
+ *   statistics.update(input);
+ * }
+ *
+ * printf("mean %d std %d peak to peak %d\n", statistics.mean(), statistics.std(), statistics.peak_to_peak());
+ * \endcode
+ *
+ * Results from parallel workers can be combined with merge().
+ *
+ * \code
+ * StatisticsF32 first;
+ * StatisticsF32 second;
+ * first.update(samples, half); //thread 1
+ * second.update(samples + half, count - half); //thread 2
+ * first.merge(second); //same as processing all the samples with first
+ * \endcode
+ *
+ * Values are returned in the same format as the SignalData methods
+ * (variance() is the sample variance in q1.15 for StatisticsQ15). Fixed point
+ * results are saturated.
+ *
+ */
+template<typename T> class Statistics {
+public:
+
+    /*! \details Constructs an empty accumulator. */
+    Statistics(){ reset(); }
+
+    /*! \details Clears all values. */
+    void reset();
+
+    /*! \details Adds \a count samples to the statistics. */
+    void update(const T * input, u32 count);
+
+    /*! \details Adds the samples in \a input to the statistics. */
+    void update(const var::Vector<T> & input){ update(input.vector_data_const(), input.count()); }
+
+    /*! \details Combines the statistics of \a a with this object.
+     *
+     * The samples in \a a are treated as if they followed the
+     * samples in this object (min_index() and max_index() of \a a are offset by count()).
+     *
+     */
+    void merge(const Statistics & a);
+
+    /*! \details Returns the number of samples. */
+    u64 count() const { return m_count; }
+
+    /*! \details Returns the mean value. */
+    T mean() const;
+
+    /*! \details Returns the sample variance (divided by count() - 1). */
+    T variance() const;
+
+    /*! \details Returns the standard deviation. */
+    T std() const;
+
+    /*! \details Returns the root mean square. */
+    T rms() const;
+
+    /*! \details Returns the minimum value (first occurrence). */
+    T min() const { return m_min; }
+
+    /*! \details Returns the minimum value and writes its sample index to \a idx. */
+    T min(u64 & idx) const { idx = m_min_index; return m_min; }
+
+    /*! \details Returns the maximum value (first occurrence). */
+    T max() const { return m_max; }
+
+    /*! \details Returns the maximum value and writes its sample index to \a idx. */
+    T max(u64 & idx) const { idx = m_max_index; return m_max; }
+
+    /*! \details Returns max() - min(). */
+    T peak_to_peak() const;
+
+private:
+    void merge(u64 count, double mean, double m2);
+
+    u64 m_count;
+    double m_mean; //in units of T
+    double m_m2; //sum of squared differences from the mean
+    T m_min;
+    T m_max;
+    u64 m_min_index;
+    u64 m_max_index;
+};
+
+typedef Statistics<q15_t> StatisticsQ15;
+typedef Statistics<q31_t> StatisticsQ31;
+typedef Statistics<float32_t> StatisticsF32;
+
+}
+
+#endif // DSP_STATISTICS_HPP
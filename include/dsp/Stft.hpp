@@ -0,0 +1,117 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef DSP_STFT_HPP
+#define DSP_STFT_HPP
+
+#include "../api/DspObject.hpp"
+#include "../var/Ring.hpp"
+#include "SignalData.hpp"
+#include "Transform.hpp"
+
+namespace dsp {
+
+/*! \brief Short-Time Fourier Transform (Spectrogram)
+ * \details The StftF32 class computes the spectrum of overlapping frames
+ * of a continuous 32-bit floating point signal.
+ *
+ * The window, the FFT instance and all scratch memory are allocated
+ * once when the object is constructed. Input can be passed in chunks of any
+ * length. Each time a frame is complete, a row of bins() values is written
+ * to the output.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * StftF32 stft(1024, 256, StftF32::HANN, StftF32::DECIBEL);
+ * SignalF32 spectrogram(stft.bins() * 64); //64 rows used as a circular buffer
+ * SignalF32 input(480);
+ *
+ * while( read_samples(input) ){
+ *   if( stft.process(spectrogram, input) ){
+ *     //newest row is (stft.row() + 63) % 64
+ *   }
+ * }
+ * \endcode
+ *
+ */
+class StftF32 : public api::DspWorkObject {
+public:
+
+    /*! \details Window types */
+    enum window_type {
+        RECTANGULAR /*! No window */,
+        HANN /*! Hann window */,
+        HAMMING /*! Hamming window */,
+        BLACKMAN /*! Blackman window */
+    };
+
+    /*! \details Output types for each bin */
+    enum output_type {
+        MAGNITUDE /*! |X| */,
+        POWER /*! |X|^2 */,
+        DECIBEL /*! 10*log10(|X|^2) */
+    };
+
+    /*! \details Constructs a new STFT engine.
+     *
+     * @param n_samples The number of samples in each frame (a power of 2 from 32 to 4096)
+     * @param hop The number of samples between the start of consecutive frames
+     * @param window The window applied to each frame
+     * @param output The value written for each bin
+     *
+     */
+    StftF32(u32 n_samples, u32 hop, enum window_type window = HANN, enum output_type output = POWER);
+
+    /*! \details Returns the number of samples in each frame. */
+    u32 samples() const { return m_fft.samples(); }
+
+    /*! \details Returns the number of samples between frames. */
+    u32 hop() const { return m_hop; }
+
+    /*! \details Returns the number of values in each row (samples()/2 + 1). */
+    u32 bins() const { return samples()/2 + 1; }
+
+    /*! \details Returns the row of the spectrogram that will be written next. */
+    u32 row() const { return m_row; }
+
+    /*! \details Returns the window coefficients. */
+    const SignalF32 & window() const { return m_window; }
+
+    /*! \details Processes \a input and writes a row to \a spectrogram for each complete frame.
+     *
+     * @param spectrogram Caller owned rows of bins() values used as a circular buffer
+     * @param input Samples to process (any length)
+     * @return The number of rows written
+     *
+     */
+    u32 process(SignalF32 & spectrogram, const SignalF32 & input);
+
+    /*! \details Processes \a input and writes bins() values to \a output for each complete frame.
+     *
+     * @return The number of rows written
+     */
+    u32 process(var::Ring<float32_t> & output, const SignalF32 & input);
+
+    /*! \details Discards any partial frame and restarts at row zero. */
+    void reset();
+
+private:
+    u32 process(const float32_t * input, u32 count, float32_t * rows, u32 row_count, var::Ring<float32_t> * ring);
+    void calculate_frame(float32_t * row);
+
+    FftRealF32 m_fft;
+    u32 m_hop;
+    enum output_type m_output;
+    u32 m_fill; //samples in m_frame
+    u32 m_skip; //samples to discard when hop is larger than the frame
+    u32 m_row;
+    SignalF32 m_window;
+    SignalF32 m_frame;
+    SignalF32 m_scratch;
+    SignalF32 m_spectrum;
+
+};
+
+}
+
+#endif // DSP_STFT_HPP
@@ -140,7 +140,119 @@ private:
 
 };
 
-//Add DCT classes
+/*! \brief Discrete Cosine Transform for 32-bit Floating Point
+ * \details The DctF32 class computes a DCT-II, DCT-III or DCT-IV
+ * on blocks of samples() values.
+ *
+ * The transforms use orthonormal scaling so DCT_III is the
+ * inverse of DCT_II and DCT_IV is its own inverse.
+ * DCT_II and DCT_III are calculated with an FftRealF32 of samples() points and
+ * DCT_IV with an FftComplexF32 of samples()/2 points. The twiddle factors
+ * and the scratch memory are allocated when the object is constructed
+ * so transform() doesn't allocate memory.
+ *
+ * \code
+ * #include <sapi/dsp.hpp>
+ *
+ * DctF32 dct(32, DctF32::DCT_II);
+ * SignalF32 log_mel(32*100); //100 frames of 32 log mel energies
+ * SignalF32 cepstrum(32*100);
+ *
+ * dct.transform(cepstrum, log_mel); //all 100 blocks in one call
+ * \endcode
+ *
+ */
+class DctF32 : public api::DspWorkObject {
+public:
+
+    /*! \details DCT types */
+    enum dct_type {
+        DCT_II /*! Forward DCT (used by MFCC, JPEG and others) */,
+        DCT_III /*! Inverse of DCT_II */,
+        DCT_IV /*! Used by the MDCT (is its own inverse) */
+    };
+
+    /*! \details Constructs a new object.
+     *
+     * @param n_samples The number of samples in each block (a power of 2 from 32 to 4096)
+     * @param type The type of transform
+     *
+     */
+    DctF32(u32 n_samples, enum dct_type type = DCT_II);
+
+    /*! \details Returns the number of samples in each block. */
+    u32 samples() const { return m_samples; }
+
+    /*! \details Returns the type of transform. */
+    enum dct_type type() const { return m_type; }
+
+    /*! \details Transforms each block of samples() values in \a input.
+     *
+     * @param output Destination (the same size as \a input, can be \a input)
+     * @param input Source with a multiple of samples() values
+     * @return Zero on success or -1 if the sizes aren't valid (error_number() is EINVAL)
+     *
+     */
+    int transform(SignalF32 & output, const SignalF32 & input);
+
+private:
+    void transform_block(float32_t * output, const float32_t * input);
+
+    FftRealF32 m_rfft;
+    FftComplexF32 m_cfft;
+    u32 m_samples;
+    enum dct_type m_type;
+    SignalF32 m_twiddle;
+    SignalF32 m_scratch;
+    SignalF32 m_spectrum;
+};
+
+/*! \brief Discrete Cosine Transform for Fixed Point q1.15
+ * \details The DctQ15 class has the same interface as DctF32. Each block is
+ * calculated using a DctF32 object then converted back to q1.15.
+ *
+ * Like the fixed point FFTs, the DCT_II and DCT_IV outputs are scaled
+ * down by sqrt(samples()) so they can't overflow and the DCT_III output is
+ * scaled up by sqrt(samples()) (with saturation) so it inverts DCT_II.
+ *
+ */
+class DctQ15 : public api::DspWorkObject {
+public:
+    DctQ15(u32 n_samples, enum DctF32::dct_type type = DctF32::DCT_II);
+    u32 samples() const { return m_dct.samples(); }
+    enum DctF32::dct_type type() const { return m_dct.type(); }
+    int transform(SignalQ15 & output, const SignalQ15 & input);
+
+private:
+    DctF32 m_dct;
+    float32_t m_scale;
+    SignalF32 m_input;
+    SignalF32 m_output;
+};
+
+/*! \brief Discrete Cosine Transform for Fixed Point q1.31
+ * \details The DctQ31 class has the same interface and scaling as DctQ15.
+ *
+ * The calculations use 32-bit floating point. Each q1.31 sample is rounded
+ * to the 24-bit mantissa of a float32_t on the way in (and the rounding
+ * error of the transform is added on the way out) so the low 7 or more bits of the
+ * q1.31 result are not significant. Use DctQ31 for its range and interface, not for
+ * precision beyond about 24 bits (DctQ15 loses nothing this way).
+ *
+ */
+class DctQ31 : public api::DspWorkObject {
+public:
+    DctQ31(u32 n_samples, enum DctF32::dct_type type = DctF32::DCT_II);
+    u32 samples() const { return m_dct.samples(); }
+    enum DctF32::dct_type type() const { return m_dct.type(); }
+    int transform(SignalQ31 & output, const SignalQ31 & input);
+
+private:
+    DctF32 m_dct;
+    float32_t m_scale;
+    SignalF32 m_input;
+    SignalF32 m_output;
+};
 
 }
 
@@ -25,9 +25,28 @@ public:
 	 *
 	 * This method will cause the driver to write the
 	 * current video memory to the display.
+	 *
+	 * If partial refresh is enabled (see set_partial_refresh()), nothing
+	 * is written when no region is dirty and otherwise only the dirty
+	 * regions are passed to refresh_regions().
 	 */
 	void refresh() const;
 
+	/*! \details Enables refreshing only the dirty regions of the bitmap.
+	 *
+	 * This should only be enabled if all drawing marks the regions it changes (the
+	 * sgfx drawing methods do). Otherwise, use Bitmap::mark_dirty() after changing the memory directly.
+	 *
+	 * refresh() is skipped when nothing is dirty. Otherwise, the smallest window
+	 * that contains the dirty regions is written (see set_window()). If the
+	 * driver rejects the window, the whole display is refreshed.
+	 *
+	 */
+	void set_partial_refresh(bool value = true){ m_is_partial_refresh = value; }
+
+	/*! \details Returns true if partial refresh is enabled. */
+	bool is_partial_refresh() const { return m_is_partial_refresh; }
+
 	/*! \details Returns true if the display is
 	 * actively copying the video buffer to the display
 	 *
@@ -40,6 +59,27 @@ public:
 
 	int enable() const;
 	int disable() const;
+
+	/*! \details Sets the window that the next refresh writes to the display.
+	 *
+	 * @param region The window in display memory coordinates
+	 * @return Zero on success or -1 if the driver doesn't support windows
+	 *
+	 */
+	int set_window(const sg_region_t & region) const;
+
+protected:
+	/*! \details Writes \a count \a regions of the video memory to the display.
+	 *
+	 * This implementation sets the window to the bounding box of the regions, refreshes,
+	 * then sets the window back to the whole display. It does a full refresh if
+	 * set_window() fails. Classes for specific displays can re-implement this to
+	 * write each region separately.
+	 */
+	virtual void refresh_regions(const sg_region_t * regions, u8 count) const;
+
+private:
+	bool m_is_partial_refresh;
 };
 
 } /* namespace hal */
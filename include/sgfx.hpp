@@ -9,15 +9,21 @@
 namespace sgfx {}
 
 #include "sgfx/Bitmap.hpp"
+#include "sgfx/BitmapConverter.hpp"
 #include "sgfx/Dim.hpp"
 #include "sgfx/Font.hpp"
 #include "sgfx/FileFont.hpp"
 #include "sgfx/MemoryFont.hpp"
 #include "sgfx/SvgFont.hpp"
 #include "sgfx/SvgMemoryFont.hpp"
+#include "sgfx/TextLayout.hpp"
+#include "sgfx/TiledRenderer.hpp"
 #include "sgfx/Vector.hpp"
+#include "sgfx/VectorCache.hpp"
+#include "sgfx/VectorRasterizer.hpp"
 #include "sgfx/Point.hpp"
 #include "sgfx/Region.hpp"
+#include "sgfx/RleBitmap.hpp"
 
 
 using namespace sgfx;
@@ -13,6 +13,8 @@
 
 namespace sgfx {
 
+class RleBitmap;
+
 /*! \brief Bitmap Class
  * \details This class implements a bitmap and is
  * powered by the sgfx library.
@@ -23,7 +25,7 @@ public:
 	Bitmap();
 
 	static u8 bits_per_pixel(){
-		return sg_api()->bits_per_pixel;
+		return sgfx_api()->bits_per_pixel;
 	}
 
 	operator const sg_bmap_t*() const { return &m_bmap; }
@@ -150,7 +152,7 @@ public:
 	 * @param w Width used for calculation
 	 * @param h Height used for calculation
 	 */
-	static u32 calc_size(int w, int h){ return sg_api()->calc_bmap_size(sg_dim(w,h)); }
+	static u32 calc_size(int w, int h){ return sgfx_api()->calc_bmap_size(sg_dim(w,h)); }
 
 	static u16 calc_word_width(sg_size_t w){
 		return sg_calc_word_width(w);
@@ -184,6 +186,39 @@ public:
 	 */
 	int save(const char * path) const;
 
+	/*! \details Loads a bitmap from a run length encoded file.
+	 *
+	 * @param path The path to the bitmap file name
+	 * @return Zero on success
+	 *
+	 * The file is created using save_rle(). The data is decoded directly
+	 * into the bitmap memory without an intermediate buffer.
+	 *
+	 */
+	int load_rle(const char * path);
+
+	/*! \details Saves a bitmap to a run length encoded file.
+	 *
+	 * @param path The path for the new file
+	 * @return Zero on success
+	 *
+	 * The file uses the same header as save() followed by
+	 * the data encoded using calc::RleFile.
+	 *
+	 */
+	int save_rle(const char * path) const;
+
+	/*! \details Decodes run length encoded data directly into the bitmap memory.
+	 *
+	 * @param src A pointer to the encoded data (see calc::Rle::encode())
+	 * @param nbyte The number of encoded bytes
+	 * @return Zero if the bitmap was completely decoded
+	 *
+	 * The bitmap must already have the correct size.
+	 *
+	 */
+	int decode_rle(const void * src, u32 nbyte);
+
 
 	/*! \details Allocates memory for the bitmap data using the specified
 	 * width and height.  If the bitmap already has a memory associated
@@ -194,9 +229,9 @@ public:
 	/*! \details Free memory associated with bitmap (auto freed on ~Bitmap) */
 	void free();
 
-	void transform_flip_x() const { sg_api()->transform_flip_x(bmap_const()); }
-	void transform_flip_y() const { sg_api()->transform_flip_y(bmap_const()); }
-	void transform_flip_xy() const { sg_api()->transform_flip_xy(bmap_const()); }
+	void transform_flip_x() const { sgfx_api()->transform_flip_x(bmap_const()); mark_dirty(); }
+	void transform_flip_y() const { sgfx_api()->transform_flip_y(bmap_const()); mark_dirty(); }
+	void transform_flip_xy() const { sgfx_api()->transform_flip_xy(bmap_const()); mark_dirty(); }
 
 	/*! \details Performs a shift operation on an area of the bitmap.
 	 *
@@ -213,7 +248,11 @@ public:
 	 *
 	 *
 	 */
-	void transform_shift(sg_point_t shift, const sg_region_t & region) const { sg_api()->transform_shift(bmap_const(), shift, &region); }
+	void transform_shift(sg_point_t shift, const sg_region_t & region) const {
+		sgfx_api()->transform_shift(bmap_const(), shift, &region);
+		mark_dirty(region);
+		mark_dirty(sg_region(sg_point(region.point.x + shift.x, region.point.y + shift.y), region.dim));
+	}
 	void transform_shift(sg_point_t shift, sg_point_t p, sg_dim_t d) const { transform_shift(shift, Region(p,d)); }
 
 
@@ -222,7 +261,7 @@ public:
 	 * @param p The point to get the pixel color
 	 * @return The color of the pixel at \a p
 	 */
-	sg_color_t get_pixel(sg_point_t p) const { return sg_api()->get_pixel(bmap_const(), p); }
+	sg_color_t get_pixel(sg_point_t p) const { return sgfx_api()->get_pixel(bmap_const(), p); }
 
 	/*! \details Draws a pixel at the specified point.
 	 *
@@ -232,7 +271,7 @@ public:
 	 *
 	 * \sa set_pen_color()
 	 */
-	void draw_pixel(sg_point_t p) const { sg_api()->draw_pixel(bmap_const(), p); }
+	void draw_pixel(sg_point_t p) const { sgfx_api()->draw_pixel(bmap_const(), p); mark_dirty(sg_region(p, sg_dim(1,1))); }
 
 	/*! \details Draws a line on the bitmap.
 	 *
@@ -242,10 +281,27 @@ public:
 	 * The bitmap's pen will determine the color, thickness, and drawing mode.
 	 *
 	 */
-	void draw_line(sg_point_t p1, sg_point_t p2) const { sg_api()->draw_line(bmap_const(), p1, p2); }
-	void draw_quadtratic_bezier(sg_point_t p1, sg_point_t p2, sg_point_t p3, sg_point_t * corners = 0) const { sg_api()->draw_quadtratic_bezier(bmap_const(), p1, p2, p3, corners); }
-	void draw_cubic_bezier(sg_point_t p1, sg_point_t p2, sg_point_t p3, sg_point_t p4, sg_point_t * corners = 0) const { sg_api()->draw_cubic_bezier(bmap_const(), p1, p2, p3, p4, corners); }
-	void draw_arc(const sg_region_t & region, s16 start, s16 end, s16 rotation = 0, sg_point_t * corners = 0) const { sg_api()->draw_arc(bmap_const(), &region, start, end, rotation, corners); }
+	void draw_line(sg_point_t p1, sg_point_t p2) const {
+		sgfx_api()->draw_line(bmap_const(), p1, p2);
+		mark_dirty_stroke(p1, p2);
+	}
+	void draw_quadtratic_bezier(sg_point_t p1, sg_point_t p2, sg_point_t p3, sg_point_t * corners = 0) const {
+		sgfx_api()->draw_quadtratic_bezier(bmap_const(), p1, p2, p3, corners);
+		//the curve stays inside the control points
+		mark_dirty_stroke(p1, p2);
+		mark_dirty_stroke(p2, p3);
+	}
+	void draw_cubic_bezier(sg_point_t p1, sg_point_t p2, sg_point_t p3, sg_point_t p4, sg_point_t * corners = 0) const {
+		sgfx_api()->draw_cubic_bezier(bmap_const(), p1, p2, p3, p4, corners);
+		mark_dirty_stroke(p1, p4);
+		mark_dirty_stroke(p2, p3);
+	}
+	void draw_arc(const sg_region_t & region, s16 start, s16 end, s16 rotation = 0, sg_point_t * corners = 0) const {
+		sgfx_api()->draw_arc(bmap_const(), &region, start, end, rotation, corners);
+		//covers the region whether it is rotated about its corner or center
+		mark_dirty_stroke(sg_point(region.point.x - region.dim.width, region.point.y - region.dim.height),
+				sg_point(region.point.x + region.dim.width, region.point.y + region.dim.height));
+	}
 	void draw_arc(sg_point_t p, sg_dim_t d, s16 start, s16 end, s16 rotation = 0) const { draw_arc(Region(p,d), start, end, rotation); }
 
 	/*! \details Draws a rectangle on the bitmap.
@@ -255,7 +311,7 @@ public:
 	 * The bitmap's pen color and drawing mode will affect how the rectangle is drawn. This method
 	 * affects every pixel in the rectangle not just the border.
 	 */
-	void draw_rectangle(const sg_region_t & region) const { sg_api()->draw_rectangle(bmap_const(), &region); }
+	void draw_rectangle(const sg_region_t & region) const { sgfx_api()->draw_rectangle(bmap_const(), &region); mark_dirty(region); }
 	void draw_rectangle(sg_point_t p, sg_dim_t d) const { draw_rectangle(Region(p,d)); }
 
 	/*! \details Pours an area on the bitmap.
@@ -266,7 +322,7 @@ public:
 	 * The pour will seek boundaries going outward until it hits
 	 * a non-zero color or hits the bounding box.
 	 */
-	void draw_pour(const sg_point_t & point, const sg_region_t & bounds) const { sg_api()->draw_pour(bmap_const(), point, &bounds); }
+	void draw_pour(const sg_point_t & point, const sg_region_t & bounds) const { sgfx_api()->draw_pour(bmap_const(), point, &bounds); mark_dirty(bounds); }
 
 	/*! \details This function sets the pixels in a bitmap
 	 * based on the pixels of the source bitmap
@@ -276,7 +332,8 @@ public:
 	 * @return Zero on success
 	 */
 	void draw_bitmap(sg_point_t p_dest, const Bitmap & src) const {
-		sg_api()->draw_bitmap(bmap_const(), p_dest, src.bmap_const());
+		sgfx_api()->draw_bitmap(bmap_const(), p_dest, src.bmap_const());
+		mark_dirty(sg_region(p_dest, src.bmap_const()->dim));
 	}
 
 	/*! \details This function draws a pattern on the bitmap.
@@ -287,7 +344,8 @@ public:
 	 * @param pattern_height The pixel height of alternating pixels
 	 */
 	void draw_pattern(const sg_region_t & region, sg_bmap_data_t odd_pattern, sg_bmap_data_t even_pattern, sg_size_t pattern_height) const {
-		sg_api()->draw_pattern(bmap_const(), &region, odd_pattern, even_pattern, pattern_height);
+		sgfx_api()->draw_pattern(bmap_const(), &region, odd_pattern, even_pattern, pattern_height);
+		mark_dirty(region);
 	}
 	void draw_pattern(sg_point_t p, sg_dim_t d, sg_bmap_data_t odd_pattern, sg_bmap_data_t even_pattern, sg_size_t pattern_height) const {
 		draw_pattern(Region(p,d), odd_pattern, even_pattern, pattern_height);
@@ -302,13 +360,20 @@ public:
 	 * @return Zero on success
 	 */
 	void draw_sub_bitmap(sg_point_t p_dest, const Bitmap & src, const sg_region_t & region_src) const {
-		sg_api()->draw_sub_bitmap(bmap_const(), p_dest, src.bmap_const(), &region_src);
+		sgfx_api()->draw_sub_bitmap(bmap_const(), p_dest, src.bmap_const(), &region_src);
+		mark_dirty(sg_region(p_dest, region_src.dim));
 	}
 
 	void draw_sub_bitmap(sg_point_t p_dest, const Bitmap & src, sg_point_t p_src, sg_dim_t d_src) const {
 		draw_sub_bitmap(p_dest, src, Region(p_src, d_src));
 	}
 
+	/*! \details Draws a run length encoded bitmap without decoding all of it (see RleBitmap). */
+	void draw_bitmap(sg_point_t p_dest, const RleBitmap & src) const;
+
+	/*! \details Draws part of a run length encoded bitmap (only the visible rows are decoded). */
+	void draw_sub_bitmap(sg_point_t p_dest, const RleBitmap & src, const sg_region_t & region_src) const;
+
 	//these are deprecated and shouldn't be documented?
 	void invert(){ invert_rectangle(sg_point(0,0), dim()); }
 	void invert_rectangle(sg_point_t p, sg_dim_t d){
@@ -316,8 +381,9 @@ public:
 		sg_region_t region = sg_region(p,d);
 		o_flags = m_bmap.pen.o_flags;
 		m_bmap.pen.o_flags = SG_PEN_FLAG_IS_INVERT;
-		sg_api()->draw_rectangle(bmap_const(), &region);
+		sgfx_api()->draw_rectangle(bmap_const(), &region);
 		m_bmap.pen.o_flags = o_flags;
+		mark_dirty(region);
 	}
 
 	void clear_rectangle(sg_point_t p, sg_dim_t d){
@@ -325,11 +391,48 @@ public:
 		sg_region_t region = sg_region(p,d);
 		o_flags = m_bmap.pen.o_flags;
 		m_bmap.pen.o_flags = SG_PEN_FLAG_IS_ERASE;
-		sg_api()->draw_rectangle(bmap_const(), &region);
+		sgfx_api()->draw_rectangle(bmap_const(), &region);
 		m_bmap.pen.o_flags = o_flags;
+		mark_dirty(region);
 	}
 
 
+	/*! \details Fills the bitmap memory with \a d (clear() fills with zero) and marks the whole bitmap as dirty. */
+	virtual void fill(unsigned char d);
+
+	enum {
+		DIRTY_REGION_MAX = 4 /*! Maximum number of separate dirty regions (additional regions are merged) */
+	};
+
+	/*! \details Marks \a region as modified since the last refresh().
+	 *
+	 * The drawing methods of this class mark the pixels they change so this only needs
+	 * to be called after changing the bitmap memory directly (for example, using bmap() with sgfx_api()).
+	 *
+	 * The region is clipped to the bitmap. Regions that touch or overlap are merged. If more than
+	 * DIRTY_REGION_MAX regions are needed, the region is merged with the one that grows the least.
+	 *
+	 */
+	void mark_dirty(const sg_region_t & region) const;
+
+	/*! \details Marks the entire bitmap as modified. */
+	void mark_dirty() const { mark_dirty(sg_region(sg_point(0,0), m_bmap.dim)); }
+
+	/*! \details Returns true if any region has been marked since clear_dirty() was called. */
+	bool is_dirty() const { return m_dirty_count != 0; }
+
+	/*! \details Returns the number of dirty regions. */
+	u8 dirty_count() const { return m_dirty_count; }
+
+	/*! \details Returns a pointer to the dirty regions (dirty_count() entries). */
+	const sg_region_t * dirty_regions() const { return m_dirty; }
+
+	/*! \details Returns the smallest region that contains all the dirty regions. */
+	Region calc_dirty_bounds() const;
+
+	/*! \details Clears the dirty regions (done by refresh() implementations once the regions are copied). */
+	void clear_dirty() const { m_dirty_count = 0; }
+
 	/*! \details This method is designated as an interface
 	 * for classes that inherit Bitmap to copy the bitmap to a physical
 	 * device (such as hal::DisplayDev).  The implementation in this class is simple
@@ -404,6 +507,9 @@ private:
 
 	sg_pen_t m_saved_pen;
 	sg_bmap_t m_bmap;
+	mutable sg_region_t m_dirty[DIRTY_REGION_MAX];
+	mutable u8 m_dirty_count;
+	void mark_dirty_stroke(sg_point_t p1, sg_point_t p2) const;
 	void init_members();
 	void calc_members(sg_size_t w, sg_size_t h);
 
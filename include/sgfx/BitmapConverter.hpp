@@ -0,0 +1,150 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_BITMAPCONVERTER_HPP_
+#define SGFX_BITMAPCONVERTER_HPP_
+
+#include <sapi/sg_types.h>
+#include <sos/dev/display.h>
+#include "../var/Vector.hpp"
+#include "../api/SgfxObject.hpp"
+#include "Bitmap.hpp"
+
+namespace sgfx {
+
+/*! \brief Bitmap Converter Class
+ * \details The BitmapConverter class converts pixels between bit depths
+ * a region (or a whole bitmap) at a time. The Bitmap class always uses the bit depth
+ * of the graphics library so the source and destination are described
+ * using buffer_t which can have any depth.
+ *
+ * - 1, 2, 4 and 8 bits per pixel are levels (0 is black and the maximum value is white)
+ * - 16 bits per pixel is RGB565
+ * - 24 bits per pixel is RGB888 (3 bytes per pixel, used for palette formats)
+ * - 32 bits per pixel is XRGB8888 (the top byte is zero)
+ *
+ * Levels are expanded by repeating their bits (a 1 in 1bpp becomes 255 in 8bpp) and packed
+ * by keeping the top bits. Colors become levels using their luminance.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * BitmapConverter converter;
+ * u8 gray[BitmapConverter::calc_size(8, 128, 64)];
+ * BitmapConverter::buffer_t gray_buffer = BitmapConverter::buffer(gray, 8, 128, 64);
+ *
+ * converter.convert(gray_buffer, BitmapConverter::buffer(icon)); //icon is a 1bpp Bitmap
+ * converter.dither(BitmapConverter::buffer(display), gray_buffer); //display is a 1bpp Bitmap
+ * \endcode
+ *
+ * Expanding 1, 2 and 4 bits per pixel uses a table with the output for every source byte.
+ * On link builds with SSE2, converting 8 bits per pixel to 1 bit per pixel (pack, dither and threshold)
+ * compares 16 pixels at a time.
+ *
+ */
+class BitmapConverter : public api::SgfxWorkObject {
+public:
+
+	/*! \brief Describes pixel memory with any bit depth */
+	typedef struct {
+		void * data /*! A pointer to the first row */;
+		u32 stride /*! The number of bytes from one row to the next */;
+		sg_size_t width /*! The width in pixels */;
+		sg_size_t height /*! The height in pixels */;
+		u8 bits_per_pixel /*! 1, 2, 4, 8, 16, 24 or 32 */;
+	} buffer_t;
+
+	BitmapConverter();
+
+	/*! \details Returns a buffer that describes \a bitmap (using the depth of the graphics library). */
+	static buffer_t buffer(const Bitmap & bitmap);
+
+	/*! \details Returns a buffer for \a data with rows padded to 32-bit words (the same as Bitmap). */
+	static buffer_t buffer(void * data, u8 bits_per_pixel, sg_size_t width, sg_size_t height);
+
+	/*! \details Returns the number of bytes needed by buffer(). */
+	static u32 calc_size(u8 bits_per_pixel, sg_size_t width, sg_size_t height){
+		return ((width * bits_per_pixel + 31) / 32) * 4 * height;
+	}
+
+	/*! \details Converts (expands or packs) \a region_src of \a src to \a dest at \a p_dest.
+	 *
+	 * @return Zero on success or -1 if a depth isn't supported
+	 */
+	int convert(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src);
+
+	/*! \details Converts all of \a src to \a dest. */
+	int convert(const buffer_t & dest, const buffer_t & src){
+		return convert(dest, sg_point(0,0), src, sg_region(sg_point(0,0), sg_dim(src.width, src.height)));
+	}
+
+	/*! \details Looks up the color of each pixel of \a src (1 to 8 bits per pixel) in \a palette.
+	 *
+	 * @param dest The destination (bits_per_pixel must be 8 times the palette pixel size)
+	 * @param p_dest The location on \a dest for the top left corner of \a region_src
+	 * @param palette The palette (hal::DisplayPalette can be passed directly)
+	 * @param src The source bitmap
+	 * @param region_src The region of \a src to convert
+	 * @return Zero on success or -1 if the depths don't match the palette
+	 *
+	 * Pixels that are outside the palette are set to zero.
+	 */
+	int lookup(const buffer_t & dest, sg_point_t p_dest, const display_palette_t & palette, const buffer_t & src, const sg_region_t & region_src);
+
+	/*! \details Looks up the color of each pixel of \a src in \a palette. */
+	int lookup(const buffer_t & dest, const display_palette_t & palette, const buffer_t & src){
+		return lookup(dest, sg_point(0,0), palette, src, sg_region(sg_point(0,0), sg_dim(src.width, src.height)));
+	}
+
+	/*! \details Reduces \a region_src of \a src to the levels of \a dest (1 to 8 bits per pixel) using a 4x4 ordered dither.
+	 *
+	 * The dither pattern is aligned to the destination so adjacent regions line up.
+	 */
+	int dither(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src);
+
+	/*! \details Dithers all of \a src to \a dest. */
+	int dither(const buffer_t & dest, const buffer_t & src){
+		return dither(dest, sg_point(0,0), src, sg_region(sg_point(0,0), sg_dim(src.width, src.height)));
+	}
+
+	/*! \details Sets pixels of \a dest to white if the level of \a src is at least \a level (0 to 255) and black otherwise. */
+	int threshold(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src, u8 level = 128);
+
+	/*! \details Applies a threshold to all of \a src. */
+	int threshold(const buffer_t & dest, const buffer_t & src, u8 level = 128){
+		return threshold(dest, sg_point(0,0), src, sg_region(sg_point(0,0), sg_dim(src.width, src.height)), level);
+	}
+
+private:
+	enum operation {
+		OPERATION_CONVERT,
+		OPERATION_LOOKUP,
+		OPERATION_DITHER,
+		OPERATION_THRESHOLD
+	};
+
+	typedef struct {
+		const u8 * src;
+		u8 * dest;
+		u32 src_x;
+		u32 dest_x;
+		u32 dest_y;
+		u32 width;
+	} row_t;
+
+	int run(enum operation value, const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src);
+	u32 convert_row_fast(const row_t & row, u8 dest_bpp, u8 src_bpp);
+	void convert_pixels(const row_t & row, u32 start, u8 dest_bpp, u8 src_bpp);
+	int build_table(u8 dest_bpp, u8 src_bpp);
+
+	enum operation m_operation;
+	const display_palette_t * m_palette;
+	u8 m_level;
+	var::Vector<u64> m_table; //output for each source byte (expansion)
+	u8 m_table_src_bpp;
+	u8 m_table_dest_bpp;
+
+};
+
+}
+
+#endif /* SGFX_BITMAPCONVERTER_HPP_ */
@@ -19,17 +19,17 @@ public:
 	Cursor();
 	virtual ~Cursor();
 
-	void set(const Bitmap & bitmap, sg_point_t p){ sg_api()->cursor_set(data(), bitmap.bmap_const(), p); }
-	void inc_x(){ sg_api()->cursor_inc_x(data()); }
-	void dec_x(){ sg_api()->cursor_dec_x(data()); }
-	void inc_y(){ sg_api()->cursor_inc_y(data()); }
-	void dec_y(){ sg_api()->cursor_dec_y(data()); }
-	sg_color_t get_pixel(){ return sg_api()->cursor_get_pixel(data()); }
-	void draw_pixel() { sg_api()->cursor_draw_pixel(data()); }
-	void draw_hline(sg_size_t width){ sg_api()->cursor_draw_hline(data(), width); }
-	void draw_cursor(const Cursor & src, sg_size_t width){ sg_api()->cursor_draw_cursor(data(), src.data_const(), width); }
-	void shift_right(sg_size_t shift_width, sg_size_t shift_distance){ sg_api()->cursor_shift_right(data(), shift_width, shift_distance); }
-	void shift_left(sg_size_t shift_width, sg_size_t shift_distance){ sg_api()->cursor_shift_left(data(), shift_width, shift_distance); }
+	void set(const Bitmap & bitmap, sg_point_t p){ sgfx_api()->cursor_set(data(), bitmap.bmap_const(), p); }
+	void inc_x(){ sgfx_api()->cursor_inc_x(data()); }
+	void dec_x(){ sgfx_api()->cursor_dec_x(data()); }
+	void inc_y(){ sgfx_api()->cursor_inc_y(data()); }
+	void dec_y(){ sgfx_api()->cursor_dec_y(data()); }
+	sg_color_t get_pixel(){ return sgfx_api()->cursor_get_pixel(data()); }
+	void draw_pixel() { sgfx_api()->cursor_draw_pixel(data()); }
+	void draw_hline(sg_size_t width){ sgfx_api()->cursor_draw_hline(data(), width); }
+	void draw_cursor(const Cursor & src, sg_size_t width){ sgfx_api()->cursor_draw_cursor(data(), src.data_const(), width); }
+	void shift_right(sg_size_t shift_width, sg_size_t shift_distance){ sgfx_api()->cursor_shift_right(data(), shift_width, shift_distance); }
+	void shift_left(sg_size_t shift_width, sg_size_t shift_distance){ sgfx_api()->cursor_shift_left(data(), shift_width, shift_distance); }
 
 
 private:
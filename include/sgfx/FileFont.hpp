@@ -12,15 +12,50 @@ namespace sgfx {
  * \details The File Font class is used to access
  * fonts that are stored as files.
  *
+ * When the file is opened, the character descriptors and kerning
+ * pairs are read into memory (the kerning pairs are sorted so they can
+ * be found with a binary search). The canvases that hold the glyphs are
+ * loaded when they are first drawn and kept in a least recently used cache
+ * so text that uses several canvases doesn't re-read them from the file.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * FileFont font("/home/font.sbf");
+ * font.set_canvas_cache_size(2); //at most 2 canvases in memory
+ * font.draw_str("Hello", bitmap, Point(0,0));
+ * \endcode
+ *
  */
 class FileFont : public Font {
 public:
+
+	enum {
+		DEFAULT_CANVAS_CACHE_SIZE = 4 /*! Default number of canvases kept in memory */
+	};
+
     FileFont();
     FileFont(const char * name, int offset = 0);
     ~FileFont();
 
 	int set_file(const char * name, int offset = 0);
 
+	/*! \details Sets the maximum number of canvases to keep in memory.
+	 *
+	 * @param count The number of canvases (at least 1)
+	 *
+	 * The cache is never larger than the number of canvases in the font. Canvases
+	 * already in memory are freed.
+	 *
+	 */
+	void set_canvas_cache_size(u8 count);
+
+	/*! \details Returns the number of canvases that can be kept in memory. */
+	u8 canvas_cache_size() const { return m_canvas_cache_size; }
+
+	/*! \details Returns the number of times a canvas has been read from the file. */
+	u32 canvas_loads() const { return m_canvas_loads; }
+
 	sg_size_t get_height() const;
 	sg_size_t get_width() const;
 
@@ -30,11 +65,30 @@ protected:
 	int load_kerning(u16 first, u16 second) const;
 
 private:
+	typedef struct {
+		Bitmap canvas;
+		u16 canvas_idx; //CANVAS_NONE if the entry is not used
+		u32 last_used;
+	} canvas_cache_t;
+
+	enum {
+		CANVAS_NONE = 0xffff
+	};
+
+	const Bitmap * load_canvas(u8 canvas_idx) const;
+	void free_canvas_cache();
+	void free_tables();
+
 	mutable sys::File m_file;
-	mutable Bitmap m_canvas;
-	mutable u8 m_current_canvas;
+	mutable canvas_cache_t * m_canvas_cache;
+	u8 m_canvas_cache_size;
+	u8 m_canvas_cache_request;
+	u16 m_canvas_count;
+	mutable u32 m_canvas_clock;
+	mutable u32 m_canvas_loads;
 	u32 m_canvas_start;
 	u32 m_canvas_size;
+	sg_font_char_t * m_chars;
 	sg_font_kerning_pair_t * m_kerning_pairs;
 
 };
@@ -46,13 +46,13 @@ public:
 	int size() const { return m_hdr.num_chars; }
 
 	/*! \details Sets the spacing between letters within a word. */
-	void set_letter_spacing(sg_size_t spacing){ m_letter_spacing = spacing; }
+	void set_letter_spacing(sg_size_t spacing){ m_letter_spacing = spacing; update_generation(); }
 
 	/*! \details Returns the spacing of the letters within a word. */
 	sg_size_t letter_spacing() const { return m_letter_spacing; }
 
 	/*! \details Sets the number of pixels in a space between words. */
-	void set_space_size(int s){ m_space_size = s; }
+	void set_space_size(int s){ m_space_size = s; update_generation(); }
 
 	/*! \details Returns the number of pixels between words. */
 	int space_size() const { return m_space_size; }
@@ -84,7 +84,16 @@ public:
 	/*! \details Accesses the number of kerning pairs in the font. */
 	u16 kerning_pairs() const { return m_hdr.kerning_pairs; }
 
+	/*! \details Returns a number that changes whenever the glyphs or metrics of the font change.
+	 *
+	 * No two fonts share a value (even one created at the address of a deleted font)
+	 * so TextLayout can tell if it was created with the font as it is now.
+	 *
+	 */
+	u32 generation() const { return m_generation; }
+
 protected:
+	friend class TextLayout;
 
 	static int to_charset(char ascii);
 
@@ -92,6 +101,9 @@ protected:
 	virtual int load_char(sg_font_char_t & ch, char c, bool ascii) const = 0;
 	virtual int load_kerning(u16 first, u16 second) const { return 0; }
 
+	/*! \details Call when the glyphs or metrics change (layouts made before the change are not reused). */
+	void update_generation();
+
 	mutable int m_offset;
 	mutable sg_font_char_t m_char;
 
@@ -100,6 +112,8 @@ protected:
 	sg_font_header_t m_hdr;
 
 private:
+	u32 m_generation;
+	static u32 m_generation_count;
 
 };
 
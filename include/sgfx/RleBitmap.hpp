@@ -0,0 +1,161 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_RLEBITMAP_HPP_
+#define SGFX_RLEBITMAP_HPP_
+
+#include <sapi/sg.h>
+#include "../api/SgfxObject.hpp"
+#include "Bitmap.hpp"
+
+namespace sgfx {
+
+/*! \brief Run Length Encoded Bitmap Class
+ * \details The RleBitmap class holds a bitmap where each row is run length
+ * encoded on its own. A table of row offsets follows the header, so any row can be
+ * decoded without decoding the rows before it.
+ *
+ * Rows are encoded with PackBits: a control byte is followed by either up to 128 literal
+ * units or one unit that repeats 2 to 129 times. A unit is one pixel for 16 and 32 bits per pixel
+ * and one byte otherwise, so solid colors compress at any depth and noisy data grows by less than 1%.
+ *
+ * An RleBitmap can be drawn on a Bitmap directly. The rows that aren't clipped
+ * are decoded one at a time into a buffer that holds a single row, so the whole
+ * bitmap is never decoded.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * //create the compressed file from a bitmap (for example, on the host)
+ * RleBitmap rle;
+ * rle.encode(splash_bitmap);
+ * rle.save("/home/splash.rbmp");
+ *
+ * //on the device, the data can be loaded from a file or used directly from flash
+ * RleBitmap splash;
+ * splash.load("/home/splash.rbmp");
+ * display.draw_bitmap(sg_point(0,0), splash);
+ *
+ * RleBitmap icon(icon_rle_data, sizeof(icon_rle_data));
+ * display.draw_bitmap(sg_point(10,10), icon);
+ * \endcode
+ *
+ * The format is the header (header_t), then (height + 1) 32-bit offsets
+ * from the start of the first row, then the encoded rows.
+ *
+ */
+class RleBitmap : public api::SgfxDataObject {
+public:
+
+	/*! \cond */
+	typedef struct MCU_PACK {
+		sg_bmap_header_t bmap /*! The bitmap header (size is the number of decoded bytes) */;
+		u32 signature /*! Always SIGNATURE */;
+		u32 size /*! Total number of bytes including this header */;
+	} header_t;
+	/*! \endcond */
+
+	enum {
+		SIGNATURE /*! Identifies run length encoded bitmaps ("RLEB") */ = 0x424C4552
+	};
+
+	/*! \details Constructs an empty bitmap. */
+	RleBitmap();
+
+	/*! \details Constructs a bitmap using existing (for example, in flash) encoded data.
+	 *
+	 * See set_data() for details.
+	 */
+	RleBitmap(const void * data, u32 nbyte);
+
+	/*! \details Uses existing encoded data (the data is not copied).
+	 *
+	 * @param data A pointer to the header followed by the offsets and rows
+	 * @param nbyte The number of bytes available at \a data
+	 * @return Zero on success or -1 if the data isn't valid for this graphics library
+	 *
+	 */
+	int set_data(const void * data, u32 nbyte);
+
+	/*! \details Encodes \a bitmap (replacing any previous data).
+	 *
+	 * @param bitmap The bitmap to encode
+	 * @return Zero on success or -1 if memory could not be allocated
+	 */
+	int encode(const Bitmap & bitmap);
+
+	/*! \details Loads an encoded bitmap from a file created with save().
+	 *
+	 * @param path The path to the file
+	 * @return Zero on success
+	 */
+	int load(const char * path);
+
+	/*! \details Saves the encoded bitmap to a file.
+	 *
+	 * @param path The path for the new file
+	 * @return Zero on success
+	 *
+	 * If the file already exists, it will be overwritten.
+	 *
+	 */
+	int save(const char * path) const;
+
+	/*! \details Returns true if the object holds a valid encoded bitmap. */
+	bool is_valid() const { return m_is_valid; }
+
+	/*! \details Returns the width of the bitmap. */
+	sg_size_t width() const { return m_is_valid ? header()->bmap.width : 0; }
+
+	/*! \details Returns the height of the bitmap. */
+	sg_size_t height() const { return m_is_valid ? header()->bmap.height : 0; }
+
+	/*! \details Returns the dimensions of the bitmap. */
+	Dim dim() const { return Dim(width(), height()); }
+
+	/*! \details Returns the number of bytes used by the header, offsets and rows. */
+	u32 encoded_size() const { return m_is_valid ? header()->size : 0; }
+
+	/*! \details Decodes a single row.
+	 *
+	 * @param y The row to decode
+	 * @param dest Where to write the row (must hold Bitmap::calc_size(width(), 1) bytes)
+	 * @return Zero on success or -1 if \a y is out of range or the row is corrupt
+	 */
+	int decode_row(sg_int_t y, sg_bmap_data_t * dest) const;
+
+	/*! \details Decodes the whole bitmap into \a bitmap.
+	 *
+	 * @param bitmap The destination (it is resized or allocated if needed)
+	 * @return Zero on success
+	 */
+	int decode(Bitmap & bitmap) const;
+
+	/*! \details Draws the bitmap on \a dest (see Bitmap::draw_bitmap()). */
+	void draw(const Bitmap & dest, sg_point_t p_dest) const {
+		draw(dest, p_dest, sg_region(sg_point(0,0), sg_dim(width(), height())));
+	}
+
+	/*! \details Draws part of the bitmap on \a dest (see Bitmap::draw_sub_bitmap()).
+	 *
+	 * @param dest The destination bitmap (its pen determines the drawing mode)
+	 * @param p_dest The point on \a dest for the top left corner of \a region_src
+	 * @param region_src The region of this bitmap to draw
+	 *
+	 * Only the rows that land on \a dest are decoded.
+	 */
+	void draw(const Bitmap & dest, sg_point_t p_dest, const sg_region_t & region_src) const;
+
+private:
+	const header_t * header() const { return (const header_t*)data_const(); }
+	bool validate(u32 nbyte);
+	const u32 * offsets() const { return (const u32*)((const u8*)data_const() + sizeof(header_t)); }
+	const u8 * rows() const { return (const u8*)(offsets() + height() + 1); }
+
+	bool m_is_valid;
+	mutable Bitmap m_row; //holds one decoded row while drawing
+
+};
+
+}
+
+#endif /* SGFX_RLEBITMAP_HPP_ */
@@ -4,6 +4,7 @@
 #ifndef SGFX_SVGFONT_HPP_
 #define SGFX_SVGFONT_HPP_
 
+#include "../var/Vector.hpp"
 #include "Font.hpp"
 
 namespace sgfx {
@@ -13,20 +14,83 @@ namespace sgfx {
  * fonts using vector graphic data rather then
  * bitmap data.
  *
+ * Rasterizing a glyph from its paths is much slower than copying
+ * a bitmap so each glyph is rasterized the first time it is drawn
+ * at a given height and kept in a cache. The cache is limited to
+ * cache_budget() bytes of bitmap memory. When it is full, the least
+ * recently used glyphs are freed.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * font.set_cache_budget(8192);
+ * //... draw text
+ * printf("glyph cache %ld hits %ld misses (%ld bytes)\n", font.cache_hits(), font.cache_misses(), font.cache_usage());
+ * \endcode
+ *
  */
 class SvgFont : public Font {
 public:
+
+	enum {
+		DEFAULT_CACHE_BUDGET = 4096 /*! Default number of bytes used to cache glyphs */
+	};
+
     SvgFont();
     virtual ~SvgFont();
 
 	virtual sg_size_t get_height() const { return m_height; }
 	virtual sg_size_t get_width() const { return m_width; }
 
+	/*! \details Sets the height of the font (glyphs cached at other heights are kept). */
 	void set_height(sg_size_t height);
 
+	/*! \details Sets the number of bytes that can be used to cache glyphs (zero disables the cache).
+	 *
+	 * Glyphs are freed (least recently used first) until the cache fits.
+	 */
+	void set_cache_budget(u32 bytes);
+
+	/*! \details Returns the number of bytes that can be used to cache glyphs. */
+	u32 cache_budget() const { return m_cache_budget; }
+
+	/*! \details Returns the number of bytes used by cached glyphs. */
+	u32 cache_usage() const { return m_cache_usage; }
+
+	/*! \details Returns the number of glyphs drawn from the cache. */
+	u32 cache_hits() const { return m_cache_hits; }
+
+	/*! \details Returns the number of glyphs that had to be rasterized. */
+	u32 cache_misses() const { return m_cache_misses; }
+
+	/*! \details Frees all the cached glyphs (the counters are not changed). */
+	void clear_cache();
+
+protected:
+	/*! \details Draws a glyph from the cache (or rasterizes it with draw_char_path()). */
+	void draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const;
+
+	/*! \details Rasterizes the paths of \a ch at get_height() with the top left corner at \a point. */
+	virtual void draw_char_path(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const = 0;
+
 private:
+	typedef struct {
+		Bitmap * bitmap;
+		u32 last_used;
+		u16 id;
+		sg_size_t height;
+	} glyph_t;
+
+	void free_glyphs(u32 budget) const;
+
 	sg_size_t m_height;
 	sg_size_t m_width;
+	u32 m_cache_budget;
+	mutable u32 m_cache_usage;
+	mutable u32 m_cache_hits;
+	mutable u32 m_cache_misses;
+	mutable u32 m_cache_clock;
+	mutable var::Vector<glyph_t> m_glyphs;
 };
 
 }
@@ -5,6 +5,7 @@
 #define SGFX_SVGMEMORYFONT_HPP_
 
 #include "SvgFont.hpp"
+#include "VectorRasterizer.hpp"
 
 namespace sgfx {
 
@@ -12,17 +13,46 @@ namespace sgfx {
  * \details SvgMemoryFont is an implementation of SvgFont
  * where the SVG data is stored in memory (flash or RAM).
  *
+ * The font is a table of glyph outlines indexed the same way as the
+ * characters of a bitmap font (see Font::to_charset()). Each outline is
+ * filled with a VectorRasterizer in a box that is get_height() pixels
+ * high and advance * get_height() / SG_MAX pixels wide. The path coordinates
+ * from SG_MIN to SG_MAX span the box.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * SvgMemoryFont font(glyphs, sizeof(glyphs)/sizeof(glyphs[0]));
+ * font.set_height(24);
+ * font.draw_str("Hello", bitmap, sg_point(0,0));
+ * \endcode
  *
  */
 class SvgMemoryFont : public SvgFont {
 public:
-    SvgMemoryFont();
-    virtual ~SvgMemoryFont();
+
+	/*! \details Outline of one character. */
+	typedef struct {
+		u16 advance /*! Width of the glyph box (SG_MAX is the font height) */;
+		sg_vector_path_t path /*! Outline of the glyph */;
+	} glyph_path_t;
+
+	/*! \details Constructs a font with no glyphs (nothing is drawn). */
+	SvgMemoryFont();
+
+	/*! \details Constructs a font using \a count glyphs (the table is not copied). */
+	SvgMemoryFont(const glyph_path_t * glyphs, u16 count);
+	virtual ~SvgMemoryFont();
 
 protected:
-	void draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const;
+	void draw_char_path(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const;
 	int load_char(sg_font_char_t & ch, char c, bool ascii) const;
 	int load_kerning(u16 first, u16 second) const;
+
+private:
+	const glyph_path_t * m_glyphs;
+	u16 m_count;
+	mutable VectorRasterizer m_rasterizer;
 };
 
 }
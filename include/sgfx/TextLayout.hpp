@@ -0,0 +1,156 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_TEXTLAYOUT_HPP_
+#define SGFX_TEXTLAYOUT_HPP_
+
+#include "../var/String.hpp"
+#include "../var/Vector.hpp"
+#include "Font.hpp"
+
+namespace sgfx {
+
+/*! \brief Text Layout Class
+ * \details A TextLayout holds the position of each glyph of a string
+ * drawn with a font. The characters, kerning and offsets are resolved once
+ * by set() then draw() blits each glyph without looking anything up.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * TextLayout layout;
+ * layout.set(font, "Settings");
+ * layout.draw(bitmap, Point(10 + (100 - layout.width())/2, 0)); //centered
+ * \endcode
+ *
+ * The width() includes kerning so it is the exact distance
+ * Font::draw_str() advances.
+ *
+ */
+class TextLayout {
+public:
+	TextLayout();
+
+	/*! \details Lays out \a str using \a font.
+	 *
+	 * @return Zero on success or -1 if memory could not be allocated
+	 *
+	 * The font must remain valid while the layout is used. If the font
+	 * changes (see Font::generation()), is_match() returns false.
+	 *
+	 */
+	int set(const Font & font, const char * str);
+
+	/*! \details Draws the text with the top left corner at \a point. */
+	void draw(Bitmap & dest, sg_point_t point) const;
+
+	/*! \details Returns the width of the text in pixels. */
+	sg_size_t width() const { return m_width; }
+
+	/*! \details Returns the height of the text in pixels (the font height). */
+	sg_size_t height() const { return m_height; }
+
+	/*! \details Returns the number of glyphs that are drawn (spaces are not counted). */
+	u32 count() const { return m_glyphs.count(); }
+
+	/*! \details Returns the font used to create the layout. */
+	const Font * font() const { return m_font; }
+
+	/*! \details Returns the text used to create the layout. */
+	const char * text() const { return m_text.c_str(); }
+
+	/*! \details Returns the hash of the text (see calc_hash()). */
+	u32 hash() const { return m_hash; }
+
+	/*! \details Returns true if this layout was created with \a font (as it is now) and \a str. */
+	bool is_match(const Font & font, const char * str, u32 hash) const;
+
+	/*! \details Calculates the hash (32-bit FNV-1a) of \a str. */
+	static u32 calc_hash(const char * str);
+
+private:
+	typedef struct {
+		sg_font_char_t character;
+		sg_int_t x;
+	} glyph_t;
+
+	const Font * m_font;
+	u32 m_generation;
+	u32 m_hash;
+	var::String m_text;
+	var::Vector<glyph_t> m_glyphs;
+	sg_size_t m_width;
+	sg_size_t m_height;
+};
+
+/*! \brief Text Layout Cache Class
+ * \details The TextLayoutCache class keeps the most recently used
+ * TextLayout objects so labels that are drawn on every frame are only laid out once.
+ *
+ * Entries are found by a hash of the string and the font, then confirmed
+ * by comparing the string and Font::generation(). A font that is changed
+ * (or deleted and replaced by another at the same address) never reuses
+ * an old layout. When the cache is full, the least recently
+ * used entry is replaced.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * TextLayoutCache cache(16);
+ *
+ * const TextLayout * layout = cache.get(font, "Volume");
+ * if( layout ){
+ *   layout->draw(bitmap, point);
+ * }
+ * \endcode
+ *
+ */
+class TextLayoutCache {
+public:
+
+	enum {
+		DEFAULT_SIZE = 8 /*! Default number of layouts */
+	};
+
+	/*! \details Constructs a cache that holds up to \a count layouts. */
+	TextLayoutCache(u8 count = DEFAULT_SIZE);
+	~TextLayoutCache();
+
+	/*! \details Returns the layout of \a str with \a font (or zero if it can't be created).
+	 *
+	 * The pointer is valid until the next call to get() or clear().
+	 *
+	 */
+	const TextLayout * get(const Font & font, const char * str);
+
+	/*! \details Removes all the layouts (the memory is kept). */
+	void clear();
+
+	/*! \details Returns the number of layouts the cache holds. */
+	u8 size() const { return m_size; }
+
+	/*! \details Returns the number of calls to get() that used a cached layout. */
+	u32 hits() const { return m_hits; }
+
+	/*! \details Returns the number of calls to get() that created a layout. */
+	u32 misses() const { return m_misses; }
+
+private:
+	typedef struct {
+		TextLayout layout;
+		u32 last_used; //zero if not used
+	} entry_t;
+
+	//copies would share (and delete) the entries
+	TextLayoutCache(const TextLayoutCache & a);
+	TextLayoutCache & operator = (const TextLayoutCache & a);
+
+	entry_t * m_entries;
+	u8 m_size;
+	u32 m_clock;
+	u32 m_hits;
+	u32 m_misses;
+};
+
+}
+
+#endif /* SGFX_TEXTLAYOUT_HPP_ */
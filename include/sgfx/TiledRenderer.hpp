@@ -0,0 +1,209 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_TILEDRENDERER_HPP_
+#define SGFX_TILEDRENDERER_HPP_
+
+#include <sapi/sg_types.h>
+#include "../var/Vector.hpp"
+#include "../api/SgfxObject.hpp"
+#include "Bitmap.hpp"
+#include "Pen.hpp"
+
+namespace sgfx {
+
+/*! \brief Tiled Renderer Class
+ * \details The TiledRenderer class records a list of drawing commands
+ * and then replays them on a bitmap using several threads. The bitmap is split
+ * into tiles. Each thread draws the whole command list on one tile at a time
+ * using a sub-bitmap that is clipped to the tile.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * Bitmap bitmap(1920, 1080);
+ * TiledRenderer renderer;
+ *
+ * renderer.set_thread_count(4);
+ * renderer.pen().set_color(1);
+ * renderer.draw_rectangle(sg_region(sg_point(0,0), sg_dim(1920, 100)));
+ * renderer.pen().set_invert();
+ * renderer.draw_line(sg_point(0,0), sg_point(1919,1079));
+ * renderer.draw_path(path, map);
+ *
+ * renderer.render(bitmap); //can be called again to draw the same commands
+ * \endcode
+ *
+ * By default, the tiles are row bands that span the width of the bitmap. Row bands
+ * share the bitmap's memory so nothing is copied. When set_tile_size() makes
+ * the tiles narrower than the bitmap, each thread copies a tile to its own bitmap,
+ * draws on it, then copies it back. The width of narrow tiles is rounded up to a
+ * whole number of 32-bit words so that threads never write the same word.
+ *
+ * Because each tile is clipped, the output matches drawing the commands on the whole
+ * bitmap except for pour fills (including icons drawn with a fill pen), which stop at the
+ * tile edges. Paths drawn with a fill pen are filled using a VectorRasterizer (one per thread)
+ * so they are not affected. Icons are drawn without the Vector::cache() because
+ * the cache is not thread-safe.
+ *
+ * Objects that are referenced by commands (bitmaps, icons and paths) are not
+ * copied. They must stay valid until render() returns. Function commands (see draw_function())
+ * can be used for anything else. They must only draw on the tile bitmap they are given.
+ *
+ */
+class TiledRenderer : public api::SgfxWorkObject {
+public:
+
+	/*! \details Function that draws on a tile.
+	 *
+	 * @param context The context passed to draw_function()
+	 * @param tile The bitmap for the tile (with the recorded pen)
+	 * @param offset The location of the tile in the target bitmap
+	 *
+	 * The point \a p in the target bitmap is at (p.x - offset.x, p.y - offset.y) on \a tile.
+	 */
+	typedef void (*draw_function_t)(void * context, Bitmap & tile, const sg_point_t & offset);
+
+	enum {
+		DEFAULT_TILE_HEIGHT = 32 /*! Default height of each tile in pixels */,
+#if defined __link
+		DEFAULT_STACK_SIZE = 256*1024 /*! Default stack size for rendering threads */
+#else
+		DEFAULT_STACK_SIZE = 2048 /*! Default stack size for rendering threads */
+#endif
+	};
+
+	TiledRenderer();
+
+	/*! \details Sets the number of threads used by render() (including the calling thread).
+	 *
+	 * With a value of 1 (the default), render() draws all the tiles on the calling thread.
+	 */
+	void set_thread_count(u16 value){ m_thread_count = value ? value : 1; }
+
+	/*! \details Returns the number of threads used by render(). */
+	u16 thread_count() const { return m_thread_count; }
+
+	/*! \details Sets the tile size.
+	 *
+	 * @param width The width of each tile (0 for the width of the bitmap)
+	 * @param height The height of each tile (0 for DEFAULT_TILE_HEIGHT)
+	 */
+	void set_tile_size(sg_size_t width, sg_size_t height){
+		m_tile_width = width;
+		m_tile_height = height ? height : (sg_size_t)DEFAULT_TILE_HEIGHT;
+	}
+
+	/*! \details Returns the tile width (0 for the width of the bitmap). */
+	sg_size_t tile_width() const { return m_tile_width; }
+
+	/*! \details Returns the tile height. */
+	sg_size_t tile_height() const { return m_tile_height; }
+
+	/*! \details Sets the stack size of each rendering thread. */
+	void set_stack_size(u32 value){ m_stack_size = value; }
+
+	/*! \details Accesses the pen used for commands that are recorded after it is changed. */
+	Pen & pen(){ return m_pen; }
+
+	/*! \details Sets the pen used for commands that are recorded after this call. */
+	void set_pen(const Pen & pen){ m_pen = pen; }
+
+	/*! \details Removes all the recorded commands. */
+	void clear(){ m_commands.clear(); }
+
+	/*! \details Returns the number of recorded commands. */
+	u32 count() const { return m_commands.count(); }
+
+	/*! \details Records Bitmap::draw_pixel(). */
+	int draw_pixel(sg_point_t p);
+
+	/*! \details Records Bitmap::draw_line(). */
+	int draw_line(sg_point_t p1, sg_point_t p2);
+
+	/*! \details Records Bitmap::draw_arc(). */
+	int draw_arc(const sg_region_t & region, s16 start, s16 end, s16 rotation = 0);
+
+	/*! \details Records Bitmap::draw_rectangle(). */
+	int draw_rectangle(const sg_region_t & region);
+
+	/*! \details Records Bitmap::draw_pattern(). */
+	int draw_pattern(const sg_region_t & region, sg_bmap_data_t odd_pattern, sg_bmap_data_t even_pattern, sg_size_t pattern_height);
+
+	/*! \details Records Bitmap::draw_bitmap() (\a src is not copied). */
+	int draw_bitmap(sg_point_t p_dest, const Bitmap & src);
+
+	/*! \details Records Bitmap::draw_sub_bitmap() (\a src is not copied). */
+	int draw_sub_bitmap(sg_point_t p_dest, const Bitmap & src, const sg_region_t & region_src);
+
+	/*! \details Records Vector::draw() (\a icon is not copied). */
+	int draw_icon(const sg_vector_icon_t & icon, const sg_vector_map_t & map);
+
+	/*! \details Records Vector::draw_path() (\a path is not copied). */
+	int draw_path(const sg_vector_path_t & path, const sg_vector_map_t & map);
+
+	/*! \details Records a call to \a function for each tile. */
+	int draw_function(draw_function_t function, void * context);
+
+	/*! \details Draws the recorded commands on \a bitmap.
+	 *
+	 * @param bitmap The target bitmap
+	 * @return Zero on success or -1 if memory could not be allocated
+	 *
+	 * The commands are kept so they can be drawn again. If a thread can't be created,
+	 * its tiles are drawn by the calling thread. The bitmap is marked dirty once for the whole area.
+	 */
+	int render(Bitmap & bitmap);
+
+private:
+	enum {
+		COMMAND_PIXEL,
+		COMMAND_LINE,
+		COMMAND_ARC,
+		COMMAND_RECTANGLE,
+		COMMAND_PATTERN,
+		COMMAND_BITMAP,
+		COMMAND_SUB_BITMAP,
+		COMMAND_ICON,
+		COMMAND_PATH,
+		COMMAND_FUNCTION
+	};
+
+	typedef struct {
+		u8 type;
+		sg_pen_t pen;
+		s32 bounds[4]; //x0, y0, x1, y1 (exclusive) of the pixels the command can change
+		sg_region_t region; //rectangle, pattern, arc or source region
+		sg_point_t point[2];
+		s16 value[3]; //arc angles and rotation, or pattern height
+		sg_bmap_data_t pattern[2];
+		sg_vector_map_t map;
+		const void * object; //Bitmap, icon or path
+		draw_function_t function;
+		void * context;
+	} command_t;
+
+	class Worker;
+
+	int record(command_t & command);
+	void draw_tile(Worker & worker, u32 tile) const;
+	void draw_command(Worker & worker, Bitmap & tile, const command_t & command, const sg_point_t & offset) const;
+	static void * render_thread(void * args);
+
+	var::Vector<command_t> m_commands;
+	Pen m_pen;
+	u16 m_thread_count;
+	sg_size_t m_tile_width;
+	sg_size_t m_tile_height;
+	u32 m_stack_size;
+
+	//set while rendering
+	Bitmap * m_target;
+	sg_size_t m_width; //tile width after rounding
+	sg_size_t m_columns; //number of tile columns
+	u32 m_tile_count;
+
+};
+
+}
+
+#endif /* SGFX_TILEDRENDERER_HPP_ */
@@ -14,6 +14,9 @@
 
 namespace sgfx {
 
+class VectorCache;
+class VectorRasterizer;
+
 /*! \brief Vecotor Map Class
  * \details This class is a wrapper for a sg_vector_map_t data structure.
  */
@@ -82,12 +85,38 @@ public:
 	 * @param icon The icon to draw
 	 * @param map The map describing how the icon will be mapped to the bitmap
 	 * @param bounds A pointer to the bounds if needed (otherwise null)
+	 *
+	 * If a cache has been set (see set_cache()), the icon is drawn from the cache
+	 * when possible.
 	 */
 	static void draw(Bitmap & bitmap, const sg_vector_icon_t & icon, const sg_vector_map_t & map, sg_region_t * bounds = 0);
 
 
+	/*! \details Draws a path on a bitmap.
+	 *
+	 * If a rasterizer has been set (see set_rasterizer()) and the bitmap pen
+	 * has SG_PEN_FLAG_IS_FILL set, the path is filled using the rasterizer.
+	 */
 	static void draw_path(Bitmap & bitmap, sg_vector_path_t & path, const sg_vector_map_t & map);
 
+	/*! \details Sets the cache used by draw() and the draw_*() icons (null to draw without a cache).
+	 *
+	 * The cache must remain valid until it is removed.
+	 */
+	static void set_cache(VectorCache * cache){ m_cache = cache; }
+
+	/*! \details Returns the cache used by draw() (or null). */
+	static VectorCache * cache(){ return m_cache; }
+
+	/*! \details Sets the rasterizer used by draw_path() to fill paths (null to use the stroke and pour method).
+	 *
+	 * The rasterizer must remain valid until it is removed.
+	 */
+	static void set_rasterizer(VectorRasterizer * rasterizer){ m_rasterizer = rasterizer; }
+
+	/*! \details Returns the rasterizer used by draw_path() (or null). */
+	static VectorRasterizer * rasterizer(){ return m_rasterizer; }
+
 
 	static sg_vector_primitive_t fill(const Point & p);
 	static sg_vector_primitive_t fill(sg_int_t x, sg_int_t y){
@@ -172,6 +201,10 @@ private:
 	static sg_int_t find_bottom(const Bitmap & bitmap);
 	static sg_int_t find_left(const Bitmap & bitmap);
 	static sg_int_t find_right(const Bitmap & bitmap);
+	static void mark_dirty(const Bitmap & bitmap, const sg_vector_map_t & map);
+
+	static VectorCache * m_cache;
+	static VectorRasterizer * m_rasterizer;
 
 
 };
@@ -0,0 +1,116 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_VECTORCACHE_HPP_
+#define SGFX_VECTORCACHE_HPP_
+
+#include <sapi/sg_types.h>
+#include "../var/Vector.hpp"
+#include "Bitmap.hpp"
+
+namespace sgfx {
+
+/*! \brief Vector Icon Cache Class
+ * \details A VectorCache keeps the rendered bitmap (and bounds) of
+ * vector icons so an icon that is drawn again with the same map
+ * dimensions, rotation and pen is copied rather than rasterized.
+ *
+ * Icons are found by a hash of their primitives then confirmed by comparing
+ * a copy of the primitives kept with each bitmap.
+ *
+ * The cache is limited to budget() bytes (the bitmaps and the copies of the primitives).
+ * When it is full, the least recently used icons are freed.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * VectorCache cache(8192);
+ * Vector::set_cache(&cache); //Vector::draw() and the draw_*() icons now use the cache
+ *
+ * while(1){
+ *   Vector::draw_battery(bitmap, battery_map); //only rasterized the first time
+ *   Vector::draw_antenna(bitmap, antenna_map);
+ *   //...
+ * }
+ * \endcode
+ *
+ * Icons are rendered on a blank bitmap then ORed onto the destination so
+ * pour fills only stop at the icon's own lines. Icons drawn with
+ * an invert or erase pen are not cached.
+ *
+ */
+class VectorCache {
+public:
+
+	enum {
+		DEFAULT_BUDGET = 8192 /*! Default number of bytes used to cache icons */
+	};
+
+	/*! \details Constructs a new cache limited to \a budget bytes. */
+	VectorCache(u32 budget = DEFAULT_BUDGET);
+	~VectorCache();
+
+	/*! \details Draws \a icon on \a bitmap using \a map.
+	 *
+	 * @param bitmap The target bitmap
+	 * @param icon The icon to draw
+	 * @param map The map describing how the icon will be mapped to the bitmap
+	 * @param bounds A pointer to the bounds if needed (otherwise null)
+	 * @return Zero if the icon was drawn or -1 if it can't be cached (nothing is drawn)
+	 *
+	 */
+	int draw(Bitmap & bitmap, const sg_vector_icon_t & icon, const sg_vector_map_t & map, sg_region_t * bounds = 0);
+
+	/*! \details Sets the number of bytes that can be used to cache icons (least recently used icons are freed). */
+	void set_budget(u32 bytes);
+
+	/*! \details Returns the number of bytes that can be used to cache icons. */
+	u32 budget() const { return m_budget; }
+
+	/*! \details Returns the number of bytes used by cached icons (bitmaps and primitives). */
+	u32 usage() const { return m_usage; }
+
+	/*! \details Returns the number of icons drawn from the cache. */
+	u32 hits() const { return m_hits; }
+
+	/*! \details Returns the number of icons that had to be rasterized. */
+	u32 misses() const { return m_misses; }
+
+	/*! \details Frees all the cached icons (the counters are not changed). */
+	void clear();
+
+	/*! \details Calculates the hash used to identify \a icon (FNV-1a of the primitives). */
+	static u32 calc_hash(const sg_vector_icon_t & icon);
+
+private:
+	typedef struct {
+		Bitmap * bitmap;
+		sg_vector_primitive_t * primitives; //copy of the icon's primitives
+		u16 total;
+		u16 fill_total;
+		u32 hash;
+		u32 size; //bytes counted in the cache usage
+		u32 last_used;
+		sg_dim_t dim;
+		s16 rotation;
+		sg_pen_t pen;
+		sg_region_t bounds; //relative to bitmap
+		sg_point_t offset; //of the map point within bitmap
+	} entry_t;
+
+	void free_entries(u32 budget);
+	static u32 calc_entry_size(sg_size_t width, sg_size_t height, u16 total);
+	static bool is_match(const entry_t & entry, const sg_vector_icon_t & icon, const sg_vector_map_t & map, const sg_pen_t & pen);
+	void draw_entry(Bitmap & bitmap, const entry_t & entry, const sg_vector_map_t & map, sg_region_t * bounds) const;
+
+	u32 m_budget;
+	u32 m_usage;
+	u32 m_hits;
+	u32 m_misses;
+	u32 m_clock;
+	var::Vector<entry_t> m_entries;
+
+};
+
+}
+
+#endif /* SGFX_VECTORCACHE_HPP_ */
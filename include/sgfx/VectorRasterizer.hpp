@@ -0,0 +1,116 @@
+/*! \file */ //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#ifndef SGFX_VECTORRASTERIZER_HPP_
+#define SGFX_VECTORRASTERIZER_HPP_
+
+#include <sapi/sg_types.h>
+#include "../var/Vector.hpp"
+#include "../api/SgfxObject.hpp"
+#include "Bitmap.hpp"
+
+namespace sgfx {
+
+/*! \brief Vector Rasterizer Class
+ * \details The VectorRasterizer class fills vector paths one scanline
+ * at a time rather than stroking the outline and pouring the inside.
+ *
+ * The curves of each contour are flattened into edges. The edges that cross each scanline
+ * are kept in an active edge table, and the spans between
+ * them are filled using the even-odd or non-zero winding rule. The result
+ * doesn't depend on what is already in the bitmap, and gaps in the outline can't leak.
+ *
+ * \code
+ * #include <sapi/sgfx.hpp>
+ *
+ * VectorRasterizer rasterizer;
+ * rasterizer.set_antialias(); //only used if the bitmap has 4 or more bits per pixel
+ * Vector::set_rasterizer(&rasterizer); //Vector::draw_path() with a fill pen now uses the rasterizer
+ * \endcode
+ *
+ * Pour items in a path are ignored (every closed contour is filled). Contours
+ * that aren't closed are closed with a straight line.
+ *
+ * When anti-aliasing is enabled, each pixel on an edge is blended with the pen color based on
+ * how much of the pixel is covered. With 16 bits per pixel the colors are
+ * treated as RGB565 and with 32 bits per pixel as four 8-bit channels. With 4 and 8 bits
+ * per pixel, the colors are treated as levels (for example, a grayscale palette).
+ *
+ */
+class VectorRasterizer : public api::SgfxWorkObject {
+public:
+
+	enum fill_rule_type {
+		FILL_RULE_EVEN_ODD /*! A point is inside if a ray from it crosses an odd number of edges */,
+		FILL_RULE_NON_ZERO /*! A point is inside if the edges a ray from it crosses don't cancel out (SVG default) */
+	};
+
+	VectorRasterizer();
+
+	/*! \details Sets the fill rule (default is FILL_RULE_NON_ZERO). */
+	void set_fill_rule(enum fill_rule_type value){ m_fill_rule = value; }
+
+	/*! \details Returns the fill rule. */
+	enum fill_rule_type fill_rule() const { return m_fill_rule; }
+
+	/*! \details Enables anti-aliasing for bitmaps with 4 or more bits per pixel. */
+	void set_antialias(bool value = true){ m_is_antialias = value; }
+
+	/*! \details Returns true if anti-aliasing is enabled. */
+	bool is_antialias() const { return m_is_antialias; }
+
+	/*! \details Fills a path on \a bitmap.
+	 *
+	 * @param bitmap The target bitmap (the pen color and mode are used)
+	 * @param items The path descriptions
+	 * @param count The number of descriptions in \a items
+	 * @param map The map describing how the path will be mapped to the bitmap
+	 * @return Zero on success or -1 if memory could not be allocated
+	 *
+	 */
+	int fill(Bitmap & bitmap, const sg_vector_path_description_t * items, u32 count, const sg_vector_map_t & map);
+
+	/*! \details Fills \a path on \a bitmap (see the method above). */
+	int fill(Bitmap & bitmap, const sg_vector_path_t & path, const sg_vector_map_t & map){
+		return fill(bitmap, path.list, path.count, map);
+	}
+
+private:
+	typedef struct {
+		float x; //at the top of the edge
+		float y_top;
+		float y_bottom;
+		float slope; //change in x per pixel of y
+		s8 winding;
+	} edge_t;
+
+	typedef struct {
+		float x;
+		s8 winding;
+	} crossing_t;
+
+	static int compare_edges(const void * a, const void * b);
+	bool is_inside(s32 winding) const {
+		return m_fill_rule == FILL_RULE_EVEN_ODD ? ((winding & 1) != 0) : (winding != 0);
+	}
+	int add_edge(float x0, float y0, float x1, float y1);
+	int add_curve(const float * x, const float * y, u32 order);
+	u32 calc_crossings(float y, u32 & next_edge);
+	void fill_spans(Bitmap & bitmap, sg_int_t y, u32 count);
+	void add_coverage(u32 count, float weight);
+	void draw_coverage(Bitmap & bitmap, sg_int_t y, u32 bits_per_pixel);
+
+	enum fill_rule_type m_fill_rule;
+	bool m_is_antialias;
+	var::Vector<edge_t> m_edges; //sorted by y_top
+	var::Vector<u32> m_active; //edges that may cross the current scanline
+	var::Vector<crossing_t> m_crossings;
+	var::Vector<float> m_coverage;
+	sg_int_t m_width;
+	sg_int_t m_coverage_min;
+	sg_int_t m_coverage_max;
+
+};
+
+}
+
+#endif /* SGFX_VECTORRASTERIZER_HPP_ */
@@ -3,13 +3,10 @@
 #ifndef THREAD_HPP_
 #define THREAD_HPP_
 
-
-
-#ifndef __link
-
 #include "../api/WorkObject.hpp"
 #include <mcu/types.h>
 #include <pthread.h>
+#include <signal.h>
 #include "Sched.hpp"
 #include "../api/SysObject.hpp"
 
@@ -186,7 +183,7 @@ public:
      *
      *
 	 */
-	static int join(int ident, void ** value_ptr = 0);
+	static int join(pthread_t ident, void ** value_ptr = 0);
 
     /*! \details Joins the calling thread to the specified thread.
      *
@@ -259,15 +256,14 @@ private:
 	int init(int stack_size, bool detached);
     int reset();
 
-    void set_id_pending(){ m_id = ID_PENDING; }
-	void set_id_error(){ m_id = ID_ERROR; }
+    //pthread_t is not an integer on all link hosts
+    void set_id_pending(){ m_id = (pthread_t)ID_PENDING; }
+	void set_id_error(){ m_id = (pthread_t)ID_ERROR; }
 
-    bool is_id_pending() const { return m_id == ID_PENDING; }
-    bool is_id_error() const { return m_id == ID_ERROR; }
+    bool is_id_pending() const { return m_id == (pthread_t)ID_PENDING; }
+    bool is_id_error() const { return m_id == (pthread_t)ID_ERROR; }
 };
 
 }
 
-#endif
-
 #endif /* THREAD_HPP_ */
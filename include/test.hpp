@@ -13,6 +13,11 @@ namespace test{}
 #include "test/Function.hpp"
 #include "test/Case.hpp"
 #include "test/Test.hpp"
+#include "test/FftBatchTest.hpp"
+#include "test/FileFontTest.hpp"
+#include "test/PidBankTest.hpp"
+#include "test/SgfxHostApiTest.hpp"
+#include "test/TiledRendererTest.hpp"
 
 
 using namespace test;
@@ -0,0 +1,56 @@
+#ifndef TEST_FFTBATCHTEST_HPP
+#define TEST_FFTBATCHTEST_HPP
+
+#include "../dsp/FftBatch.hpp"
+#include "Test.hpp"
+
+namespace test {
+
+/*! \brief FFT Batch Test Class
+ * \details The FftBatchTest class checks dsp::FftBatchRealF32 and measures
+ * how many channels it transforms per second.
+ *
+ * The api case transforms the same channels with 1 to MAX_THREADS threads using
+ * channel major and interleaved input and fails if any output differs from the
+ * single thread, channel major output. The performance case transforms CHANNELS
+ * channels of SAMPLES samples PERFORMANCE_ITERATIONS times with 1, 2, 4 and 8 threads
+ * and reports the channels per second of each.
+ *
+ * The DSP functions must be installed (see api::DspWorkObject::request_arm_dsp_api())
+ * before the test is executed.
+ *
+ * \code
+ * #include <sapi/test.hpp>
+ *
+ * DspWorkObject::request_arm_dsp_api();
+ * Test::initialize("fft-batch-test", "0.1");
+ * if( is_test_enabled ){
+ *   FftBatchTest test;
+ *   test.execute(Test::EXECUTE_API | Test::EXECUTE_PERFORMANCE);
+ * }
+ * Test::finalize();
+ * \endcode
+ *
+ */
+class FftBatchTest : public Test {
+public:
+
+    /*! \details Constructs a new test. */
+    FftBatchTest(Test * parent = 0);
+
+    bool execute_class_api_case();
+    bool execute_class_performance_case();
+
+private:
+    enum {
+        SAMPLES = 256,
+        CHANNELS = 16,
+        PERFORMANCE_ITERATIONS = 50
+    };
+
+    bool is_api_installed();
+};
+
+}
+
+#endif // TEST_FFTBATCHTEST_HPP
@@ -0,0 +1,56 @@
+#ifndef TEST_FILEFONTTEST_HPP
+#define TEST_FILEFONTTEST_HPP
+
+#include "../sgfx/Bitmap.hpp"
+#include "../sgfx/FileFont.hpp"
+#include "Test.hpp"
+
+namespace test {
+
+/*! \brief File Font Test Class
+ * \details The FileFontTest class measures how many glyphs sgfx::FileFont
+ * draws per second with the canvas cache cold and warm.
+ *
+ * The api case draws every printable character of the font with a one canvas cache
+ * and with the default cache and fails if the results differ. The performance case draws
+ * the printable characters PERFORMANCE_ITERATIONS times. For the cold cache, the canvases are
+ * freed before each pass so they are read from the file again. For the warm cache, they stay
+ * in memory. Both report the glyphs per second and the canvas loads per pass.
+ *
+ * \code
+ * #include <sapi/test.hpp>
+ *
+ * Test::initialize("file-font-test", "0.1");
+ * if( is_test_enabled ){
+ *   FileFontTest test("/home/font.sbf");
+ *   test.execute(Test::EXECUTE_API | Test::EXECUTE_PERFORMANCE);
+ * }
+ * Test::finalize();
+ * \endcode
+ *
+ */
+class FileFontTest : public Test {
+public:
+
+    /*! \details Constructs a new test using the font file at \a path. */
+    FileFontTest(const char * path, Test * parent = 0);
+
+    bool execute_class_api_case();
+    bool execute_class_performance_case();
+
+private:
+    enum {
+        PERFORMANCE_ITERATIONS = 20,
+        BITMAP_WIDTH = 320,
+        BITMAP_HEIGHT = 240
+    };
+
+    bool open(sgfx::FileFont & font);
+    u32 draw_all(const sgfx::FileFont & font, sgfx::Bitmap & bitmap);
+
+    const char * m_path;
+};
+
+}
+
+#endif // TEST_FILEFONTTEST_HPP
@@ -0,0 +1,51 @@
+#ifndef TEST_PIDBANKTEST_HPP
+#define TEST_PIDBANKTEST_HPP
+
+#include "../calc/PidBank.hpp"
+#include "Test.hpp"
+
+namespace test {
+
+/*! \brief PID Bank Test Class
+ * \details The PidBankTest class checks calc::PidBank_f and calc::PidBank_s32
+ * and measures how many loops they update per second.
+ *
+ * The api case checks that new loops are not clamped, that set_min() and set_max()
+ * limit the control variable, and that disabled loops are not written. The performance
+ * case updates LOOP_COUNT loops PERFORMANCE_ITERATIONS times with all the loops enabled and
+ * with every other loop disabled, and reports the loops per second.
+ *
+ * \code
+ * #include <sapi/test.hpp>
+ *
+ * Test::initialize("pid-bank-test", "0.1");
+ * if( is_test_enabled ){
+ *   PidBankTest test;
+ *   test.execute(Test::EXECUTE_API | Test::EXECUTE_PERFORMANCE);
+ * }
+ * Test::finalize();
+ * \endcode
+ *
+ */
+class PidBankTest : public Test {
+public:
+
+    /*! \details Constructs a new test. */
+    PidBankTest(Test * parent = 0);
+
+    bool execute_class_api_case();
+    bool execute_class_performance_case();
+
+private:
+    enum {
+        LOOP_COUNT = 64,
+        PERFORMANCE_ITERATIONS = 2000
+    };
+
+    template<typename T> bool check_bank(calc::PidBank<T> & bank, const char * name);
+    template<typename T> void measure(calc::PidBank<T> & bank, const char * name);
+};
+
+}
+
+#endif // TEST_PIDBANKTEST_HPP
@@ -0,0 +1,78 @@
+#ifndef TEST_SGFXHOSTAPITEST_HPP
+#define TEST_SGFXHOSTAPITEST_HPP
+
+#include <sapi/sg.h>
+#include "../var/Vector.hpp"
+#include "Test.hpp"
+
+namespace test {
+
+/*! \brief Sgfx Host API Test Class
+ * \details The SgfxHostApiTest class compares the host sgfx functions
+ * with sg_api().
+ *
+ * The host functions (installed by api::SgfxObject::request_sgfx_api() on link builds)
+ * replace draw_rectangle(), draw_pattern(), draw_bitmap(), draw_sub_bitmap() and
+ * cursor_draw_hline() with versions that work a word at a time. They assume the pixel
+ * layout and pen behavior of sg_api(). The api case draws with both on the same random
+ * bitmaps (every pen mode with clipped and unclipped regions) and fails if any
+ * result is not identical. The performance case reports the megapixels per second
+ * of each function for both. The test is built on link only.
+ *
+ * \code
+ * #include <sapi/test.hpp>
+ *
+ * Test::initialize("sgfx-host-api-test", "0.1");
+ * if( is_test_enabled ){
+ *   SgfxHostApiTest test;
+ *   test.execute(Test::EXECUTE_API | Test::EXECUTE_PERFORMANCE);
+ * }
+ * Test::finalize();
+ * \endcode
+ *
+ */
+class SgfxHostApiTest : public Test {
+public:
+
+    /*! \details Constructs a new test. */
+    SgfxHostApiTest(Test * parent = 0);
+
+    bool execute_class_api_case();
+    bool execute_class_performance_case();
+
+private:
+    enum {
+        DEST_WIDTH = 83,
+        DEST_HEIGHT = 9,
+        SRC_WIDTH = 45,
+        SRC_HEIGHT = 7,
+        WORDS = 1024,
+        PERFORMANCE_WIDTH = 320,
+        PERFORMANCE_HEIGHT = 240,
+        PERFORMANCE_ITERATIONS = 100
+    };
+
+    bool set_bitmaps();
+    void reset(u16 o_flags, sg_color_t color);
+    bool is_match() const;
+    u32 random();
+
+    bool check_rectangle();
+    bool check_pattern();
+    bool check_bitmap();
+    bool check_sub_bitmap();
+    bool check_hline();
+    void measure(const char * name, const sg_api_t * api, const sg_bmap_t * dest, const sg_bmap_t * src);
+
+    const sg_api_t * m_reference;
+    const sg_api_t * m_api;
+    var::Vector<sg_bmap_data_t> m_memory;
+    sg_bmap_t m_expected;
+    sg_bmap_t m_actual;
+    sg_bmap_t m_src;
+    u32 m_seed;
+};
+
+}
+
+#endif // TEST_SGFXHOSTAPITEST_HPP
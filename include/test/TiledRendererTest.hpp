@@ -0,0 +1,54 @@
+#ifndef TEST_TILEDRENDERERTEST_HPP
+#define TEST_TILEDRENDERERTEST_HPP
+
+#include "../sgfx/Bitmap.hpp"
+#include "../sgfx/TiledRenderer.hpp"
+#include "Test.hpp"
+
+namespace test {
+
+/*! \brief Tiled Renderer Test Class
+ * \details The TiledRendererTest class measures how sgfx::TiledRenderer
+ * scales with the number of threads.
+ *
+ * The api case renders the same commands with 1 to THREAD_COUNT_MAX threads (using
+ * row bands and narrow tiles) and fails if any result differs from drawing the
+ * commands on one thread. The performance case renders the commands on a
+ * PERFORMANCE_WIDTH x PERFORMANCE_HEIGHT bitmap with 1, 2, 4 and 8 threads and reports
+ * the frames per second of each.
+ *
+ * \code
+ * #include <sapi/test.hpp>
+ *
+ * Test::initialize("tiled-renderer-test", "0.1");
+ * if( is_test_enabled ){
+ *   TiledRendererTest test;
+ *   test.execute(Test::EXECUTE_API | Test::EXECUTE_PERFORMANCE);
+ * }
+ * Test::finalize();
+ * \endcode
+ *
+ */
+class TiledRendererTest : public Test {
+public:
+
+    /*! \details Constructs a new test. */
+    TiledRendererTest(Test * parent = 0);
+
+    bool execute_class_api_case();
+    bool execute_class_performance_case();
+
+private:
+    enum {
+        THREAD_COUNT_MAX = 8,
+        PERFORMANCE_WIDTH = 320,
+        PERFORMANCE_HEIGHT = 240,
+        PERFORMANCE_ITERATIONS = 50
+    };
+
+    void record(sgfx::TiledRenderer & renderer, const sgfx::Bitmap & src);
+};
+
+}
+
+#endif // TEST_TILEDRENDERERTEST_HPP
@@ -157,6 +157,12 @@ public:
 	static u32 minimum_size();
     static u32 block_size();
 
+	/*! \details Returns the capacity that alloc() uses for a request of \a size bytes.
+	 *
+	 * The size is rounded up to minimum_size() plus a whole number of block_size() blocks.
+	 */
+	static u32 calc_capacity(u32 size);
+
 	/*! \details Sets the storage object of the data. This object
 	 * will treat the data as statically allocated and will not free the memory
 	 * if free() is called or the object is destroyed.
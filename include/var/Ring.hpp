@@ -89,7 +89,7 @@ public:
 	 * @param buf A pointer to the data
 	 * @param size The number of bytes in the new ring buffer
 	 */
-    Ring(T * buf, u32 count) : RingBuffer(buf, count*sizeof(T)){}
+    Ring(T * buf, u32 count) : RingBuffer(buf, count*sizeof(T)){ m_size = count; }
 
 
     /*! \details Constructs a new ring buffer.
@@ -97,7 +97,7 @@ public:
      * @param size The number of bytes to allocate for the new buffer.
      *
      */
-    Ring(u32 count) : RingBuffer(count * sizeof(T)){}
+    Ring(u32 count) : RingBuffer(count * sizeof(T)){ m_size = count; }
 
 	/*! \details Writes data to the ring buffer.
 	 *
@@ -131,7 +131,8 @@ public:
      *
      */
     int resize(u32 count){
-        if( Data::resize(count*sizeof(T)) < 0 ){
+        //memory is only reallocated to grow (use shrink_to_fit() to free memory)
+        if( (count*sizeof(T) > Data::capacity()) && (Data::resize(count*sizeof(T)) < 0) ){
             return -1;
         }
         m_count = count;
@@ -0,0 +1,210 @@
+#ifndef DSP_HOST_API_H_
+#define DSP_HOST_API_H_
+
+//Host (link) implementation of the arm_dsp_api function tables
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <cstring>
+#include "api/DspObject.hpp"
+
+const arm_dsp_api_q15_t * dsp_host_api_q15();
+const arm_dsp_api_q31_t * dsp_host_api_q31();
+const arm_dsp_api_f32_t * dsp_host_api_f32();
+
+//FFT lengths supported by the host tables (same as CMSIS)
+enum {
+	DSP_HOST_FFT_MIN_LOG2 = 1,
+	DSP_HOST_FFT_MAX_LOG2 = 13
+};
+
+//returns log2(n) if n is a supported power of two or -1
+int dsp_host_fft_log2(u32 n);
+
+//returns n/2 (cos, sin) pairs of exp(2*pi*j*k/n) -- all the tables are computed on the first call and shared
+const double * dsp_host_twiddle(u32 n);
+
+//returns at least count doubles of scratch memory for the calling thread -- the memory is reused by the next call on the same thread
+double * dsp_host_work_buffer(u32 count);
+
+//in-place complex FFT with natural order input and output (not scaled)
+template<typename T> void dsp_host_cfft(T * data, u32 n, bool is_inverse){
+	u32 i, j, k, len, half, stride;
+	const double * twiddle = dsp_host_twiddle(n);
+
+	if( twiddle == 0 ){ return; }
+
+	//bit reversal
+	for(i=1, j=0; i < n; i++){
+		u32 bit = n >> 1;
+		for(; j & bit; bit >>= 1){ j ^= bit; }
+		j ^= bit;
+		if( i < j ){
+			T tmp;
+			tmp = data[2*i]; data[2*i] = data[2*j]; data[2*j] = tmp;
+			tmp = data[2*i+1]; data[2*i+1] = data[2*j+1]; data[2*j+1] = tmp;
+		}
+	}
+
+	for(len = 2; len <= n; len <<= 1){
+		half = len >> 1;
+		stride = n / len;
+		for(i=0; i < n; i += len){
+			for(k=0; k < half; k++){
+				T wr = twiddle[2*k*stride];
+				T wi = is_inverse ? twiddle[2*k*stride+1] : -twiddle[2*k*stride+1];
+				T * a = data + 2*(i + k);
+				T * b = data + 2*(i + k + half);
+				T tr = b[0]*wr - b[1]*wi;
+				T ti = b[0]*wi + b[1]*wr;
+				b[0] = a[0] - tr;
+				b[1] = a[1] - ti;
+				a[0] += tr;
+				a[1] += ti;
+			}
+		}
+	}
+}
+
+//puts natural order complex data in bit reversed order (CMSIS with bitReverseFlag = 0)
+template<typename T> void dsp_host_bit_reverse(T * data, u32 n){
+	u32 i, j;
+	for(i=1, j=0; i < n; i++){
+		u32 bit = n >> 1;
+		for(; j & bit; bit >>= 1){ j ^= bit; }
+		j ^= bit;
+		if( i < j ){
+			T tmp;
+			tmp = data[2*i]; data[2*i] = data[2*j]; data[2*j] = tmp;
+			tmp = data[2*i+1]; data[2*i+1] = data[2*j+1]; data[2*j+1] = tmp;
+		}
+	}
+}
+
+//real FFT of n samples using an n/2 point complex FFT -- output is X[0], X[n/2], X[1], ..., X[n/2-1] (CMSIS rfft_fast packing)
+template<typename T> void dsp_host_rfft(const T * input, T * output, u32 n){
+	u32 k;
+	u32 half = n/2;
+	const double * twiddle = dsp_host_twiddle(n);
+
+	if( twiddle == 0 ){ return; }
+
+	memcpy(output, input, n*sizeof(T));
+	dsp_host_cfft(output, half, false);
+
+	T z0r = output[0];
+	T z0i = output[1];
+	for(k=1; k <= half/2; k++){
+		u32 m = half - k;
+		T * zk = output + 2*k;
+		T * zm = output + 2*m;
+		T er = (zk[0] + zm[0]) / 2;
+		T ei = (zk[1] - zm[1]) / 2;
+		T or_ = (zk[1] + zm[1]) / 2;
+		T oi = (zm[0] - zk[0]) / 2;
+		T wr = twiddle[2*k];
+		T wi = -twiddle[2*k+1];
+		T tr = or_*wr - oi*wi;
+		T ti = or_*wi + oi*wr;
+		//X[m] = conj(E[k] - W^k O[k])
+		zk[0] = er + tr;
+		zk[1] = ei + ti;
+		if( m != k ){
+			zm[0] = er - tr;
+			zm[1] = -(ei - ti);
+		}
+	}
+	output[0] = z0r + z0i;
+	output[1] = z0r - z0i;
+}
+
+//inverse of dsp_host_rfft() -- the output is scaled by 1/n
+template<typename T> void dsp_host_rifft(const T * input, T * output, u32 n){
+	u32 k;
+	u32 half = n/2;
+	const double * twiddle = dsp_host_twiddle(n);
+
+	if( twiddle == 0 ){ return; }
+
+	T x0 = input[0];
+	T xh = input[1];
+	output[0] = (x0 + xh) / 2;
+	output[1] = (x0 - xh) / 2;
+	for(k=1; k <= half/2; k++){
+		u32 m = half - k;
+		const T * xk = input + 2*k;
+		const T * xm = input + 2*m;
+		//E[k] = (X[k] + conj(X[m]))/2, O[k] = (X[k] - conj(X[m]))/(2 W^k)
+		T er = (xk[0] + xm[0]) / 2;
+		T ei = (xk[1] - xm[1]) / 2;
+		T dr = (xk[0] - xm[0]) / 2;
+		T di = (xk[1] + xm[1]) / 2;
+		T wr = twiddle[2*k];
+		T wi = twiddle[2*k+1];
+		T or_ = dr*wr - di*wi;
+		T oi = dr*wi + di*wr;
+		//Z[k] = E[k] + j O[k], Z[m] = conj(E[k]) + j conj(O[k])
+		output[2*k] = er - oi;
+		output[2*k+1] = ei + or_;
+		if( m != k ){
+			output[2*m] = er + oi;
+			output[2*m+1] = or_ - ei;
+		}
+	}
+
+	dsp_host_cfft(output, half, true);
+	for(k=0; k < n; k++){
+		output[k] /= half;
+	}
+}
+
+//matrices are processed in tiles so the source and destination rows stay in cache
+enum {
+	DSP_HOST_MATRIX_BLOCK = 32
+};
+
+//biquad feed forward terms are calculated for blocks of samples before the feedback
+enum {
+	DSP_HOST_BIQUAD_BLOCK = 64
+};
+
+//dest (columns x rows) = transpose of src (rows x columns)
+template<typename T> void dsp_host_mat_trans(const T * src, u32 rows, u32 columns, T * dest){
+	u32 i, j, ii, jj;
+	for(ii=0; ii < rows; ii += DSP_HOST_MATRIX_BLOCK){
+		u32 i_end = ii + DSP_HOST_MATRIX_BLOCK < rows ? ii + DSP_HOST_MATRIX_BLOCK : rows;
+		for(jj=0; jj < columns; jj += DSP_HOST_MATRIX_BLOCK){
+			u32 j_end = jj + DSP_HOST_MATRIX_BLOCK < columns ? jj + DSP_HOST_MATRIX_BLOCK : columns;
+			for(i=ii; i < i_end; i++){
+				for(j=jj; j < j_end; j++){
+					dest[j*rows + i] = src[i*columns + j];
+				}
+			}
+		}
+	}
+}
+
+//checks the sizes for dest = a * b
+template<typename M> bool dsp_host_mat_mult_check(const M * a, const M * b, const M * dest){
+	return (a->numCols == b->numRows) && (dest->numRows == a->numRows) && (dest->numCols == b->numCols);
+}
+
+static inline q15_t dsp_host_sat_q15(s32 value){
+	if( value > 32767 ){ return 32767; }
+	if( value < -32768 ){ return -32768; }
+	return value;
+}
+
+static inline q31_t dsp_host_sat_q31(s64 value){
+	if( value > 2147483647LL ){ return 2147483647; }
+	if( value < -2147483648LL ){ return -2147483647 - 1; }
+	return value;
+}
+
+#endif /* DSP_HOST_API_H_ */
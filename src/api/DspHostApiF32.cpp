@@ -0,0 +1,596 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstdlib>
+#include <cstring>
+#include "DspHostApi.h"
+
+static void abs_f32(float32_t * src, float32_t * dest, uint32_t count){
+	for(uint32_t i=0; i < count; i++){ dest[i] = fabsf(src[i]); }
+}
+
+static void add_f32(float32_t * src_a, float32_t * src_b, float32_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(src_a + i), _mm256_loadu_ps(src_b + i)));
+	}
+#endif
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(src_a + i), _mm_loadu_ps(src_b + i)));
+	}
+#endif
+	for(; i < count; i++){ dest[i] = src_a[i] + src_b[i]; }
+}
+
+static void sub_f32(float32_t * src_a, float32_t * src_b, float32_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(dest + i, _mm256_sub_ps(_mm256_loadu_ps(src_a + i), _mm256_loadu_ps(src_b + i)));
+	}
+#endif
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_sub_ps(_mm_loadu_ps(src_a + i), _mm_loadu_ps(src_b + i)));
+	}
+#endif
+	for(; i < count; i++){ dest[i] = src_a[i] - src_b[i]; }
+}
+
+static void mult_f32(float32_t * src_a, float32_t * src_b, float32_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(src_a + i), _mm256_loadu_ps(src_b + i)));
+	}
+#endif
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(src_a + i), _mm_loadu_ps(src_b + i)));
+	}
+#endif
+	for(; i < count; i++){ dest[i] = src_a[i] * src_b[i]; }
+}
+
+static void negate_f32(float32_t * src, float32_t * dest, uint32_t count){
+	for(uint32_t i=0; i < count; i++){ dest[i] = -src[i]; }
+}
+
+static void offset_f32(float32_t * src, float32_t offset, float32_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	__m128 value = _mm_set1_ps(offset);
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(src + i), value));
+	}
+#endif
+	for(; i < count; i++){ dest[i] = src[i] + offset; }
+}
+
+static void scale_f32(float32_t * src, float32_t scale, float32_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	__m128 value = _mm_set1_ps(scale);
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(src + i), value));
+	}
+#endif
+	for(; i < count; i++){ dest[i] = src[i] * scale; }
+}
+
+static void mean_f32(float32_t * src, uint32_t count, float32_t * result){
+	float32_t sum = 0.0f;
+	for(uint32_t i=0; i < count; i++){ sum += src[i]; }
+	*result = sum / (float32_t)count;
+}
+
+static void power_f32(float32_t * src, uint32_t count, float32_t * result){
+	float32_t sum = 0.0f;
+	for(uint32_t i=0; i < count; i++){ sum += src[i] * src[i]; }
+	*result = sum;
+}
+
+static void var_f32(float32_t * src, uint32_t count, float32_t * result){
+	float32_t sum = 0.0f;
+	float32_t mean;
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	for(uint32_t i=0; i < count; i++){ sum += src[i]; }
+	mean = sum / (float32_t)count;
+	sum = 0.0f;
+	for(uint32_t i=0; i < count; i++){ sum += (src[i] - mean) * (src[i] - mean); }
+	*result = sum / (float32_t)(count - 1);
+}
+
+static void rms_f32(float32_t * src, uint32_t count, float32_t * result){
+	float32_t sum;
+	power_f32(src, count, &sum);
+	*result = sqrtf(sum / (float32_t)count);
+}
+
+static void std_f32(float32_t * src, uint32_t count, float32_t * result){
+	float32_t sum = 0.0f;
+	float32_t sum_of_squares = 0.0f;
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	for(uint32_t i=0; i < count; i++){
+		sum += src[i];
+		sum_of_squares += src[i] * src[i];
+	}
+	float32_t mean_of_squares = sum_of_squares / ((float32_t)count - 1.0f);
+	float32_t square_of_mean = sum * sum / ((float32_t)count * ((float32_t)count - 1.0f));
+	*result = sqrtf(mean_of_squares - square_of_mean);
+}
+
+static void min_f32(float32_t * src, uint32_t count, float32_t * result, uint32_t * index){
+	float32_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] < value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void max_f32(float32_t * src, uint32_t count, float32_t * result, uint32_t * index){
+	float32_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] > value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void dot_prod_f32(float32_t * src_a, float32_t * src_b, uint32_t count, float32_t * result){
+	float32_t sum = 0.0f;
+	uint32_t i = 0;
+#if defined __SSE2__
+	__m128 sum4 = _mm_setzero_ps();
+#if defined __AVX2__
+	__m256 sum8 = _mm256_setzero_ps();
+	for(; i + 8 <= count; i += 8){
+		sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(_mm256_loadu_ps(src_a + i), _mm256_loadu_ps(src_b + i)));
+	}
+	sum4 = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+#endif
+	for(; i + 4 <= count; i += 4){
+		sum4 = _mm_add_ps(sum4, _mm_mul_ps(_mm_loadu_ps(src_a + i), _mm_loadu_ps(src_b + i)));
+	}
+	float32_t lanes[4];
+	_mm_storeu_ps(lanes, sum4);
+	sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+	for(; i < count; i++){ sum += src_a[i] * src_b[i]; }
+	*result = sum;
+}
+
+//dest[i] += scale * src[i]
+static inline void multiply_accumulate_f32(float32_t * dest, const float32_t * src, float32_t scale, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	__m256 scale8 = _mm256_set1_ps(scale);
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(scale8, _mm256_loadu_ps(src + i))));
+	}
+#endif
+#if defined __SSE2__
+	__m128 scale4 = _mm_set1_ps(scale);
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(scale4, _mm_loadu_ps(src + i))));
+	}
+#endif
+	for(; i < count; i++){ dest[i] += scale * src[i]; }
+}
+
+//each sample of a scales all of b -- every output still sums its products in order of k
+static void conv_f32(float32_t * src_a, uint32_t a_count, float32_t * src_b, uint32_t b_count, float32_t * dest){
+	memset(dest, 0, (a_count + b_count - 1)*sizeof(float32_t));
+	for(uint32_t k=0; k < a_count; k++){
+		multiply_accumulate_f32(dest + k, src_b, src_a[k], b_count);
+	}
+}
+
+static void fir_init_f32(arm_fir_instance_f32 * instance, uint16_t taps, float32_t * coefficients, float32_t * state, uint32_t count){
+	instance->numTaps = taps;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	memset(state, 0, (taps + count - 1)*sizeof(float32_t));
+}
+
+static void fir_f32(const arm_fir_instance_f32 * instance, float32_t * src, float32_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	float32_t * state = instance->pState;
+	const float32_t * coefficients = instance->pCoeffs;
+
+	uint32_t n = 0;
+
+	memcpy(state + taps - 1, src, count*sizeof(float32_t));
+
+	//consecutive outputs are calculated together so each coefficient is loaded once per vector
+#if defined __AVX2__
+	for(; n + 8 <= count; n += 8){
+		__m256 sum = _mm256_setzero_ps();
+		for(uint32_t k=0; k < taps; k++){
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(coefficients[k]), _mm256_loadu_ps(state + n + k)));
+		}
+		_mm256_storeu_ps(dest + n, sum);
+	}
+#endif
+#if defined __SSE2__
+	for(; n + 4 <= count; n += 4){
+		__m128 sum = _mm_setzero_ps();
+		for(uint32_t k=0; k < taps; k++){
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coefficients[k]), _mm_loadu_ps(state + n + k)));
+		}
+		_mm_storeu_ps(dest + n, sum);
+	}
+#endif
+	for(; n < count; n++){
+		float32_t sum = 0.0f;
+		for(uint32_t k=0; k < taps; k++){
+			sum += coefficients[k] * state[n + k];
+		}
+		dest[n] = sum;
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(float32_t));
+}
+
+static void biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 * instance, uint8_t stages, float32_t * coefficients, float32_t * state){
+	instance->numStages = stages;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	memset(state, 0, 4*stages*sizeof(float32_t));
+}
+
+static void biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 * instance, float32_t * src, float32_t * dest, uint32_t count){
+	const float32_t * coefficients = instance->pCoeffs;
+	float32_t * state = instance->pState;
+	float32_t * input = src;
+
+	//history holds x[n-2], x[n-1] then a block of input
+	float32_t history[DSP_HOST_BIQUAD_BLOCK + 2];
+	float32_t feed_forward[DSP_HOST_BIQUAD_BLOCK];
+
+	for(uint32_t stage=0; stage < instance->numStages; stage++){
+		const float32_t b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2];
+		const float32_t a1 = coefficients[3], a2 = coefficients[4];
+		float32_t y1 = state[2], y2 = state[3];
+		history[0] = state[1];
+		history[1] = state[0];
+		for(uint32_t block=0; block < count; block += DSP_HOST_BIQUAD_BLOCK){
+			const uint32_t length = count - block < (uint32_t)DSP_HOST_BIQUAD_BLOCK ? count - block : (uint32_t)DSP_HOST_BIQUAD_BLOCK;
+			uint32_t n = 0;
+
+			//the input is copied first so dest can be the same as input
+			memcpy(history + 2, input + block, length*sizeof(float32_t));
+
+			//the feed forward terms don't depend on the output so they are vectorized
+#if defined __SSE2__
+			__m128 b0_4 = _mm_set1_ps(b0), b1_4 = _mm_set1_ps(b1), b2_4 = _mm_set1_ps(b2);
+			for(; n + 4 <= length; n += 4){
+				__m128 sum = _mm_add_ps(_mm_mul_ps(b0_4, _mm_loadu_ps(history + n + 2)), _mm_mul_ps(b1_4, _mm_loadu_ps(history + n + 1)));
+				_mm_storeu_ps(feed_forward + n, _mm_add_ps(sum, _mm_mul_ps(b2_4, _mm_loadu_ps(history + n))));
+			}
+#endif
+			for(; n < length; n++){
+				feed_forward[n] = b0*history[n + 2] + b1*history[n + 1] + b2*history[n];
+			}
+
+			for(n=0; n < length; n++){
+				float32_t y0 = feed_forward[n] + a1*y1 + a2*y2;
+				y2 = y1; y1 = y0;
+				dest[block + n] = y0;
+			}
+
+			history[0] = history[length];
+			history[1] = history[length + 1];
+		}
+		state[0] = history[1]; state[1] = history[0]; state[2] = y1; state[3] = y2;
+		state += 4;
+		coefficients += 5;
+		input = dest;
+	}
+}
+
+static void mat_init_f32(arm_matrix_instance_f32 * instance, uint16_t rows, uint16_t columns, float32_t * data){
+	instance->numRows = rows;
+	instance->numCols = columns;
+	instance->pData = data;
+}
+
+static arm_status mat_add_f32(const arm_matrix_instance_f32 * a, const arm_matrix_instance_f32 * b, arm_matrix_instance_f32 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	add_f32(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_sub_f32(const arm_matrix_instance_f32 * a, const arm_matrix_instance_f32 * b, arm_matrix_instance_f32 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	sub_f32(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_mult_f32(const arm_matrix_instance_f32 * a, const arm_matrix_instance_f32 * b, arm_matrix_instance_f32 * dest){
+	const u32 rows = a->numRows;
+	const u32 inner = a->numCols;
+	const u32 columns = b->numCols;
+	float32_t * c = dest->pData;
+	u32 i, j, k, kk, jj;
+
+	if( !dsp_host_mat_mult_check(a, b, dest) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+
+	memset(c, 0, rows*columns*sizeof(float32_t));
+
+	//a tile of b (BLOCK rows by 4*BLOCK columns) is reused for every row of a
+	for(kk=0; kk < inner; kk += DSP_HOST_MATRIX_BLOCK){
+		u32 k_end = kk + DSP_HOST_MATRIX_BLOCK < inner ? kk + DSP_HOST_MATRIX_BLOCK : inner;
+		for(jj=0; jj < columns; jj += 4*DSP_HOST_MATRIX_BLOCK){
+			u32 j_end = jj + 4*DSP_HOST_MATRIX_BLOCK < columns ? jj + 4*DSP_HOST_MATRIX_BLOCK : columns;
+			for(i=0; i < rows; i++){
+				float32_t * output = c + i*columns;
+				for(k=kk; k < k_end; k++){
+					const float32_t value = a->pData[i*inner + k];
+					const float32_t * row = b->pData + k*columns;
+					j = jj;
+#if defined __AVX2__
+					__m256 value8 = _mm256_set1_ps(value);
+					for(; j + 8 <= j_end; j += 8){
+						_mm256_storeu_ps(output + j, _mm256_add_ps(_mm256_loadu_ps(output + j), _mm256_mul_ps(value8, _mm256_loadu_ps(row + j))));
+					}
+#endif
+#if defined __SSE2__
+					__m128 value4 = _mm_set1_ps(value);
+					for(; j + 4 <= j_end; j += 4){
+						_mm_storeu_ps(output + j, _mm_add_ps(_mm_loadu_ps(output + j), _mm_mul_ps(value4, _mm_loadu_ps(row + j))));
+					}
+#endif
+					for(; j < j_end; j++){
+						output[j] += value * row[j];
+					}
+				}
+			}
+		}
+	}
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_trans_f32(const arm_matrix_instance_f32 * src, arm_matrix_instance_f32 * dest){
+	if( (src->numRows != dest->numCols) || (src->numCols != dest->numRows) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	dsp_host_mat_trans(src->pData, src->numRows, src->numCols, dest->pData);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_scale_f32(const arm_matrix_instance_f32 * src, float32_t scale, arm_matrix_instance_f32 * dest){
+	if( (src->numRows != dest->numRows) || (src->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	scale_f32(src->pData, scale, dest->pData, (uint32_t)src->numRows*src->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+//Gauss-Jordan elimination with partial pivoting -- src is used as working memory (like CMSIS)
+static arm_status mat_inverse_f32(const arm_matrix_instance_f32 * src, arm_matrix_instance_f32 * dest){
+	const u32 n = src->numRows;
+	float32_t * a = src->pData;
+	float32_t * x = dest->pData;
+	u32 i, j, k;
+
+	if( (src->numRows != src->numCols) || (dest->numRows != n) || (dest->numCols != n) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+
+	memset(x, 0, n*n*sizeof(float32_t));
+	for(i=0; i < n; i++){
+		x[i*n + i] = 1.0f;
+	}
+
+	for(k=0; k < n; k++){
+		u32 pivot = k;
+		float32_t scale;
+		for(i=k+1; i < n; i++){
+			if( fabsf(a[i*n + k]) > fabsf(a[pivot*n + k]) ){
+				pivot = i;
+			}
+		}
+
+		if( a[pivot*n + k] == 0.0f ){
+			return ARM_MATH_SINGULAR;
+		}
+
+		if( pivot != k ){
+			for(j=0; j < n; j++){
+				float32_t t = a[k*n + j]; a[k*n + j] = a[pivot*n + j]; a[pivot*n + j] = t;
+				t = x[k*n + j]; x[k*n + j] = x[pivot*n + j]; x[pivot*n + j] = t;
+			}
+		}
+
+		scale = 1.0f / a[k*n + k];
+		scale_f32(a + k*n, scale, a + k*n, n);
+		scale_f32(x + k*n, scale, x + k*n, n);
+
+		for(i=0; i < n; i++){
+			float32_t factor = a[i*n + k];
+			if( (i == k) || (factor == 0.0f) ){ continue; }
+			for(j=0; j < n; j++){
+				a[i*n + j] -= factor * a[k*n + j];
+				x[i*n + j] -= factor * x[k*n + j];
+			}
+		}
+	}
+	return ARM_MATH_SUCCESS;
+}
+
+static void cfft_f32(const arm_cfft_instance_f32 * instance, float32_t * data, uint8_t is_inverse, uint8_t is_bit_reversal){
+	const uint32_t n = instance->fftLen;
+	dsp_host_cfft(data, n, is_inverse != 0);
+	if( is_inverse ){
+		for(uint32_t i=0; i < 2*n; i++){ data[i] /= n; }
+	}
+	if( is_bit_reversal == 0 ){
+		dsp_host_bit_reverse(data, n);
+	}
+}
+
+static arm_status rfft_fast_init_f32(arm_rfft_fast_instance_f32 * instance, uint16_t n){
+	//both tables are built here so transforms can run concurrently
+	if( (n < 32) || (n > 4096) || (dsp_host_twiddle(n) == 0) || (dsp_host_twiddle(n/2) == 0) ){
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	memset(instance, 0, sizeof(arm_rfft_fast_instance_f32));
+	instance->fftLenRFFT = n;
+	instance->Sint.fftLen = n/2;
+	return ARM_MATH_SUCCESS;
+}
+
+static void rfft_fast_f32(arm_rfft_fast_instance_f32 * instance, float32_t * src, float32_t * dest, uint8_t is_inverse){
+	if( is_inverse ){
+		dsp_host_rifft(src, dest, instance->fftLenRFFT);
+	} else {
+		dsp_host_rfft(src, dest, instance->fftLenRFFT);
+	}
+}
+
+int dsp_host_fft_log2(u32 n){
+	int log2n;
+	if( (n == 0) || (n & (n-1)) ){
+		return -1;
+	}
+	log2n = __builtin_ctz(n);
+	if( (log2n < DSP_HOST_FFT_MIN_LOG2) || (log2n > DSP_HOST_FFT_MAX_LOG2) ){
+		return -1;
+	}
+	return log2n;
+}
+
+namespace {
+
+class TwiddleTables {
+public:
+	TwiddleTables(){
+		for(int log2n=0; log2n <= DSP_HOST_FFT_MAX_LOG2; log2n++){
+			const u32 n = 1 << log2n;
+			m_tables[log2n] = 0;
+			if( log2n < DSP_HOST_FFT_MIN_LOG2 ){
+				continue;
+			}
+			m_tables[log2n] = (double*)malloc(n*sizeof(double));
+			if( m_tables[log2n] ){
+				for(u32 k=0; k < n/2; k++){
+					m_tables[log2n][2*k] = cos(2.0*M_PI*k/n);
+					m_tables[log2n][2*k+1] = sin(2.0*M_PI*k/n);
+				}
+			}
+		}
+	}
+
+	~TwiddleTables(){
+		for(int log2n=0; log2n <= DSP_HOST_FFT_MAX_LOG2; log2n++){
+			free(m_tables[log2n]);
+		}
+	}
+
+	const double * table(int log2n) const { return m_tables[log2n]; }
+
+private:
+	double * m_tables[DSP_HOST_FFT_MAX_LOG2+1];
+};
+
+class WorkBuffer {
+public:
+	WorkBuffer(){
+		m_data = 0;
+		m_count = 0;
+	}
+
+	~WorkBuffer(){ free(m_data); }
+
+	double * data(u32 count){
+		if( count > m_count ){
+			double * data = (double*)realloc(m_data, count*sizeof(double));
+			if( data == 0 ){
+				return 0;
+			}
+			m_data = data;
+			m_count = count;
+		}
+		return m_data;
+	}
+
+private:
+	double * m_data;
+	u32 m_count;
+};
+
+}
+
+const double * dsp_host_twiddle(u32 n){
+	//static initialization is thread-safe so concurrent first calls wait for the tables
+	static const TwiddleTables tables;
+	int log2n = dsp_host_fft_log2(n);
+
+	if( log2n < 0 ){
+		return 0;
+	}
+	return tables.table(log2n);
+}
+
+double * dsp_host_work_buffer(u32 count){
+	//CMSIS instances have no room for a buffer so each thread keeps its own
+	static thread_local WorkBuffer buffer;
+	return buffer.data(count);
+}
+
+static arm_dsp_api_f32_t create_api_f32(){
+	arm_dsp_api_f32_t api;
+	memset(&api, 0, sizeof(api));
+	api.mean = mean_f32;
+	api.power = power_f32;
+	api.var = var_f32;
+	api.rms = rms_f32;
+	api.std = std_f32;
+	api.min = min_f32;
+	api.max = max_f32;
+	api.dot_prod = dot_prod_f32;
+	api.add = add_f32;
+	api.sub = sub_f32;
+	api.mult = mult_f32;
+	api.negate = negate_f32;
+	api.offset = offset_f32;
+	api.scale = scale_f32;
+	api.conv = conv_f32;
+	api.fir_init = fir_init_f32;
+	api.fir = fir_f32;
+	api.biquad_cascade_df1_init = biquad_cascade_df1_init_f32;
+	api.biquad_cascade_df1 = biquad_cascade_df1_f32;
+	api.mat_init = mat_init_f32;
+	api.mat_add = mat_add_f32;
+	api.mat_sub = mat_sub_f32;
+	api.mat_mult = mat_mult_f32;
+	api.mat_trans = mat_trans_f32;
+	api.mat_scale = mat_scale_f32;
+	api.mat_inverse = mat_inverse_f32;
+	api.cfft = cfft_f32;
+	api.rfft_fast_init = rfft_fast_init_f32;
+	api.rfft_fast = rfft_fast_f32;
+	api.abs = abs_f32;
+	return api;
+}
+
+const arm_dsp_api_f32_t * dsp_host_api_f32(){
+	static const arm_dsp_api_f32_t api = create_api_f32();
+	return &api;
+}
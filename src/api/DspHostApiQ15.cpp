@@ -0,0 +1,613 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include "DspHostApi.h"
+
+//The kernels match the CMSIS saturation and rounding for each function
+//(__SSAT() truncates q63_t values to 32-bits before saturating)
+
+static void abs_q15(q15_t * src, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	for(; i + 8 <= count; i += 8){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		//0 - (-32768) saturates to 32767
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_max_epi16(x, _mm_subs_epi16(zero, x)));
+	}
+#endif
+	for(; i < count; i++){
+		q15_t x = src[i];
+		dest[i] = x > 0 ? x : (x == (q15_t)0x8000 ? 0x7fff : -x);
+	}
+}
+
+static void add_q15(q15_t * src_a, q15_t * src_b, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	for(; i + 16 <= count; i += 16){
+		__m256i a = _mm256_loadu_si256((const __m256i*)(src_a + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(src_b + i));
+		_mm256_storeu_si256((__m256i*)(dest + i), _mm256_adds_epi16(a, b));
+	}
+#endif
+#if defined __SSE2__
+	for(; i + 8 <= count; i += 8){
+		__m128i a = _mm_loadu_si128((const __m128i*)(src_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src_b + i));
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_adds_epi16(a, b));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q15((s32)src_a[i] + src_b[i]);
+	}
+}
+
+static void sub_q15(q15_t * src_a, q15_t * src_b, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	for(; i + 16 <= count; i += 16){
+		__m256i a = _mm256_loadu_si256((const __m256i*)(src_a + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(src_b + i));
+		_mm256_storeu_si256((__m256i*)(dest + i), _mm256_subs_epi16(a, b));
+	}
+#endif
+#if defined __SSE2__
+	for(; i + 8 <= count; i += 8){
+		__m128i a = _mm_loadu_si128((const __m128i*)(src_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src_b + i));
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_subs_epi16(a, b));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q15((s32)src_a[i] - src_b[i]);
+	}
+}
+
+#if defined __SSE2__
+//multiplies a and b and arithmetic shifts the 32-bit products right by shift with saturation to 16 bits
+static inline __m128i mult_shift_q15(__m128i a, __m128i b, __m128i shift){
+	__m128i lo = _mm_mullo_epi16(a, b);
+	__m128i hi = _mm_mulhi_epi16(a, b);
+	__m128i p0 = _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift);
+	__m128i p1 = _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift);
+	return _mm_packs_epi32(p0, p1);
+}
+#endif
+
+static void mult_q15(q15_t * src_a, q15_t * src_b, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	const __m128i shift = _mm_cvtsi32_si128(15);
+	for(; i + 8 <= count; i += 8){
+		__m128i a = _mm_loadu_si128((const __m128i*)(src_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src_b + i));
+		_mm_storeu_si128((__m128i*)(dest + i), mult_shift_q15(a, b, shift));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q15(((s32)src_a[i] * src_b[i]) >> 15);
+	}
+}
+
+static void negate_q15(q15_t * src, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	for(; i + 8 <= count; i += 8){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_subs_epi16(zero, x));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = src[i] == (q15_t)0x8000 ? 0x7fff : -src[i];
+	}
+}
+
+static void offset_q15(q15_t * src, q15_t offset, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	const __m128i value = _mm_set1_epi16(offset);
+	for(; i + 8 <= count; i += 8){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_adds_epi16(x, value));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q15((s32)src[i] + offset);
+	}
+}
+
+static void scale_q15(q15_t * src, q15_t scale_fraction, int8_t shift, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+	const int k_shift = 15 - shift;
+	if( k_shift < 0 ){
+		for(; i < count; i++){
+			dest[i] = dsp_host_sat_q15(dsp_host_sat_q31(((s64)src[i] * scale_fraction) << -k_shift));
+		}
+		return;
+	}
+#if defined __SSE2__
+	const __m128i value = _mm_set1_epi16(scale_fraction);
+	const __m128i shift_count = _mm_cvtsi32_si128(k_shift);
+	for(; i + 8 <= count; i += 8){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dest + i), mult_shift_q15(x, value, shift_count));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q15(((s32)src[i] * scale_fraction) >> k_shift);
+	}
+}
+
+static void shift_q15(q15_t * src, int8_t shift, q15_t * dest, uint32_t count){
+	uint32_t i = 0;
+	if( shift >= 0 ){
+#if defined __SSE2__
+		const __m128i shift_count = _mm_cvtsi32_si128(shift);
+		for(; i + 8 <= count; i += 8){
+			__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+			lo = _mm_sll_epi32(lo, shift_count);
+			hi = _mm_sll_epi32(hi, shift_count);
+			_mm_storeu_si128((__m128i*)(dest + i), _mm_packs_epi32(lo, hi));
+		}
+#endif
+		for(; i < count; i++){
+			dest[i] = dsp_host_sat_q15((s32)((u32)(s32)src[i] << shift));
+		}
+	} else {
+#if defined __SSE2__
+		const __m128i shift_count = _mm_cvtsi32_si128(-shift);
+		for(; i + 8 <= count; i += 8){
+			__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+			_mm_storeu_si128((__m128i*)(dest + i), _mm_sra_epi16(x, shift_count));
+		}
+#endif
+		for(; i < count; i++){
+			dest[i] = src[i] >> -shift;
+		}
+	}
+}
+
+//the sum wraps at 32-bits like the q31_t accumulator in CMSIS
+static s32 sum_q15(const q15_t * src, uint32_t count){
+	uint32_t i = 0;
+	u32 sum = 0;
+#if defined __SSE2__
+	const __m128i ones = _mm_set1_epi16(1);
+	__m128i acc = _mm_setzero_si128();
+	u32 lanes[4];
+	for(; i + 8 <= count; i += 8){
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(src + i)), ones));
+	}
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+	for(; i < count; i++){
+		sum += (u32)(s32)src[i];
+	}
+	return (s32)sum;
+}
+
+static s64 sum_of_squares_q15(const q15_t * src, uint32_t count){
+	uint32_t i = 0;
+	u64 sum = 0;
+#if defined __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = _mm_setzero_si128();
+	u64 lanes[2];
+	for(; i + 8 <= count; i += 8){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		//each pair of squares is at most 2^31 so it fits in an unsigned 32-bit lane
+		__m128i pairs = _mm_madd_epi16(x, x);
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(pairs, zero));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(pairs, zero));
+	}
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = lanes[0] + lanes[1];
+#endif
+	for(; i < count; i++){
+		sum += (u64)((s32)src[i] * src[i]);
+	}
+	return (s64)sum;
+}
+
+//exact square root of a q15 value -- CMSIS uses an approximation that can differ in the last bit
+static q15_t sqrt_q15(q15_t value){
+	u32 x;
+	u32 root;
+	if( value <= 0 ){
+		return 0;
+	}
+	x = (u32)value << 15;
+	root = (u32)sqrt((double)x);
+	while( root*root > x ){ root--; }
+	while( (root+1)*(root+1) <= x ){ root++; }
+	return root;
+}
+
+static void mean_q15(q15_t * src, uint32_t count, q15_t * result){
+	*result = (q15_t)(sum_q15(src, count) / (q31_t)count);
+}
+
+static void power_q15(q15_t * src, uint32_t count, q63_t * result){
+	*result = sum_of_squares_q15(src, count);
+}
+
+static q31_t var_q31_from_sums(s32 sum, s64 sum_of_squares, uint32_t count){
+	q31_t mean_of_squares = (q31_t)(sum_of_squares / (q63_t)(count - 1));
+	q31_t square_of_mean = (q31_t)((q63_t)sum * sum / (q63_t)(count * (count - 1)));
+	return (mean_of_squares - square_of_mean) >> 15;
+}
+
+static void var_q15(q15_t * src, uint32_t count, q15_t * result){
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	*result = var_q31_from_sums(sum_q15(src, count), sum_of_squares_q15(src, count), count);
+}
+
+static void std_q15(q15_t * src, uint32_t count, q15_t * result){
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	*result = sqrt_q15(dsp_host_sat_q15(var_q31_from_sums(sum_q15(src, count), sum_of_squares_q15(src, count), count)));
+}
+
+static void rms_q15(q15_t * src, uint32_t count, q15_t * result){
+	s64 sum = sum_of_squares_q15(src, count);
+	*result = sqrt_q15(dsp_host_sat_q15((s32)((sum / (q63_t)count) >> 15)));
+}
+
+static void min_q15(q15_t * src, uint32_t count, q15_t * result, uint32_t * index){
+	q15_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] < value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void max_q15(q15_t * src, uint32_t count, q15_t * result, uint32_t * index){
+	q15_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] > value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void dot_prod_q15(q15_t * src_a, q15_t * src_b, uint32_t count, q63_t * result){
+	uint32_t i = 0;
+	s64 sum = 0;
+#if defined __SSE2__
+	const __m128i min = _mm_set1_epi32(0x80000000);
+	__m128i acc = _mm_setzero_si128();
+	s64 lanes[2];
+	for(; i + 8 <= count; i += 8){
+		__m128i a = _mm_loadu_si128((const __m128i*)(src_a + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src_b + i));
+		__m128i pairs = _mm_madd_epi16(a, b);
+		//a pair sum of 0x80000000 can only be +2^31 (both products are -32768*-32768)
+		__m128i sign = _mm_andnot_si128(_mm_cmpeq_epi32(pairs, min), _mm_srai_epi32(pairs, 31));
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(pairs, sign));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(pairs, sign));
+	}
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = lanes[0] + lanes[1];
+#endif
+	for(; i < count; i++){
+		sum += (s32)src_a[i] * src_b[i];
+	}
+	*result = sum;
+}
+
+static void conv_q15(q15_t * src_a, uint32_t a_count, q15_t * src_b, uint32_t b_count, q15_t * dest){
+	for(uint32_t n=0; n < a_count + b_count - 1; n++){
+		uint32_t k_start = n >= b_count - 1 ? n - (b_count - 1) : 0;
+		uint32_t k_end = n < a_count - 1 ? n : a_count - 1;
+		s64 sum = 0;
+		for(uint32_t k=k_start; k <= k_end; k++){
+			sum += (s32)src_a[k] * src_b[n - k];
+		}
+		dest[n] = dsp_host_sat_q15((s32)(sum >> 15));
+	}
+}
+
+//the fast version accumulates in 32-bits (wrapping) like CMSIS
+static void conv_fast_q15(q15_t * src_a, uint32_t a_count, q15_t * src_b, uint32_t b_count, q15_t * dest){
+	for(uint32_t n=0; n < a_count + b_count - 1; n++){
+		uint32_t k_start = n >= b_count - 1 ? n - (b_count - 1) : 0;
+		uint32_t k_end = n < a_count - 1 ? n : a_count - 1;
+		u32 sum = 0;
+		for(uint32_t k=k_start; k <= k_end; k++){
+			sum += (u32)((s32)src_a[k] * src_b[n - k]);
+		}
+		dest[n] = dsp_host_sat_q15((s32)sum >> 15);
+	}
+}
+
+static arm_status fir_init_q15(arm_fir_instance_q15 * instance, uint16_t taps, q15_t * coefficients, q15_t * state, uint32_t count){
+	if( (taps & 0x01) || (taps < 4) ){
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	instance->numTaps = taps;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	memset(state, 0, (taps + count - 1)*sizeof(q15_t));
+	return ARM_MATH_SUCCESS;
+}
+
+static void fir_q15(const arm_fir_instance_q15 * instance, q15_t * src, q15_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	q15_t * state = instance->pState;
+	const q15_t * coefficients = instance->pCoeffs;
+
+	memcpy(state + taps - 1, src, count*sizeof(q15_t));
+	for(uint32_t n=0; n < count; n++){
+		s64 sum;
+		dot_prod_q15((q15_t*)coefficients, state + n, taps, &sum);
+		dest[n] = dsp_host_sat_q15((s32)(sum >> 15));
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(q15_t));
+}
+
+static void fir_fast_q15(const arm_fir_instance_q15 * instance, q15_t * src, q15_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	q15_t * state = instance->pState;
+	const q15_t * coefficients = instance->pCoeffs;
+
+	memcpy(state + taps - 1, src, count*sizeof(q15_t));
+	for(uint32_t n=0; n < count; n++){
+		s64 sum;
+		//the low 32 bits are the same as a wrapping 32-bit accumulator
+		dot_prod_q15((q15_t*)coefficients, state + n, taps, &sum);
+		dest[n] = dsp_host_sat_q15((s32)(u32)sum >> 15);
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(q15_t));
+}
+
+static void biquad_cascade_df1_init_q15(arm_biquad_casd_df1_inst_q15 * instance, uint8_t stages, q15_t * coefficients, q15_t * state, int8_t post_shift){
+	instance->numStages = stages;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	instance->postShift = post_shift;
+	memset(state, 0, 4*stages*sizeof(q15_t));
+}
+
+template<bool is_fast> static void biquad_cascade_df1_q15_generic(const arm_biquad_casd_df1_inst_q15 * instance, q15_t * src, q15_t * dest, uint32_t count){
+	const q15_t * coefficients = instance->pCoeffs;
+	q15_t * state = instance->pState;
+	q15_t * input = src;
+	const int shift = 15 - instance->postShift;
+
+	for(int stage=0; stage < instance->numStages; stage++){
+		//coefficients are {b0, 0, b1, b2, a1, a2}
+		const s32 b0 = coefficients[0], b1 = coefficients[2], b2 = coefficients[3];
+		const s32 a1 = coefficients[4], a2 = coefficients[5];
+		s32 x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+		for(uint32_t n=0; n < count; n++){
+			s32 x0 = input[n];
+			s32 y0;
+			if( is_fast ){
+				u32 acc = (u32)(b0*x0) + (u32)(b1*x1) + (u32)(b2*x2) + (u32)(a1*y1) + (u32)(a2*y2);
+				y0 = dsp_host_sat_q15((s32)acc >> shift);
+			} else {
+				s64 acc = (s64)b0*x0 + (s64)b1*x1 + (s64)b2*x2 + (s64)a1*y1 + (s64)a2*y2;
+				y0 = dsp_host_sat_q15((s32)(acc >> shift));
+			}
+			x2 = x1; x1 = x0;
+			y2 = y1; y1 = y0;
+			dest[n] = y0;
+		}
+		state[0] = x1; state[1] = x2; state[2] = y1; state[3] = y2;
+		state += 4;
+		coefficients += 6;
+		input = dest;
+	}
+}
+
+static void biquad_cascade_df1_q15(const arm_biquad_casd_df1_inst_q15 * instance, q15_t * src, q15_t * dest, uint32_t count){
+	biquad_cascade_df1_q15_generic<false>(instance, src, dest, count);
+}
+
+static void biquad_cascade_df1_fast_q15(const arm_biquad_casd_df1_inst_q15 * instance, q15_t * src, q15_t * dest, uint32_t count){
+	biquad_cascade_df1_q15_generic<true>(instance, src, dest, count);
+}
+
+static void mat_init_q15(arm_matrix_instance_q15 * instance, uint16_t rows, uint16_t columns, q15_t * data){
+	instance->numRows = rows;
+	instance->numCols = columns;
+	instance->pData = data;
+}
+
+static arm_status mat_add_q15(const arm_matrix_instance_q15 * a, const arm_matrix_instance_q15 * b, arm_matrix_instance_q15 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	add_q15(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_sub_q15(const arm_matrix_instance_q15 * a, const arm_matrix_instance_q15 * b, arm_matrix_instance_q15 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	sub_q15(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_mult_q15(const arm_matrix_instance_q15 * a, const arm_matrix_instance_q15 * b, arm_matrix_instance_q15 * dest, q15_t * state){
+	const u32 rows = a->numRows;
+	const u32 inner = a->numCols;
+	const u32 columns = b->numCols;
+	u32 i, j, k, ii, jj;
+
+	if( !dsp_host_mat_mult_check(a, b, dest) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+
+	//state holds b transposed (like CMSIS) so both operands are read along rows
+	dsp_host_mat_trans(b->pData, inner, columns, state);
+
+	for(ii=0; ii < rows; ii += DSP_HOST_MATRIX_BLOCK){
+		u32 i_end = ii + DSP_HOST_MATRIX_BLOCK < rows ? ii + DSP_HOST_MATRIX_BLOCK : rows;
+		for(jj=0; jj < columns; jj += DSP_HOST_MATRIX_BLOCK){
+			u32 j_end = jj + DSP_HOST_MATRIX_BLOCK < columns ? jj + DSP_HOST_MATRIX_BLOCK : columns;
+			for(i=ii; i < i_end; i++){
+				const q15_t * row = a->pData + i*inner;
+				for(j=jj; j < j_end; j++){
+					const q15_t * column = state + j*inner;
+					q63_t sum = 0;
+					for(k=0; k < inner; k++){
+						sum += (s32)row[k] * column[k];
+					}
+					dest->pData[i*columns + j] = dsp_host_sat_q15(sum >> 15);
+				}
+			}
+		}
+	}
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_trans_q15(const arm_matrix_instance_q15 * src, arm_matrix_instance_q15 * dest){
+	if( (src->numRows != dest->numCols) || (src->numCols != dest->numRows) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	dsp_host_mat_trans(src->pData, src->numRows, src->numCols, dest->pData);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_scale_q15(const arm_matrix_instance_q15 * src, q15_t scale_fraction, int32_t shift, arm_matrix_instance_q15 * dest){
+	if( (src->numRows != dest->numRows) || (src->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	scale_q15(src->pData, scale_fraction, shift, dest->pData, (uint32_t)src->numRows*src->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static q15_t round_q15(double value){
+	return dsp_host_sat_q15(dsp_host_sat_q31((s64)lrint(value)));
+}
+
+//fixed point FFTs use double precision internally and scale the output like CMSIS (not bit exact)
+static void cfft_q15(const arm_cfft_instance_q15 * instance, q15_t * data, uint8_t is_inverse, uint8_t is_bit_reversal){
+	const uint32_t n = instance->fftLen;
+	double * buffer = dsp_host_work_buffer(2*n);
+	if( buffer == 0 ){
+		return;
+	}
+	for(uint32_t i=0; i < 2*n; i++){ buffer[i] = data[i]; }
+	dsp_host_cfft(buffer, n, is_inverse != 0);
+	if( is_bit_reversal == 0 ){
+		dsp_host_bit_reverse(buffer, n);
+	}
+	//output is scaled by 1/n in both directions
+	for(uint32_t i=0; i < 2*n; i++){ data[i] = round_q15(buffer[i] / n); }
+}
+
+static arm_cfft_instance_q15 m_cfft_q15[DSP_HOST_FFT_MAX_LOG2+1];
+
+static arm_status rfft_init_q15(arm_rfft_instance_q15 * instance, uint32_t n, uint32_t is_inverse, uint32_t is_bit_reversal){
+	int log2n = dsp_host_fft_log2(n);
+	if( (n < 32) || (log2n < 0) || (dsp_host_twiddle(n) == 0) ){
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	memset(instance, 0, sizeof(arm_rfft_instance_q15));
+	instance->fftLenReal = n;
+	instance->ifftFlagR = is_inverse;
+	instance->bitReverseFlagR = is_bit_reversal;
+	instance->twidCoefRModifier = 8192U / n;
+	m_cfft_q15[log2n-1].fftLen = n/2;
+	instance->pCfft = m_cfft_q15 + log2n - 1;
+	return ARM_MATH_SUCCESS;
+}
+
+//forward output is the full spectrum (n complex values) scaled by 1/n, the inverse uses the first n/2+1 complex values
+static void rfft_q15(const arm_rfft_instance_q15 * instance, q15_t * src, q15_t * dest){
+	const uint32_t n = instance->fftLenReal;
+	const uint32_t half = n/2;
+	double * input = dsp_host_work_buffer(2*n);
+	double * output = input + n;
+
+	if( input == 0 ){
+		return;
+	}
+
+	if( instance->ifftFlagR ){
+		input[0] = src[0];
+		input[1] = src[2*half];
+		for(uint32_t k=1; k < half; k++){
+			input[2*k] = src[2*k];
+			input[2*k+1] = src[2*k+1];
+		}
+		dsp_host_rifft(input, output, n);
+		//a forward then inverse transform returns the input scaled by 1/n
+		for(uint32_t k=0; k < n; k++){ dest[k] = round_q15(output[k]); }
+	} else {
+		for(uint32_t k=0; k < n; k++){ input[k] = src[k]; }
+		dsp_host_rfft(input, output, n);
+		dest[0] = round_q15(output[0] / n);
+		dest[1] = 0;
+		dest[2*half] = round_q15(output[1] / n);
+		dest[2*half+1] = 0;
+		for(uint32_t k=1; k < half; k++){
+			q15_t re = round_q15(output[2*k] / n);
+			q15_t im = round_q15(output[2*k+1] / n);
+			dest[2*k] = re;
+			dest[2*k+1] = im;
+			dest[2*(n-k)] = re;
+			dest[2*(n-k)+1] = dsp_host_sat_q15(-(s32)im);
+		}
+	}
+}
+
+static arm_dsp_api_q15_t create_api_q15(){
+	arm_dsp_api_q15_t api;
+	memset(&api, 0, sizeof(api));
+	api.mean = mean_q15;
+	api.power = power_q15;
+	api.var = var_q15;
+	api.rms = rms_q15;
+	api.std = std_q15;
+	api.min = min_q15;
+	api.max = max_q15;
+	api.dot_prod = dot_prod_q15;
+	api.add = add_q15;
+	api.sub = sub_q15;
+	api.mult = mult_q15;
+	api.negate = negate_q15;
+	api.offset = offset_q15;
+	api.scale = scale_q15;
+	api.shift = shift_q15;
+	api.conv = conv_q15;
+	api.conv_fast = conv_fast_q15;
+	api.fir_init = fir_init_q15;
+	api.fir = fir_q15;
+	api.fir_fast = fir_fast_q15;
+	api.biquad_cascade_df1_init = biquad_cascade_df1_init_q15;
+	api.biquad_cascade_df1 = biquad_cascade_df1_q15;
+	api.biquad_cascade_df1_fast = biquad_cascade_df1_fast_q15;
+	api.mat_init = mat_init_q15;
+	api.mat_add = mat_add_q15;
+	api.mat_sub = mat_sub_q15;
+	api.mat_mult = mat_mult_q15;
+	api.mat_trans = mat_trans_q15;
+	api.mat_scale = mat_scale_q15;
+	api.cfft = cfft_q15;
+	api.rfft_init = rfft_init_q15;
+	api.rfft = rfft_q15;
+	api.abs = abs_q15;
+	return api;
+}
+
+const arm_dsp_api_q15_t * dsp_host_api_q15(){
+	static const arm_dsp_api_q15_t api = create_api_q15();
+	return &api;
+}
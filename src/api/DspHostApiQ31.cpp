@@ -0,0 +1,699 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include "DspHostApi.h"
+
+//The kernels match the CMSIS saturation and rounding for each function
+//(SSE2 doesn't have saturating 32-bit instructions so saturation is done with the sign bits, and
+//32 x 32 bit products need the signed multiply from AVX2)
+
+static inline q31_t mult_keep32(q31_t a, q31_t b){
+	return (q31_t)(((q63_t)a * b) >> 32);
+}
+
+static inline q31_t mult_keep32_round(q31_t a, q31_t b){
+	return (q31_t)(((q63_t)a * b + 0x80000000LL) >> 32);
+}
+
+#if defined __SSE2__
+//a + b saturated: overflow happened if both inputs have a different sign than the result
+static inline __m128i add_sat_q31x4(__m128i a, __m128i b){
+	__m128i sum = _mm_add_epi32(a, b);
+	__m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+	__m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff));
+	return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, sum));
+}
+
+//a - b saturated: overflow happened if the inputs have different signs and the result doesn't have the sign of a
+static inline __m128i sub_sat_q31x4(__m128i a, __m128i b){
+	__m128i difference = _mm_sub_epi32(a, b);
+	__m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, difference)), 31);
+	__m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff));
+	return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, difference));
+}
+
+//negating INT32_MIN gives INT32_MIN, flipping all the bits of those lanes gives INT32_MAX
+static inline __m128i fix_min_q31x4(__m128i value, __m128i input){
+	return _mm_xor_si128(value, _mm_cmpeq_epi32(input, _mm_set1_epi32(INT32_MIN)));
+}
+#endif
+
+#if defined __AVX2__
+//signed 64-bit products of four q31 values (sign extended to 64-bit lanes)
+static inline __m256i mult_q31x4(__m256i a, __m256i b){
+	return _mm256_mul_epi32(a, b);
+}
+
+static inline __m256i load_q31x4(const q31_t * src){
+	return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)src));
+}
+
+//arithmetic shift right of 64-bit lanes (AVX2 only has the logical shift)
+static inline __m256i shift_right_q63x4(__m256i value, int shift){
+	__m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), value);
+	return _mm256_or_si256(_mm256_srli_epi64(value, shift), _mm256_slli_epi64(sign, 64 - shift));
+}
+
+static inline void store_q63x4(q63_t * dest, __m256i value){
+	_mm256_storeu_si256((__m256i*)dest, value);
+}
+#endif
+
+static void abs_q31(q31_t * src, q31_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i sign = _mm_srai_epi32(x, 31);
+		_mm_storeu_si128((__m128i*)(dest + i), fix_min_q31x4(_mm_sub_epi32(_mm_xor_si128(x, sign), sign), x));
+	}
+#endif
+	for(; i < count; i++){
+		q31_t x = src[i];
+		dest[i] = x > 0 ? x : (x == INT32_MIN ? INT32_MAX : -x);
+	}
+}
+
+static void add_q31(q31_t * src_a, q31_t * src_b, q31_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_si128((__m128i*)(dest + i), add_sat_q31x4(_mm_loadu_si128((const __m128i*)(src_a + i)), _mm_loadu_si128((const __m128i*)(src_b + i))));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q31((s64)src_a[i] + src_b[i]);
+	}
+}
+
+static void sub_q31(q31_t * src_a, q31_t * src_b, q31_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_si128((__m128i*)(dest + i), sub_sat_q31x4(_mm_loadu_si128((const __m128i*)(src_a + i)), _mm_loadu_si128((const __m128i*)(src_b + i))));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q31((s64)src_a[i] - src_b[i]);
+	}
+}
+
+static void mult_q31(q31_t * src_a, q31_t * src_b, q31_t * dest, uint32_t count){
+	for(uint32_t i=0; i < count; i++){
+		q31_t out = mult_keep32(src_a[i], src_b[i]);
+		//__SSAT(out, 31)
+		if( out > 0x3fffffff ){ out = 0x3fffffff; }
+		dest[i] = (q31_t)((u32)out << 1);
+	}
+}
+
+static void negate_q31(q31_t * src, q31_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	for(; i + 4 <= count; i += 4){
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dest + i), fix_min_q31x4(_mm_sub_epi32(_mm_setzero_si128(), x), x));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = src[i] == INT32_MIN ? INT32_MAX : -src[i];
+	}
+}
+
+static void offset_q31(q31_t * src, q31_t offset, q31_t * dest, uint32_t count){
+	uint32_t i = 0;
+#if defined __SSE2__
+	__m128i value = _mm_set1_epi32(offset);
+	for(; i + 4 <= count; i += 4){
+		_mm_storeu_si128((__m128i*)(dest + i), add_sat_q31x4(_mm_loadu_si128((const __m128i*)(src + i)), value));
+	}
+#endif
+	for(; i < count; i++){
+		dest[i] = dsp_host_sat_q31((s64)src[i] + offset);
+	}
+}
+
+static void scale_q31(q31_t * src, q31_t scale_fraction, int8_t shift, q31_t * dest, uint32_t count){
+	const int k_shift = shift + 1;
+	for(uint32_t i=0; i < count; i++){
+		q31_t in = mult_keep32(src[i], scale_fraction);
+		if( k_shift >= 0 ){
+			q31_t out = (q31_t)((u32)in << k_shift);
+			if( in != (out >> k_shift) ){
+				out = 0x7fffffff ^ (in >> 31);
+			}
+			dest[i] = out;
+		} else {
+			dest[i] = in >> -k_shift;
+		}
+	}
+}
+
+static void shift_q31(q31_t * src, int8_t shift, q31_t * dest, uint32_t count){
+	for(uint32_t i=0; i < count; i++){
+		q31_t in = src[i];
+		if( shift >= 0 ){
+			q31_t out = (q31_t)((u32)in << shift);
+			if( in != (out >> shift) ){
+				out = 0x7fffffff ^ (in >> 31);
+			}
+			dest[i] = out;
+		} else {
+			dest[i] = in >> -shift;
+		}
+	}
+}
+
+//exact square root of a q31 value -- CMSIS uses an approximation that can differ in the last bit
+static q31_t sqrt_q31(q31_t value){
+	u64 x;
+	u64 root;
+	if( value <= 0 ){
+		return 0;
+	}
+	x = (u64)value << 31;
+	root = (u64)sqrt((double)x);
+	while( root*root > x ){ root--; }
+	while( (root+1)*(root+1) <= x ){ root++; }
+	return root;
+}
+
+static void mean_q31(q31_t * src, uint32_t count, q31_t * result){
+	s64 sum = 0;
+	for(uint32_t i=0; i < count; i++){ sum += src[i]; }
+	*result = (q31_t)(sum / (q63_t)count);
+}
+
+static void power_q31(q31_t * src, uint32_t count, q63_t * result){
+	s64 sum = 0;
+	for(uint32_t i=0; i < count; i++){ sum += ((q63_t)src[i] * src[i]) >> 14; }
+	*result = sum;
+}
+
+static q31_t var_sums_q31(const q31_t * src, uint32_t count){
+	s64 sum = 0;
+	s64 sum_of_squares = 0;
+	for(uint32_t i=0; i < count; i++){
+		q31_t in = src[i] >> 8;
+		sum += in;
+		sum_of_squares += (q63_t)in * in;
+	}
+	q63_t mean_of_squares = sum_of_squares / (q63_t)(count - 1);
+	q63_t square_of_mean = sum * sum / (q63_t)(count * (count - 1));
+	return (q31_t)((mean_of_squares - square_of_mean) >> 15);
+}
+
+static void var_q31(q31_t * src, uint32_t count, q31_t * result){
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	*result = var_sums_q31(src, count);
+}
+
+static void std_q31(q31_t * src, uint32_t count, q31_t * result){
+	if( count <= 1 ){
+		*result = 0;
+		return;
+	}
+	*result = sqrt_q31(var_sums_q31(src, count));
+}
+
+static void rms_q31(q31_t * src, uint32_t count, q31_t * result){
+	u64 sum = 0;
+	for(uint32_t i=0; i < count; i++){ sum += (u64)((q63_t)src[i] * src[i]); }
+	*result = sqrt_q31(dsp_host_sat_q31(((q63_t)sum / (q63_t)count) >> 31));
+}
+
+static void min_q31(q31_t * src, uint32_t count, q31_t * result, uint32_t * index){
+	q31_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] < value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void max_q31(q31_t * src, uint32_t count, q31_t * result, uint32_t * index){
+	q31_t value = src[0];
+	uint32_t idx = 0;
+	for(uint32_t i=1; i < count; i++){
+		if( src[i] > value ){ value = src[i]; idx = i; }
+	}
+	*result = value;
+	*index = idx;
+}
+
+static void dot_prod_q31(q31_t * src_a, q31_t * src_b, uint32_t count, q63_t * result){
+	s64 sum = 0;
+	uint32_t i = 0;
+#if defined __AVX2__
+	__m256i sum4 = _mm256_setzero_si256();
+	q63_t lanes[4];
+	for(; i + 4 <= count; i += 4){
+		sum4 = _mm256_add_epi64(sum4, shift_right_q63x4(mult_q31x4(load_q31x4(src_a + i), load_q31x4(src_b + i)), 14));
+	}
+	store_q63x4(lanes, sum4);
+	sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+	for(; i < count; i++){ sum += ((q63_t)src_a[i] * src_b[i]) >> 14; }
+	*result = sum;
+}
+
+//sum[i] += value * src[i] (the sums wrap like the u64 accumulators of the scalar kernels)
+static inline void multiply_accumulate_q31(q63_t * sum, const q31_t * src, q31_t value, uint32_t count){
+	uint32_t i = 0;
+#if defined __AVX2__
+	__m256i value4 = _mm256_set1_epi64x(value);
+	for(; i + 4 <= count; i += 4){
+		__m256i product = mult_q31x4(value4, load_q31x4(src + i));
+		_mm256_storeu_si256((__m256i*)(sum + i), _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(sum + i)), product));
+	}
+#endif
+	for(; i < count; i++){
+		sum[i] = (q63_t)((u64)sum[i] + (u64)((q63_t)value * src[i]));
+	}
+}
+
+//outputs are accumulated in tiles -- each sample of a adds its products with b to the outputs in the tile
+static void conv_q31(q31_t * src_a, uint32_t a_count, q31_t * src_b, uint32_t b_count, q31_t * dest){
+	const uint32_t total = a_count + b_count - 1;
+	q63_t sum[DSP_HOST_MATRIX_BLOCK];
+
+	for(uint32_t start=0; start < total; start += DSP_HOST_MATRIX_BLOCK){
+		const uint32_t end = total - start < (uint32_t)DSP_HOST_MATRIX_BLOCK ? total : start + DSP_HOST_MATRIX_BLOCK;
+		const uint32_t k_start = start >= b_count - 1 ? start - (b_count - 1) : 0;
+		const uint32_t k_end = end - 1 < a_count - 1 ? end - 1 : a_count - 1;
+
+		memset(sum, 0, sizeof(sum));
+		for(uint32_t k=k_start; k <= k_end; k++){
+			//outputs start..end-1 use b[start-k] to b[end-1-k] (clipped to b)
+			const uint32_t j_start = start > k ? start - k : 0;
+			const uint32_t j_end = end - k < b_count ? end - k : b_count;
+			multiply_accumulate_q31(sum + k + j_start - start, src_b + j_start, src_a[k], j_end - j_start);
+		}
+
+		for(uint32_t n=start; n < end; n++){
+			dest[n] = (q31_t)(sum[n - start] >> 31);
+		}
+	}
+}
+
+//the fast version keeps the upper 32 bits of each product
+static void conv_fast_q31(q31_t * src_a, uint32_t a_count, q31_t * src_b, uint32_t b_count, q31_t * dest){
+	for(uint32_t n=0; n < a_count + b_count - 1; n++){
+		uint32_t k_start = n >= b_count - 1 ? n - (b_count - 1) : 0;
+		uint32_t k_end = n < a_count - 1 ? n : a_count - 1;
+		u32 sum = 0;
+		for(uint32_t k=k_start; k <= k_end; k++){
+			sum += (u32)mult_keep32(src_a[k], src_b[n - k]);
+		}
+		dest[n] = (q31_t)(sum << 1);
+	}
+}
+
+static void fir_init_q31(arm_fir_instance_q31 * instance, uint16_t taps, q31_t * coefficients, q31_t * state, uint32_t count){
+	instance->numTaps = taps;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	memset(state, 0, (taps + count - 1)*sizeof(q31_t));
+}
+
+static void fir_q31(const arm_fir_instance_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	q31_t * state = instance->pState;
+	const q31_t * coefficients = instance->pCoeffs;
+
+	uint32_t n = 0;
+
+	memcpy(state + taps - 1, src, count*sizeof(q31_t));
+#if defined __AVX2__
+	//four consecutive outputs are calculated together
+	for(; n + 4 <= count; n += 4){
+		__m256i sum = _mm256_setzero_si256();
+		q63_t lanes[4];
+		for(uint32_t k=0; k < taps; k++){
+			sum = _mm256_add_epi64(sum, mult_q31x4(_mm256_set1_epi64x(coefficients[k]), load_q31x4(state + n + k)));
+		}
+		store_q63x4(lanes, sum);
+		for(uint32_t i=0; i < 4; i++){
+			dest[n + i] = (q31_t)(lanes[i] >> 31);
+		}
+	}
+#endif
+	for(; n < count; n++){
+		u64 sum = 0;
+		for(uint32_t k=0; k < taps; k++){
+			sum += (u64)((q63_t)coefficients[k] * state[n + k]);
+		}
+		dest[n] = (q31_t)((q63_t)sum >> 31);
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(q31_t));
+}
+
+static void fir_fast_q31(const arm_fir_instance_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	q31_t * state = instance->pState;
+	const q31_t * coefficients = instance->pCoeffs;
+
+	uint32_t n = 0;
+
+	memcpy(state + taps - 1, src, count*sizeof(q31_t));
+#if defined __AVX2__
+	//only the low 32 bits of each sum are kept so the logical shift gives the same result
+	const __m256i round = _mm256_set1_epi64x(0x80000000LL);
+	for(; n + 4 <= count; n += 4){
+		__m256i sum = _mm256_setzero_si256();
+		q63_t lanes[4];
+		for(uint32_t k=0; k < taps; k++){
+			__m256i product = _mm256_add_epi64(mult_q31x4(_mm256_set1_epi64x(coefficients[k]), load_q31x4(state + n + k)), round);
+			sum = _mm256_add_epi64(sum, _mm256_srli_epi64(product, 32));
+		}
+		store_q63x4(lanes, sum);
+		for(uint32_t i=0; i < 4; i++){
+			dest[n + i] = (q31_t)((u32)lanes[i] << 1);
+		}
+	}
+#endif
+	for(; n < count; n++){
+		u32 sum = 0;
+		for(uint32_t k=0; k < taps; k++){
+			sum += (u32)mult_keep32_round(coefficients[k], state[n + k]);
+		}
+		dest[n] = (q31_t)(sum << 1);
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(q31_t));
+}
+
+static arm_status fir_decimate_init_q31(arm_fir_decimate_instance_q31 * instance, uint16_t taps, uint8_t m, q31_t * coefficients, q31_t * state, uint32_t count){
+	if( (m == 0) || (count % m) ){
+		return ARM_MATH_LENGTH_ERROR;
+	}
+	instance->numTaps = taps;
+	instance->M = m;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	memset(state, 0, (taps + count - 1)*sizeof(q31_t));
+	return ARM_MATH_SUCCESS;
+}
+
+static void fir_decimate_fast_q31(const arm_fir_decimate_instance_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	const uint32_t taps = instance->numTaps;
+	const uint32_t m = instance->M;
+	q31_t * state = instance->pState;
+	const q31_t * coefficients = instance->pCoeffs;
+
+	memcpy(state + taps - 1, src, count*sizeof(q31_t));
+	for(uint32_t n=0; n < count / m; n++){
+		u32 sum = 0;
+		for(uint32_t k=0; k < taps; k++){
+			sum += (u32)mult_keep32(coefficients[k], state[n*m + k]);
+		}
+		dest[n] = (q31_t)(sum << 1);
+	}
+	memmove(state, state + count, (taps - 1)*sizeof(q31_t));
+}
+
+static void biquad_cascade_df1_init_q31(arm_biquad_casd_df1_inst_q31 * instance, uint8_t stages, q31_t * coefficients, q31_t * state, int8_t post_shift){
+	instance->numStages = stages;
+	instance->pCoeffs = coefficients;
+	instance->pState = state;
+	instance->postShift = post_shift;
+	memset(state, 0, 4*stages*sizeof(q31_t));
+}
+
+template<bool is_fast> static void biquad_cascade_df1_q31_generic(const arm_biquad_casd_df1_inst_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	const q31_t * coefficients = instance->pCoeffs;
+	q31_t * state = instance->pState;
+	q31_t * input = src;
+	const int shift = instance->postShift + 1;
+	//history holds x[n-2], x[n-1] then a block of input
+	q31_t history[DSP_HOST_BIQUAD_BLOCK + 2];
+	u64 feed_forward[DSP_HOST_BIQUAD_BLOCK];
+
+	for(uint32_t stage=0; stage < instance->numStages; stage++){
+		//coefficients are {b0, b1, b2, a1, a2}
+		const q31_t b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2];
+		const q31_t a1 = coefficients[3], a2 = coefficients[4];
+		q31_t y1 = state[2], y2 = state[3];
+		history[0] = state[1];
+		history[1] = state[0];
+		for(uint32_t block=0; block < count; block += DSP_HOST_BIQUAD_BLOCK){
+			const uint32_t length = count - block < (uint32_t)DSP_HOST_BIQUAD_BLOCK ? count - block : (uint32_t)DSP_HOST_BIQUAD_BLOCK;
+			uint32_t n = 0;
+
+			//the input is copied first so dest can be the same as input
+			memcpy(history + 2, input + block, length*sizeof(q31_t));
+
+			//the feed forward terms don't depend on the output so they are vectorized (the sums wrap like the scalar u64 and u32 sums)
+#if defined __AVX2__
+			const __m256i b0_4 = _mm256_set1_epi64x(b0), b1_4 = _mm256_set1_epi64x(b1), b2_4 = _mm256_set1_epi64x(b2);
+			const __m256i round = _mm256_set1_epi64x(0x80000000LL);
+			for(; n + 4 <= length; n += 4){
+				__m256i p0 = mult_q31x4(b0_4, load_q31x4(history + n + 2));
+				__m256i p1 = mult_q31x4(b1_4, load_q31x4(history + n + 1));
+				__m256i p2 = mult_q31x4(b2_4, load_q31x4(history + n));
+				if( is_fast ){
+					p0 = _mm256_srli_epi64(_mm256_add_epi64(p0, round), 32);
+					p1 = _mm256_srli_epi64(_mm256_add_epi64(p1, round), 32);
+					p2 = _mm256_srli_epi64(_mm256_add_epi64(p2, round), 32);
+				}
+				_mm256_storeu_si256((__m256i*)(feed_forward + n), _mm256_add_epi64(_mm256_add_epi64(p0, p1), p2));
+			}
+#endif
+			for(; n < length; n++){
+				const q31_t x0 = history[n + 2], x1 = history[n + 1], x2 = history[n];
+				if( is_fast ){
+					feed_forward[n] = (u32)mult_keep32_round(b0, x0) + (u32)mult_keep32_round(b1, x1) + (u32)mult_keep32_round(b2, x2);
+				} else {
+					feed_forward[n] = (u64)((q63_t)b0*x0) + (u64)((q63_t)b1*x1) + (u64)((q63_t)b2*x2);
+				}
+			}
+
+			for(n=0; n < length; n++){
+				q31_t y0;
+				if( is_fast ){
+					u32 acc = (u32)feed_forward[n] + (u32)mult_keep32_round(a1, y1) + (u32)mult_keep32_round(a2, y2);
+					y0 = (q31_t)(acc << shift);
+				} else {
+					u64 acc = feed_forward[n] + (u64)((q63_t)a1*y1) + (u64)((q63_t)a2*y2);
+					y0 = (q31_t)((q63_t)acc >> (32 - shift));
+				}
+				y2 = y1; y1 = y0;
+				dest[block + n] = y0;
+			}
+
+			history[0] = history[length];
+			history[1] = history[length + 1];
+		}
+		state[0] = history[1]; state[1] = history[0]; state[2] = y1; state[3] = y2;
+		state += 4;
+		coefficients += 5;
+		input = dest;
+	}
+}
+
+static void biquad_cascade_df1_q31(const arm_biquad_casd_df1_inst_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	biquad_cascade_df1_q31_generic<false>(instance, src, dest, count);
+}
+
+static void biquad_cascade_df1_fast_q31(const arm_biquad_casd_df1_inst_q31 * instance, q31_t * src, q31_t * dest, uint32_t count){
+	biquad_cascade_df1_q31_generic<true>(instance, src, dest, count);
+}
+
+static void mat_init_q31(arm_matrix_instance_q31 * instance, uint16_t rows, uint16_t columns, q31_t * data){
+	instance->numRows = rows;
+	instance->numCols = columns;
+	instance->pData = data;
+}
+
+static arm_status mat_add_q31(const arm_matrix_instance_q31 * a, const arm_matrix_instance_q31 * b, arm_matrix_instance_q31 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	add_q31(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_sub_q31(const arm_matrix_instance_q31 * a, const arm_matrix_instance_q31 * b, arm_matrix_instance_q31 * dest){
+	if( (a->numRows != b->numRows) || (a->numCols != b->numCols) || (a->numRows != dest->numRows) || (a->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	sub_q31(a->pData, b->pData, dest->pData, (uint32_t)a->numRows*a->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_mult_q31(const arm_matrix_instance_q31 * a, const arm_matrix_instance_q31 * b, arm_matrix_instance_q31 * dest){
+	const u32 rows = a->numRows;
+	const u32 inner = a->numCols;
+	const u32 columns = b->numCols;
+	q63_t sum[DSP_HOST_MATRIX_BLOCK];
+	u32 i, j, k, jj;
+
+	if( !dsp_host_mat_mult_check(a, b, dest) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+
+	//one tile of columns is accumulated at a time so each row of b is read sequentially
+	for(jj=0; jj < columns; jj += DSP_HOST_MATRIX_BLOCK){
+		u32 width = columns - jj < (u32)DSP_HOST_MATRIX_BLOCK ? columns - jj : (u32)DSP_HOST_MATRIX_BLOCK;
+		for(i=0; i < rows; i++){
+			const q31_t * row = a->pData + i*inner;
+			memset(sum, 0, sizeof(sum));
+			for(k=0; k < inner; k++){
+				multiply_accumulate_q31(sum, b->pData + k*columns + jj, row[k], width);
+			}
+			//CMSIS truncates without saturating
+			for(j=0; j < width; j++){
+				dest->pData[i*columns + jj + j] = (q31_t)(sum[j] >> 31);
+			}
+		}
+	}
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_trans_q31(const arm_matrix_instance_q31 * src, arm_matrix_instance_q31 * dest){
+	if( (src->numRows != dest->numCols) || (src->numCols != dest->numRows) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	dsp_host_mat_trans(src->pData, src->numRows, src->numCols, dest->pData);
+	return ARM_MATH_SUCCESS;
+}
+
+static arm_status mat_scale_q31(const arm_matrix_instance_q31 * src, q31_t scale_fraction, int32_t shift, arm_matrix_instance_q31 * dest){
+	if( (src->numRows != dest->numRows) || (src->numCols != dest->numCols) ){
+		return ARM_MATH_SIZE_MISMATCH;
+	}
+	scale_q31(src->pData, scale_fraction, shift, dest->pData, (uint32_t)src->numRows*src->numCols);
+	return ARM_MATH_SUCCESS;
+}
+
+static q31_t sin_q31(q31_t x){
+	//the full q31 range maps to one period
+	double theta = 2.0 * M_PI * (double)(u32)x / 4294967296.0;
+	return dsp_host_sat_q31((s64)lrint(sin(theta) * 2147483648.0));
+}
+
+static q31_t round_q31(double value){
+	return dsp_host_sat_q31((s64)llrint(value));
+}
+
+//fixed point FFTs use double precision internally and scale the output like CMSIS (not bit exact)
+static void cfft_q31(const arm_cfft_instance_q31 * instance, q31_t * data, uint8_t is_inverse, uint8_t is_bit_reversal){
+	const uint32_t n = instance->fftLen;
+	double * buffer = dsp_host_work_buffer(2*n);
+	if( buffer == 0 ){
+		return;
+	}
+	for(uint32_t i=0; i < 2*n; i++){ buffer[i] = data[i]; }
+	dsp_host_cfft(buffer, n, is_inverse != 0);
+	if( is_bit_reversal == 0 ){
+		dsp_host_bit_reverse(buffer, n);
+	}
+	//output is scaled by 1/n in both directions
+	for(uint32_t i=0; i < 2*n; i++){ data[i] = round_q31(buffer[i] / n); }
+}
+
+static arm_cfft_instance_q31 m_cfft_q31[DSP_HOST_FFT_MAX_LOG2+1];
+
+static arm_status rfft_init_q31(arm_rfft_instance_q31 * instance, uint32_t n, uint32_t is_inverse, uint32_t is_bit_reversal){
+	int log2n = dsp_host_fft_log2(n);
+	if( (n < 32) || (log2n < 0) || (dsp_host_twiddle(n) == 0) ){
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	memset(instance, 0, sizeof(arm_rfft_instance_q31));
+	instance->fftLenReal = n;
+	instance->ifftFlagR = is_inverse;
+	instance->bitReverseFlagR = is_bit_reversal;
+	instance->twidCoefRModifier = 8192U / n;
+	m_cfft_q31[log2n-1].fftLen = n/2;
+	instance->pCfft = m_cfft_q31 + log2n - 1;
+	return ARM_MATH_SUCCESS;
+}
+
+//forward output is the full spectrum (n complex values) scaled by 1/n, the inverse uses the first n/2+1 complex values
+static void rfft_q31(const arm_rfft_instance_q31 * instance, q31_t * src, q31_t * dest){
+	const uint32_t n = instance->fftLenReal;
+	const uint32_t half = n/2;
+	double * input = dsp_host_work_buffer(2*n);
+	double * output = input + n;
+
+	if( input == 0 ){
+		return;
+	}
+
+	if( instance->ifftFlagR ){
+		input[0] = src[0];
+		input[1] = src[2*half];
+		for(uint32_t k=1; k < half; k++){
+			input[2*k] = src[2*k];
+			input[2*k+1] = src[2*k+1];
+		}
+		dsp_host_rifft(input, output, n);
+		//a forward then inverse transform returns the input scaled by 1/n
+		for(uint32_t k=0; k < n; k++){ dest[k] = round_q31(output[k]); }
+	} else {
+		for(uint32_t k=0; k < n; k++){ input[k] = src[k]; }
+		dsp_host_rfft(input, output, n);
+		dest[0] = round_q31(output[0] / n);
+		dest[1] = 0;
+		dest[2*half] = round_q31(output[1] / n);
+		dest[2*half+1] = 0;
+		for(uint32_t k=1; k < half; k++){
+			q31_t re = round_q31(output[2*k] / n);
+			q31_t im = round_q31(output[2*k+1] / n);
+			dest[2*k] = re;
+			dest[2*k+1] = im;
+			dest[2*(n-k)] = re;
+			dest[2*(n-k)+1] = dsp_host_sat_q31(-(s64)im);
+		}
+	}
+}
+
+static arm_dsp_api_q31_t create_api_q31(){
+	arm_dsp_api_q31_t api;
+	memset(&api, 0, sizeof(api));
+	api.mean = mean_q31;
+	api.power = power_q31;
+	api.var = var_q31;
+	api.rms = rms_q31;
+	api.std = std_q31;
+	api.min = min_q31;
+	api.max = max_q31;
+	api.dot_prod = dot_prod_q31;
+	api.add = add_q31;
+	api.sub = sub_q31;
+	api.mult = mult_q31;
+	api.negate = negate_q31;
+	api.offset = offset_q31;
+	api.scale = scale_q31;
+	api.shift = shift_q31;
+	api.conv = conv_q31;
+	api.conv_fast = conv_fast_q31;
+	api.fir_init = fir_init_q31;
+	api.fir = fir_q31;
+	api.fir_fast = fir_fast_q31;
+	api.fir_decimate_init = fir_decimate_init_q31;
+	api.fir_decimate_fast = fir_decimate_fast_q31;
+	api.biquad_cascade_df1_init = biquad_cascade_df1_init_q31;
+	api.biquad_cascade_df1 = biquad_cascade_df1_q31;
+	api.biquad_cascade_df1_fast = biquad_cascade_df1_fast_q31;
+	api.mat_init = mat_init_q31;
+	api.mat_add = mat_add_q31;
+	api.mat_sub = mat_sub_q31;
+	api.mat_mult = mat_mult_q31;
+	api.mat_trans = mat_trans_q31;
+	api.mat_scale = mat_scale_q31;
+	api.sin = sin_q31;
+	api.cfft = cfft_q31;
+	api.rfft_init = rfft_init_q31;
+	api.rfft = rfft_q31;
+	api.abs = abs_q31;
+	return api;
+}
+
+const arm_dsp_api_q31_t * dsp_host_api_q31(){
+	static const arm_dsp_api_q31_t api = create_api_q31();
+	return &api;
+}
@@ -11,6 +11,7 @@ const arm_dsp_api_f32_t * DspWorkObject::m_arm_dsp_api_f32;
 const arm_dsp_conversion_api_t * DspWorkObject::m_arm_dsp_conversion_api;
 
 
+#if !defined __link
 int DspWorkObject::request_arm_dsp_api(){
     sapi_request_arm_dsp_api_t api_request;
     int ret = Sys::request(SAPI_REQUEST_ARM_DSP_API, &api_request);
@@ -23,3 +24,15 @@ int DspWorkObject::request_arm_dsp_api(){
     }
     return ret;
 }
+#else
+#include "DspHostApi.h"
+
+//link builds use the host implementation of the tables
+int DspWorkObject::request_arm_dsp_api(){
+    m_arm_dsp_api_q15 = dsp_host_api_q15();
+    m_arm_dsp_api_q31 = dsp_host_api_q31();
+    m_arm_dsp_api_f32 = dsp_host_api_f32();
+    return 0;
+}
+#endif
+
@@ -0,0 +1,369 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+#include "SgfxHostApi.h"
+
+namespace {
+
+enum {
+	HOST_OP_SOLID,
+	HOST_OP_BLEND,
+	HOST_OP_INVERT,
+	HOST_OP_ERASE,
+	HOST_OP_TOTAL
+};
+
+const sg_api_t * reference_api;
+u32 host_bits_per_pixel;
+
+//returns the operation for the pen or -1 if the reference should be used
+int host_op(const sg_pen_t & pen){
+	switch( pen.o_flags & ~SG_PEN_FLAG_IS_FILL ){
+	case 0:
+	case SG_PEN_FLAG_IS_SOLID: return HOST_OP_SOLID;
+	case SG_PEN_FLAG_IS_BLEND: return HOST_OP_BLEND;
+	case SG_PEN_FLAG_IS_INVERT: return HOST_OP_INVERT;
+	case SG_PEN_FLAG_IS_ERASE: return HOST_OP_ERASE;
+	}
+	return -1;
+}
+
+//the pen color repeated for each pixel in a word
+u32 host_color_word(sg_color_t color){
+	u32 mask;
+	u32 value;
+	u32 i;
+	if( host_bits_per_pixel == 32 ){
+		return color;
+	}
+	mask = (1UL << host_bits_per_pixel) - 1;
+	value = 0;
+	for(i=0; i < 32; i += host_bits_per_pixel){
+		value |= (color & mask) << i;
+	}
+	return value;
+}
+
+inline u32 host_combine(int op, u32 dest, u32 value, u32 mask){
+	u32 result;
+	switch(op){
+	case HOST_OP_BLEND: result = dest | value; break;
+	case HOST_OP_INVERT: result = dest ^ value; break;
+	case HOST_OP_ERASE: result = dest & ~value; break;
+	default: result = value; break;
+	}
+	return (dest & ~mask) | (result & mask);
+}
+
+//mask of bits [first, last) within a word
+inline u32 host_mask(u32 first, u32 last){
+	u32 mask = 0xffffffff << first;
+	if( last < 32 ){
+		mask &= (1UL << last) - 1;
+	}
+	return mask;
+}
+
+//the 32 source bits that start at bit \a offset (negative offsets read zeros)
+inline u32 host_fetch(const sg_bmap_data_t * src, u32 src_words, s32 offset){
+	u32 word;
+	u32 shift;
+	u32 value;
+	if( offset < 0 ){
+		return src[0] << -offset;
+	}
+	word = offset >> 5;
+	shift = offset & 31;
+	value = src[word] >> shift;
+	if( shift && (word + 1 < src_words) ){
+		value |= src[word+1] << (32 - shift);
+	}
+	return value;
+}
+
+#if defined __SSE2__
+inline __m128i host_combine(int op, __m128i dest, __m128i value){
+	switch(op){
+	case HOST_OP_BLEND: return _mm_or_si128(dest, value);
+	case HOST_OP_INVERT: return _mm_xor_si128(dest, value);
+	case HOST_OP_ERASE: return _mm_andnot_si128(value, dest);
+	}
+	return value;
+}
+#endif
+
+#if defined __AVX2__
+inline __m256i host_combine(int op, __m256i dest, __m256i value){
+	switch(op){
+	case HOST_OP_BLEND: return _mm256_or_si256(dest, value);
+	case HOST_OP_INVERT: return _mm256_xor_si256(dest, value);
+	case HOST_OP_ERASE: return _mm256_andnot_si256(value, dest);
+	}
+	return value;
+}
+#endif
+
+//applies \a value to \a bits bits of \a dest starting at \a dest_bit
+void host_fill_bits(sg_bmap_data_t * dest, u32 dest_bit, u32 bits, u32 value, int op){
+	u32 end = dest_bit + bits;
+	u32 i = dest_bit >> 5;
+	u32 last = (end - 1) >> 5;
+
+	if( bits == 0 ){
+		return;
+	}
+
+	if( i == last ){
+		dest[i] = host_combine(op, dest[i], value, host_mask(dest_bit & 31, end - i*32));
+		return;
+	}
+
+	if( dest_bit & 31 ){
+		dest[i] = host_combine(op, dest[i], value, host_mask(dest_bit & 31, 32));
+		i++;
+	}
+
+	//whole words
+#if defined __AVX2__
+	{
+		__m256i v = _mm256_set1_epi32(value);
+		for(; i + 8 <= last; i += 8){
+			__m256i d = _mm256_loadu_si256((const __m256i*)(dest + i));
+			_mm256_storeu_si256((__m256i*)(dest + i), host_combine(op, d, v));
+		}
+	}
+#endif
+#if defined __SSE2__
+	{
+		__m128i v = _mm_set1_epi32(value);
+		for(; i + 4 <= last; i += 4){
+			__m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+			_mm_storeu_si128((__m128i*)(dest + i), host_combine(op, d, v));
+		}
+	}
+#endif
+	for(; i < last; i++){
+		dest[i] = host_combine(op, dest[i], value, 0xffffffff);
+	}
+
+	dest[last] = host_combine(op, dest[last], value, host_mask(0, end - last*32));
+}
+
+//applies \a bits bits of \a src starting at \a src_bit to \a dest starting at \a dest_bit
+void host_blit_bits(sg_bmap_data_t * dest, u32 dest_bit, const sg_bmap_data_t * src, u32 src_bit, u32 src_words, u32 bits, int op){
+	u32 end = dest_bit + bits;
+	u32 i = dest_bit >> 5;
+	u32 last = (end - 1) >> 5;
+	//source bit for bit zero of dest[i]
+	s32 offset = (s32)src_bit - (s32)(dest_bit & 31);
+
+	if( bits == 0 ){
+		return;
+	}
+
+	if( i == last ){
+		dest[i] = host_combine(op, dest[i], host_fetch(src, src_words, offset), host_mask(dest_bit & 31, end - i*32));
+		return;
+	}
+
+	if( dest_bit & 31 ){
+		dest[i] = host_combine(op, dest[i], host_fetch(src, src_words, offset), host_mask(dest_bit & 31, 32));
+		i++;
+		offset += 32;
+	}
+
+#if defined __SSE2__
+	//whole words -- each is made from two neighboring source words
+	{
+		u32 j = offset >> 5;
+		u32 shift = offset & 31;
+#if defined __AVX2__
+		{
+			__m128i right = _mm_cvtsi32_si128(shift);
+			__m128i left = _mm_cvtsi32_si128(32 - shift); //zero when shift is zero
+			for(; (i + 8 <= last) && (j + 8 < src_words); i += 8, j += 8, offset += 256){
+				__m256i a = _mm256_loadu_si256((const __m256i*)(src + j));
+				__m256i b = _mm256_loadu_si256((const __m256i*)(src + j + 1));
+				__m256i v = _mm256_or_si256(_mm256_srl_epi32(a, right), _mm256_sll_epi32(b, left));
+				__m256i d = _mm256_loadu_si256((const __m256i*)(dest + i));
+				_mm256_storeu_si256((__m256i*)(dest + i), host_combine(op, d, v));
+			}
+		}
+#endif
+#if defined __SSE2__
+		{
+			__m128i right = _mm_cvtsi32_si128(shift);
+			__m128i left = _mm_cvtsi32_si128(32 - shift);
+			for(; (i + 4 <= last) && (j + 4 < src_words); i += 4, j += 4, offset += 128){
+				__m128i a = _mm_loadu_si128((const __m128i*)(src + j));
+				__m128i b = _mm_loadu_si128((const __m128i*)(src + j + 1));
+				__m128i v = _mm_or_si128(_mm_srl_epi32(a, right), _mm_sll_epi32(b, left));
+				__m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+				_mm_storeu_si128((__m128i*)(dest + i), host_combine(op, d, v));
+			}
+		}
+#endif
+	}
+#endif
+
+	for(; i < last; i++, offset += 32){
+		dest[i] = host_combine(op, dest[i], host_fetch(src, src_words, offset), 0xffffffff);
+	}
+
+	dest[last] = host_combine(op, dest[last], host_fetch(src, src_words, offset), host_mask(0, end - last*32));
+}
+
+//clips \a region to \a bmap -- returns false if nothing is left
+bool host_clip(const sg_bmap_t * bmap, const sg_region_t * region, s32 & x0, s32 & y0, s32 & x1, s32 & y1){
+	x0 = region->point.x < 0 ? 0 : region->point.x;
+	y0 = region->point.y < 0 ? 0 : region->point.y;
+	x1 = region->point.x + region->dim.width;
+	y1 = region->point.y + region->dim.height;
+	if( x1 > bmap->dim.width ){ x1 = bmap->dim.width; }
+	if( y1 > bmap->dim.height ){ y1 = bmap->dim.height; }
+	return (x0 < x1) && (y0 < y1);
+}
+
+void host_draw_rectangle(const sg_bmap_t * bmap, const sg_region_t * region){
+	int op = host_op(bmap->pen);
+	u32 value;
+	s32 x0, y0, x1, y1;
+	s32 y;
+
+	if( op < 0 ){
+		reference_api->draw_rectangle(bmap, region);
+		return;
+	}
+
+	if( host_clip(bmap, region, x0, y0, x1, y1) == false ){
+		return;
+	}
+
+	value = host_color_word(bmap->pen.color);
+	for(y=y0; y < y1; y++){
+		host_fill_bits(bmap->data + y*bmap->columns, x0*host_bits_per_pixel, (x1 - x0)*host_bits_per_pixel, value, op);
+	}
+}
+
+void host_draw_pattern(const sg_bmap_t * bmap, const sg_region_t * region, sg_bmap_data_t odd_pattern, sg_bmap_data_t even_pattern, sg_size_t pattern_height){
+	int op = host_op(bmap->pen);
+	s32 x0, y0, x1, y1;
+	s32 y;
+
+	if( (op < 0) || (pattern_height == 0) ){
+		reference_api->draw_pattern(bmap, region, odd_pattern, even_pattern, pattern_height);
+		return;
+	}
+
+	if( host_clip(bmap, region, x0, y0, x1, y1) == false ){
+		return;
+	}
+
+	for(y=y0; y < y1; y++){
+		u32 value = (((y - region->point.y) / pattern_height) & 1) ? even_pattern : odd_pattern;
+		host_fill_bits(bmap->data + y*bmap->columns, x0*host_bits_per_pixel, (x1 - x0)*host_bits_per_pixel, value, op);
+	}
+}
+
+void host_draw_sub_bitmap(const sg_bmap_t * bmap_dest, sg_point_t p_dest, const sg_bmap_t * bmap_src, const sg_region_t * region_src){
+	int op = host_op(bmap_dest->pen);
+	s32 sx = region_src->point.x;
+	s32 sy = region_src->point.y;
+	s32 w = region_src->dim.width;
+	s32 h = region_src->dim.height;
+	s32 dx = p_dest.x;
+	s32 dy = p_dest.y;
+	s32 y;
+
+	//the same memory would have to be copied in the right order
+	if( (op < 0) || (bmap_dest->data == bmap_src->data) ){
+		reference_api->draw_sub_bitmap(bmap_dest, p_dest, bmap_src, region_src);
+		return;
+	}
+
+	//clip to the source
+	if( sx < 0 ){ w += sx; dx -= sx; sx = 0; }
+	if( sy < 0 ){ h += sy; dy -= sy; sy = 0; }
+	if( sx + w > bmap_src->dim.width ){ w = bmap_src->dim.width - sx; }
+	if( sy + h > bmap_src->dim.height ){ h = bmap_src->dim.height - sy; }
+
+	//clip to the destination
+	if( dx < 0 ){ w += dx; sx -= dx; dx = 0; }
+	if( dy < 0 ){ h += dy; sy -= dy; dy = 0; }
+	if( dx + w > bmap_dest->dim.width ){ w = bmap_dest->dim.width - dx; }
+	if( dy + h > bmap_dest->dim.height ){ h = bmap_dest->dim.height - dy; }
+
+	if( (w <= 0) || (h <= 0) ){
+		return;
+	}
+
+	for(y=0; y < h; y++){
+		host_blit_bits(bmap_dest->data + (dy + y)*bmap_dest->columns, dx*host_bits_per_pixel,
+				bmap_src->data + (sy + y)*bmap_src->columns, sx*host_bits_per_pixel, bmap_src->columns,
+				w*host_bits_per_pixel, op);
+	}
+}
+
+void host_draw_bitmap(const sg_bmap_t * bmap_dest, sg_point_t p_dest, const sg_bmap_t * bmap_src){
+	sg_region_t region;
+	if( (host_op(bmap_dest->pen) < 0) || (bmap_dest->data == bmap_src->data) ){
+		reference_api->draw_bitmap(bmap_dest, p_dest, bmap_src);
+		return;
+	}
+	region.point.x = 0;
+	region.point.y = 0;
+	region.dim = bmap_src->dim;
+	host_draw_sub_bitmap(bmap_dest, p_dest, bmap_src, &region);
+}
+
+void host_cursor_draw_hline(sg_cursor_t * cursor, sg_size_t width){
+	int op = host_op(cursor->bmap->pen);
+	u32 end;
+
+	if( op < 0 ){
+		reference_api->cursor_draw_hline(cursor, width);
+		return;
+	}
+
+	host_fill_bits(cursor->target, cursor->shift, width*host_bits_per_pixel, host_color_word(cursor->bmap->pen.color), op);
+
+	//the cursor ends on the pixel after the line
+	end = cursor->shift + width*host_bits_per_pixel;
+	cursor->target += end >> 5;
+	cursor->shift = end & 31;
+}
+
+sg_api_t create_host_api(){
+	sg_api_t api;
+
+	reference_api = sg_api();
+	host_bits_per_pixel = reference_api->bits_per_pixel;
+	api = *reference_api;
+
+	//the host functions match the reference bit for bit (see test::SgfxHostApiTest)
+	switch(host_bits_per_pixel){
+	case 1: case 2: case 4: case 8: case 16: case 32:
+		api.draw_rectangle = host_draw_rectangle;
+		api.draw_pattern = host_draw_pattern;
+		api.draw_bitmap = host_draw_bitmap;
+		api.draw_sub_bitmap = host_draw_sub_bitmap;
+		api.cursor_draw_hline = host_cursor_draw_hline;
+		break;
+	}
+	return api;
+}
+
+}
+
+const sg_api_t * sgfx_host_api(){
+	//built once (thread safe) on the first request
+	static const sg_api_t api = create_host_api();
+	return &api;
+}
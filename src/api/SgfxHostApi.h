@@ -0,0 +1,14 @@
+#ifndef SGFX_HOST_API_H_
+#define SGFX_HOST_API_H_
+
+//Host implementation of the sg_api blit and fill functions (installed by
+//api::SgfxObject::request_sgfx_api() on link builds)
+
+#include "api/SgfxObject.hpp"
+
+//returns a copy of sg_api() with draw_bitmap(), draw_sub_bitmap(), draw_rectangle(),
+//draw_pattern() and cursor_draw_hline() replaced by word-level versions (for 1, 2, 4, 8, 16
+//and 32 bits per pixel) -- test::SgfxHostApiTest compares them with sg_api()
+const sg_api_t * sgfx_host_api();
+
+#endif /* SGFX_HOST_API_H_ */
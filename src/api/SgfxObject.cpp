@@ -0,0 +1,21 @@
+#include "api/SgfxObject.hpp"
+
+using namespace api;
+
+const sg_api_t * SgfxObject::m_sgfx_api;
+
+#if !defined __link
+int SgfxObject::request_sgfx_api(){
+	//the kernel provides the only implementation
+	m_sgfx_api = 0;
+	return 0;
+}
+#else
+#include "SgfxHostApi.h"
+
+//link builds use the host implementation of the blit and fill functions
+int SgfxObject::request_sgfx_api(){
+	m_sgfx_api = sgfx_host_api();
+	return 0;
+}
+#endif
@@ -0,0 +1,542 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include <errno.h>
+#include "calc/Lz.hpp"
+using namespace calc;
+
+Lz::Lz(){}
+
+static inline u32 read32(const u8 * p){
+	u32 value;
+	memcpy(&value, p, sizeof(u32));
+	return value;
+}
+
+static inline u32 hash32(u32 value){
+	return (u32)(value * 2654435761UL) >> (32 - Lz::HASH_BITS);
+}
+
+//counts the number of bytes that are the same (up to limit) comparing a word at a time
+static int calc_match_length(const u8 * a, const u8 * b, int limit){
+	int len = 0;
+	u32 diff;
+	while( len + (int)sizeof(u32) <= limit ){
+		diff = read32(a + len) ^ read32(b + len);
+		if( diff ){
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			return len + __builtin_clz(diff) / 8;
+#else
+			return len + __builtin_ctz(diff) / 8;
+#endif
+		}
+		len += sizeof(u32);
+	}
+	while( (len < limit) && (a[len] == b[len]) ){
+		len++;
+	}
+	return len;
+}
+
+//writes a length that doesn't fit in the token as a series of bytes
+static u8 * write_length(u8 * dest, u32 len){
+	while( len >= 255 ){
+		*dest++ = 255;
+		len -= 255;
+	}
+	*dest++ = len;
+	return dest;
+}
+
+static const u8 * read_length(const u8 * src, const u8 * end, u32 & len){
+	u8 value;
+	do {
+		if( src >= end ){
+			return 0;
+		}
+		value = *src++;
+		len += value;
+	} while( value == 255 );
+	return src;
+}
+
+static u8 * write_sequence(u8 * dest, const u8 * dest_end, const u8 * literals, u32 literal_count, u32 offset, u32 match_length){
+	u8 * token;
+	//worst case size of the sequence
+	if( (s32)(literal_count + literal_count / 255 + 8) > dest_end - dest ){
+		return 0;
+	}
+
+	token = dest++;
+	if( literal_count >= 15 ){
+		*token = 15<<4;
+		dest = write_length(dest, literal_count - 15);
+	} else {
+		*token = literal_count<<4;
+	}
+
+	memcpy(dest, literals, literal_count);
+	dest += literal_count;
+
+	if( match_length ){
+		*dest++ = offset & 0xff;
+		*dest++ = offset >> 8;
+		match_length -= Lz::MIN_MATCH;
+		if( match_length >= 15 ){
+			*token |= 15;
+			if( (s32)(match_length / 255 + 1) > dest_end - dest ){
+				return 0;
+			}
+			dest = write_length(dest, match_length - 15);
+		} else {
+			*token |= match_length;
+		}
+	}
+
+	return dest;
+}
+
+int Lz::encode_block(u8 * dest, s32 & dest_size, const u8 * src, s32 src_size, const u8 * dictionary, s32 dictionary_size, u16 * table){
+	s32 i;
+	s32 anchor;
+	s32 limit;
+	u32 pos;
+	u32 delta;
+	u32 step;
+	u32 value;
+	u32 h;
+	s32 candidate;
+	s32 len;
+	const u8 * match;
+	u8 * d = dest;
+	const u8 * d_end = dest + dest_size;
+
+	//positions are offsets from the start of the dictionary, the table holds the low 16 bits
+	memset(table, 0xff, HASH_SIZE*sizeof(u16));
+	i = dictionary_size > MAX_OFFSET ? dictionary_size - MAX_OFFSET : 0;
+	for(; i + MIN_MATCH <= dictionary_size; i++){
+		table[hash32(read32(dictionary + i))] = i;
+	}
+
+	anchor = 0;
+	i = 0;
+	step = 1 << 5;
+	while( i + MIN_MATCH <= src_size ){
+		value = read32(src + i);
+		h = hash32(value);
+		pos = dictionary_size + i;
+		delta = (u16)(pos - table[h]);
+		table[h] = pos;
+		candidate = (s32)pos - (s32)delta;
+
+		len = 0;
+		if( delta && (candidate >= 0) ){
+			if( candidate < dictionary_size ){
+				//matches in the dictionary stop at the end of the dictionary
+				match = dictionary + candidate;
+				limit = dictionary_size - candidate;
+				if( limit > src_size - i ){ limit = src_size - i; }
+			} else {
+				match = src + candidate - dictionary_size;
+				limit = src_size - i;
+			}
+
+			if( (limit >= MIN_MATCH) && (read32(match) == value) ){
+				len = MIN_MATCH + calc_match_length(match + MIN_MATCH, src + i + MIN_MATCH, limit - MIN_MATCH);
+			}
+		}
+
+		if( len ){
+			d = write_sequence(d, d_end, src + anchor, i - anchor, delta, len);
+			if( d == 0 ){
+				return -1;
+			}
+			i += len;
+			anchor = i;
+			step = 1 << 5;
+			//index the end of the match so that the next match can start there
+			if( i + MIN_MATCH <= src_size ){
+				table[hash32(read32(src + i - 2))] = dictionary_size + i - 2;
+			}
+		} else {
+			//skip ahead faster when the data isn't compressing
+			i += step >> 5;
+			step++;
+		}
+	}
+
+	//the last sequence only has literals
+	d = write_sequence(d, d_end, src + anchor, src_size - anchor, 0, 0);
+	if( d == 0 ){
+		return -1;
+	}
+
+	dest_size = d - dest;
+	return src_size;
+}
+
+int Lz::encode(void * dest, s32 & dest_size, const void * src, s32 src_size, const void * dictionary, s32 dictionary_size){
+	int ret;
+	var::Data table;
+
+	if( src_size <= 0 ){
+		dest_size = 0;
+		return 0;
+	}
+
+	if( dictionary == 0 ){
+		dictionary_size = 0;
+	}
+
+	if( table.alloc(HASH_SIZE*sizeof(u16)) < 0 ){
+		return -1;
+	}
+
+	ret = encode_block((u8*)dest, dest_size, (const u8*)src, src_size, (const u8*)dictionary, dictionary_size, (u16*)table.data());
+	if( ret < 0 ){
+		dest_size = 0;
+	}
+	return ret;
+}
+
+int Lz::encode(var::Data & dest, const var::Data & src, const var::Data & dictionary){
+	s32 dest_size;
+
+	dest_size = calc_max_size(src.capacity());
+	if( (dest.set_capacity(dest_size) < 0) || (dest.data() == 0) ){
+		return -1;
+	}
+
+	if( encode(dest.data(), dest_size, src.data_const(), src.capacity(), dictionary.data_const(), dictionary.capacity()) < 0 ){
+		return -1;
+	}
+
+	return dest_size;
+}
+
+int Lz::calc_decoded_size(const void * src, int nbyte){
+	const u8 * s = (const u8 *)src;
+	const u8 * s_end = s + nbyte;
+	u32 token;
+	u32 len;
+	int size = 0;
+
+	while( s < s_end ){
+		token = *s++;
+		len = token >> 4;
+		if( (len == 15) && ((s = read_length(s, s_end, len)) == 0) ){
+			return -1;
+		}
+		if( (s32)len > s_end - s ){
+			return -1;
+		}
+		s += len;
+		size += len;
+
+		if( s == s_end ){
+			break;
+		}
+
+		if( s_end - s < 2 ){
+			return -1;
+		}
+		s += 2;
+
+		len = token & 0x0f;
+		if( (len == 15) && ((s = read_length(s, s_end, len)) == 0) ){
+			return -1;
+		}
+		size += len + MIN_MATCH;
+	}
+
+	return size;
+}
+
+int Lz::decode(void * dest, s32 & dest_size, const void * src, s32 src_size, const void * dictionary, s32 dictionary_size){
+	const u8 * s = (const u8 *)src;
+	const u8 * s_end = s + src_size;
+	u8 * d = (u8*)dest;
+	u8 * d_end = d + dest_size;
+	const u8 * match;
+	u32 token;
+	u32 len;
+	u32 offset;
+	u32 produced;
+	u32 n;
+
+	if( dictionary == 0 ){
+		dictionary_size = 0;
+	}
+
+	dest_size = 0;
+	while( s < s_end ){
+		token = *s++;
+
+		len = token >> 4;
+		if( (len == 15) && ((s = read_length(s, s_end, len)) == 0) ){
+			return -1;
+		}
+		if( ((s32)len > s_end - s) || ((s32)len > d_end - d) ){
+			return -1;
+		}
+		memcpy(d, s, len);
+		s += len;
+		d += len;
+
+		if( s == s_end ){
+			break;
+		}
+
+		if( s_end - s < 2 ){
+			return -1;
+		}
+		offset = s[0] | (s[1] << 8);
+		s += 2;
+
+		len = token & 0x0f;
+		if( (len == 15) && ((s = read_length(s, s_end, len)) == 0) ){
+			return -1;
+		}
+		len += MIN_MATCH;
+
+		produced = d - (u8*)dest;
+		if( (offset == 0) || (offset > produced + dictionary_size) || ((s32)len > d_end - d) ){
+			return -1;
+		}
+
+		if( offset > produced ){
+			//the start of the match is in the dictionary
+			n = offset - produced;
+			if( n > len ){ n = len; }
+			memcpy(d, (const u8*)dictionary + dictionary_size - (offset - produced), n);
+			d += n;
+			len -= n;
+		}
+
+		match = d - offset;
+		if( offset >= len ){
+			memcpy(d, match, len);
+			d += len;
+		} else {
+			//overlapping matches repeat the previous bytes
+			while( len-- ){
+				*d++ = *match++;
+			}
+		}
+	}
+
+	dest_size = d - (u8*)dest;
+	return s - (const u8 *)src;
+}
+
+int Lz::decode(var::Data & dest, const var::Data & src, int nbyte, const var::Data & dictionary){
+	s32 dest_size;
+
+	if( nbyte > (int)src.capacity() ){
+		nbyte = src.capacity();
+	}
+
+	dest_size = calc_decoded_size(src.data_const(), nbyte);
+	if( dest_size < 0 ){
+		return -1;
+	}
+
+	if( (dest.set_capacity(dest_size) < 0) || (dest_size && (dest.data() == 0)) ){
+		return -1;
+	}
+
+	if( decode(dest.data(), dest_size, src.data_const(), nbyte, dictionary.data_const(), dictionary.capacity()) < 0 ){
+		return -1;
+	}
+
+	return dest_size;
+}
+
+LzFile::LzFile(){
+	m_window = 0;
+	m_count = 0;
+	m_offset = 0;
+}
+
+int LzFile::init_buffer(){
+	if( m_buffer.capacity() == 0 ){
+		if( m_buffer.alloc(WINDOW_SIZE + BLOCK_SIZE + FRAME_SIZE + HASH_SIZE*sizeof(u16)) < 0 ){
+			set_error_number(ENOMEM);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+int LzFile::set_dictionary(const void * dictionary, int nbyte){
+	if( init_buffer() < 0 ){
+		return -1;
+	}
+
+	if( nbyte > WINDOW_SIZE ){
+		dictionary = (const u8*)dictionary + nbyte - WINDOW_SIZE;
+		nbyte = WINDOW_SIZE;
+	}
+
+	memcpy(block() - nbyte, dictionary, nbyte);
+	m_window = nbyte;
+	m_count = 0;
+	m_offset = 0;
+	return 0;
+}
+
+void LzFile::slide(){
+	u32 keep;
+
+	//keep the last WINDOW_SIZE bytes of the stream just before block()
+	keep = m_window + m_count;
+	if( keep > WINDOW_SIZE ){ keep = WINDOW_SIZE; }
+	memmove(block() - keep, block() + m_count - keep, keep);
+	m_window = keep;
+	m_count = 0;
+	m_offset = 0;
+}
+
+int LzFile::flush(){
+	int ret;
+	s32 dest_size;
+	frame_header_t * header;
+
+	if( m_count == 0 ){
+		return 0;
+	}
+
+	header = (frame_header_t*)frame();
+	dest_size = FRAME_SIZE - sizeof(frame_header_t);
+	ret = encode_block(frame() + sizeof(frame_header_t), dest_size, block(), m_count, block() - m_window, m_window, table());
+
+	header->decoded_size = m_count;
+	if( (ret < 0) || (dest_size >= (s32)m_count) ){
+		//store blocks that don't compress
+		header->encoded_size = 0;
+		dest_size = m_count;
+		memcpy(frame() + sizeof(frame_header_t), block(), m_count);
+	} else {
+		header->encoded_size = dest_size;
+	}
+
+	ret = 0;
+	dest_size += sizeof(frame_header_t);
+	if( File::write(frame(), dest_size) != dest_size ){
+		ret = -1;
+	}
+
+	slide();
+	return ret;
+}
+
+int LzFile::close(){
+	int ret = 0;
+	if( m_buffer.capacity() ){
+		ret = flush();
+	}
+	m_window = 0;
+	m_count = 0;
+	m_offset = 0;
+	if( File::close() < 0 ){
+		ret = -1;
+	}
+	return ret;
+}
+
+int LzFile::write(const void * buf, int nbyte){
+	int bw;
+	int page;
+	const u8 * p = (const u8 *)buf;
+
+	if( init_buffer() < 0 ){
+		return -1;
+	}
+
+	bw = 0;
+	while( bw < nbyte ){
+		page = BLOCK_SIZE - m_count;
+		if( page > nbyte - bw ){ page = nbyte - bw; }
+		memcpy(block() + m_count, p + bw, page);
+		m_count += page;
+		bw += page;
+
+		if( m_count == BLOCK_SIZE ){
+			if( flush() < 0 ){
+				return -1;
+			}
+		}
+	}
+
+	return bw;
+}
+
+int LzFile::read_frame(){
+	frame_header_t header;
+	s32 dest_size;
+	int ret;
+
+	slide();
+
+	ret = File::read(&header, sizeof(header));
+	if( ret == 0 ){
+		return 0;
+	}
+
+	if( (ret != sizeof(header)) || (header.decoded_size > BLOCK_SIZE) ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+
+	if( header.encoded_size == 0 ){
+		if( File::read(block(), header.decoded_size) != header.decoded_size ){
+			return -1;
+		}
+	} else {
+		if( header.encoded_size > FRAME_SIZE ){
+			set_error_number(EINVAL);
+			return -1;
+		}
+
+		if( File::read(frame(), header.encoded_size) != header.encoded_size ){
+			return -1;
+		}
+
+		dest_size = header.decoded_size;
+		if( (decode(block(), dest_size, frame(), header.encoded_size, block() - m_window, m_window) < 0) ||
+				(dest_size != header.decoded_size) ){
+			set_error_number(EINVAL);
+			return -1;
+		}
+	}
+
+	m_count = header.decoded_size;
+	return m_count;
+}
+
+int LzFile::read(void * buf, int nbyte){
+	int br;
+	int page;
+	u8 * p = (u8*)buf;
+
+	if( init_buffer() < 0 ){
+		return -1;
+	}
+
+	br = 0;
+	while( br < nbyte ){
+		if( m_offset == m_count ){
+			if( read_frame() <= 0 ){
+				break;
+			}
+		}
+
+		page = m_count - m_offset;
+		if( page > nbyte - br ){ page = nbyte - br; }
+		memcpy(p + br, block() + m_offset, page);
+		m_offset += page;
+		br += page;
+	}
+
+	return br;
+}
@@ -0,0 +1,95 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include "calc/PidBank.hpp"
+
+using namespace calc;
+
+//the kernels use restrict pointers and are branch free so that they can be vectorized
+static void calc_pid_f(u32 n,
+							  const float * __restrict present_value,
+							  float * __restrict control_variable,
+							  const float * __restrict target,
+							  float * __restrict error,
+							  float * __restrict integral,
+							  const float * __restrict kp,
+							  const float * __restrict ki,
+							  const float * __restrict kd,
+							  const float * __restrict max,
+							  const float * __restrict min){
+	u32 i;
+	for(i=0; i < n; i++){
+		float err = target[i] - present_value[i];
+		float de = err - error[i]; //new value minus older value
+		float output = err * kp[i] + (integral[i] + err) * ki[i] + de * kd[i];
+		float high = max[i];
+		float low = min[i];
+		float clamped = output < low ? low : output;
+		clamped = output > high ? high : clamped;
+
+		//anti-windup -- only integrate when the output is not clamped
+		float windup = output < low ? 0.0f : err;
+		windup = output > high ? 0.0f : windup;
+
+		error[i] = err;
+		integral[i] = integral[i] + windup;
+		control_variable[i] = clamped;
+	}
+}
+
+static void calc_pid_s32(u32 n,
+								 const s32 * __restrict present_value,
+								 s32 * __restrict control_variable,
+								 const s32 * __restrict target,
+								 s32 * __restrict error,
+								 s32 * __restrict integral,
+								 const s32 * __restrict kp,
+								 const s32 * __restrict ki,
+								 const s32 * __restrict kd,
+								 const s32 * __restrict max,
+								 const s32 * __restrict min){
+	u32 i;
+	for(i=0; i < n; i++){
+		s32 err = target[i] - present_value[i];
+		s32 de = err - error[i];
+		s64 output = ((s64)err * kp[i] + ((s64)integral[i] + err) * ki[i] + (s64)de * kd[i]) >> 16;
+		s64 high = max[i];
+		s64 low = min[i];
+		s64 clamped = output < low ? low : output;
+		clamped = output > high ? high : clamped;
+
+		s32 windup = output < low ? 0 : err;
+		windup = output > high ? 0 : windup;
+
+		error[i] = err;
+		integral[i] = integral[i] + windup;
+		control_variable[i] = (s32)clamped;
+	}
+}
+
+void PidBank_f::calc_block(u32 begin, u32 end, const float * present_value, float * control_variable){
+	calc_pid_f(end - begin,
+				  present_value + begin,
+				  control_variable + begin,
+				  m_target.vector_data_const() + begin,
+				  m_error.vector_data() + begin,
+				  m_integral.vector_data() + begin,
+				  m_kp.vector_data_const() + begin,
+				  m_ki.vector_data_const() + begin,
+				  m_kd.vector_data_const() + begin,
+				  m_max.vector_data_const() + begin,
+				  m_min.vector_data_const() + begin);
+}
+
+void PidBank_s32::calc_block(u32 begin, u32 end, const s32 * present_value, s32 * control_variable){
+	calc_pid_s32(end - begin,
+					 present_value + begin,
+					 control_variable + begin,
+					 m_target.vector_data_const() + begin,
+					 m_error.vector_data() + begin,
+					 m_integral.vector_data() + begin,
+					 m_kp.vector_data_const() + begin,
+					 m_ki.vector_data_const() + begin,
+					 m_kd.vector_data_const() + begin,
+					 m_max.vector_data_const() + begin,
+					 m_min.vector_data_const() + begin);
+}
@@ -1,6 +1,7 @@
 //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
 
 #include <cstdio>
+#include <cstring>
 #include "calc/Rle.hpp"
 using namespace calc;
 
@@ -8,63 +9,78 @@ using namespace calc;
 Rle::Rle(){}
 
 
+int Rle::calc_run(const void * src, int nbyte){
+	const u8 * srcp = (const u8*)src;
+	u32 pattern;
+	u32 word;
+	u32 diff;
+	int run;
+
+	if( nbyte <= 0 ){
+		return 0;
+	}
+
+	if( nbyte > MAX_RUN ){
+		nbyte = MAX_RUN;
+	}
+
+	//compare a word at a time against the repeated first byte
+	pattern = srcp[0] * 0x01010101;
+	run = 1;
+	while( run + (int)sizeof(u32) <= nbyte ){
+		memcpy(&word, srcp + run, sizeof(u32));
+		diff = word ^ pattern;
+		if( diff ){
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			return run + __builtin_clz(diff) / 8;
+#else
+			return run + __builtin_ctz(diff) / 8;
+#endif
+		}
+		run += sizeof(u32);
+	}
+
+	while( (run < nbyte) && (srcp[run] == srcp[0]) ){
+		run++;
+	}
+
+	return run;
+}
+
 int Rle::calc_size(const void * src, int nbyte){
 	int bp; //bytes processed
-	uint8_t size;
 	int next_dest_size;
-	const uint8_t * srcp = (const uint8_t*)src;
+	const u8 * srcp = (const u8*)src;
 	next_dest_size = 0;
 	bp = 0;
-	do {
-		size = 1;
-		bp++;
-		srcp++;
-		while( (size != 255) &&
-				(bp < nbyte) &&
-				(*(srcp-1) == *(srcp)) ){
-			size++;
-			bp++;
-			srcp++;
-		}
+	while( bp < nbyte ){
+		bp += calc_run(srcp + bp, nbyte - bp);
 		next_dest_size += sizeof(element_t);
-
-	} while(bp < nbyte);
+	}
 	return next_dest_size;
 }
 
 int Rle::encode(void * dest, s32 & dest_size, const void * src, s32 src_size){
 	int bp; //bytes processed
-	uint8_t value;
-	uint8_t size;
+	int size;
 	int next_dest_size;
-	const uint8_t * srcp = (const uint8_t*)src;
+	const u8 * srcp = (const u8*)src;
 	element_t * elements = (element_t*)dest;
 
 	next_dest_size = 0;
 	bp = 0;
-	do {
+	while( bp < src_size ){
 		if( next_dest_size + (int)sizeof(element_t) > dest_size ){
-			dest_size = next_dest_size;
-			return bp;
-		}
-
-		size = 1;
-		bp++;
-		value = *srcp++;
-		while( (size != 255) &&
-				(bp < src_size) &&
-				(*(srcp-1) == *(srcp)) ){
-			size++;
-			bp++;
-			srcp++;
+			break;
 		}
 
-		elements->data = value;
+		size = calc_run(srcp + bp, src_size - bp);
+		elements->data = srcp[bp];
 		elements->size = size;
 		elements++;
+		bp += size;
 		next_dest_size += sizeof(element_t);
-
-	} while(bp < src_size);
+	}
 	dest_size = next_dest_size;
 	return bp;
 }
@@ -90,22 +106,117 @@ int Rle::decode(void * dest, s32 & dest_size, const void * src, s32 src_size){
 }
 
 
+RleFile::RleFile(){
+	m_count = 0;
+	m_offset = 0;
+}
+
+int RleFile::flush(){
+	int ret = 0;
+	int nbyte;
+	if( m_count ){
+		nbyte = m_count * sizeof(element_t);
+		if( File::write(m_buf, nbyte) != nbyte ){
+			ret = -1;
+		}
+		m_count = 0;
+	}
+	return ret;
+}
+
+int RleFile::close(){
+	int ret = flush();
+	m_count = 0;
+	m_offset = 0;
+	if( File::close() < 0 ){
+		ret = -1;
+	}
+	return ret;
+}
+
 int RleFile::write(const void * buf, int nbyte){
 	int ret;
 	int bw;
+	int run;
 	s32 dest_size;
-	const char * p = (const char *)buf;
+	element_t * last;
+	const u8 * p = (const u8 *)buf;
+	const u32 capacity = BUF_SIZE / sizeof(element_t);
 	bw = 0;
-	do {
-		dest_size = BUF_SIZE;
-		ret = encode(this->buf, dest_size, p, nbyte);
-		if( ret > 0 ){
-			p += ret;
-			nbyte -= ret;
-			bw += ret;
-			File::write(this->buf, dest_size);
+	while( bw < nbyte ){
+
+		//continue the last run if it was interrupted by the end of the previous write
+		if( m_count ){
+			last = m_buf + m_count - 1;
+			if( (last->data == p[bw]) && (last->size < MAX_RUN) ){
+				run = MAX_RUN - last->size;
+				if( run > nbyte - bw ){ run = nbyte - bw; }
+				run = calc_run(p + bw, run);
+				last->size += run;
+				bw += run;
+				continue;
+			}
+		}
+
+		if( m_count == capacity ){
+			if( flush() < 0 ){
+				return -1;
+			}
 		}
-	} while((ret > 0) && (nbyte > 0));
+
+		dest_size = (capacity - m_count) * sizeof(element_t);
+		ret = encode(m_buf + m_count, dest_size, p + bw, nbyte - bw);
+		m_count += dest_size / sizeof(element_t);
+		bw += ret;
+	}
 
 	return bw;
 }
+
+int RleFile::read_elements(){
+	int ret;
+	int remainder;
+	m_offset = 0;
+	m_count = 0;
+	ret = File::read(m_buf, sizeof(m_buf));
+	if( ret < 0 ){
+		return -1;
+	}
+
+	//leave a partial element in the file for the next read
+	remainder = ret % sizeof(element_t);
+	if( remainder ){
+		seek(-1*remainder, CURRENT);
+	}
+
+	m_count = ret / sizeof(element_t);
+	return m_count;
+}
+
+int RleFile::read(void * buf, int nbyte){
+	int br;
+	int size;
+	element_t * element;
+	u8 * p = (u8*)buf;
+	br = 0;
+	while( br < nbyte ){
+		if( m_offset == m_count ){
+			if( read_elements() <= 0 ){
+				break;
+			}
+		}
+
+		//elements that don't fit in buf are partially decoded and finished on the next read
+		element = m_buf + m_offset;
+		size = element->size;
+		if( size > nbyte - br ){ size = nbyte - br; }
+		memset(p + br, element->data, size);
+		br += size;
+		element->size -= size;
+		if( element->size == 0 ){
+			m_offset++;
+		}
+	}
+
+	return br;
+}
@@ -25,7 +25,10 @@ void ChronoInfoObject::wait(const chrono::MicroTime & micro_time){
     wait_microseconds(micro_time.microseconds());
 }
 
+#if !defined __link
+//chrono::Time is implemented in sys/Time.cpp (arm only)
 void ChronoInfoObject::wait(const chrono::Time & time){
     wait_seconds(time.hour() * 3600UL + time.minute()*60UL + time.second());
 }
+#endif
 
@@ -90,7 +90,7 @@ void Animation::reinit(){
 			break;
 		};
 
-		sg_api()->animate_init(pattr(),
+		sgfx::Bitmap::sgfx_api()->animate_init(pattr(),
 				type(),
 				path(),
 				step_total(),
@@ -123,11 +123,12 @@ int Animation::animate_frame(void (*draw)(void*,int,int), void * obj){
 
 	m_drawing_attr->bitmap().set_pen_flags(sgfx::Pen::FLAG_IS_SOLID);
 
-	ret = sg_api()->animate(m_drawing_attr->bitmap().bmap(),
+	ret = sgfx::Bitmap::sgfx_api()->animate(m_drawing_attr->bitmap().bmap(),
 			m_drawing_attr->scratch()->bmap(),
 			data());
 
 	m_drawing_attr->bitmap().set_pen_flags(o_flags);
+	m_drawing_attr->bitmap().mark_dirty();
 	m_drawing_attr->bitmap().refresh();
 	Timer::wait_msec(frame_delay());
 
@@ -4,6 +4,9 @@
 #include "draw/Text.hpp"
 using namespace draw;
 
+//labels are usually drawn on every frame so their layouts are kept
+static sgfx::TextLayoutCache layout_cache;
+
 
 Text::Text(const char * text){
 	assign(text);
@@ -16,6 +19,7 @@ void Text::draw_to_scale(const DrawingScaledAttr & attr){
 	Dim d = attr.dim();
 	sg_point_t p = attr.point();
 	const Font * font;
+	const sgfx::TextLayout * layout;
 
 	if( text() ){
 
@@ -24,8 +28,9 @@ void Text::draw_to_scale(const DrawingScaledAttr & attr){
 		if( font == 0 ){
 			return;
 		}
+		layout = layout_cache.get(*font, text());
 		h = font->get_height();
-		len = font->calc_len(text());
+		len = layout ? layout->width() : font->calc_len(text());
 		top_left.y = p.y;
 		if( is_align_left() ){
 			top_left.x = p.x;
@@ -48,7 +53,11 @@ void Text::draw_to_scale(const DrawingScaledAttr & attr){
 		}
 
 
-		font->draw_str(text(), attr.bitmap(), top_left);
+		if( layout ){
+			layout->draw(attr.bitmap(), top_left);
+		} else {
+			font->draw_str(text(), attr.bitmap(), top_left);
+		}
 
 	}
 
@@ -0,0 +1,274 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cstring>
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined __AVX2__
+#include <immintrin.h>
+#endif
+#include "dsp/BiquadMultichannel.hpp"
+
+using namespace dsp;
+
+namespace {
+enum {
+    BIQUAD_MULTICHANNEL_FRAMES = 128 //frames passed through all stages before moving on (stays in cache)
+};
+
+//returns coefficient (b0, b1, b2, a1, a2) of a stage
+q15_t biquad_coefficient(const BiquadCoefficientsQ15 & coefficients, u32 stage, u32 index){
+    //q15 coefficients are {b0, 0, b1, b2, a1, a2}
+    return coefficients.vector_data_const()[stage*6 + (index ? index + 1 : 0)];
+}
+
+q31_t biquad_coefficient(const BiquadCoefficientsQ31 & coefficients, u32 stage, u32 index){
+    return coefficients.vector_data_const()[stage*5 + index];
+}
+
+float32_t biquad_coefficient(const BiquadCoefficientsF32 & coefficients, u32 stage, u32 index){
+    return coefficients.vector_data_const()[stage*5 + index];
+}
+
+u8 biquad_stages(const BiquadCoefficientsQ15 & coefficients){ return coefficients.count() / 6; }
+u8 biquad_stages(const BiquadCoefficientsQ31 & coefficients){ return coefficients.count() / 5; }
+u8 biquad_stages(const BiquadCoefficientsF32 & coefficients){ return coefficients.count() / 5; }
+
+inline q15_t biquad_output(s64 accumulator, s8 post_shift, q15_t){
+    s32 value = (s32)(accumulator >> (15 - post_shift));
+    if( value > 32767 ){ return 32767; }
+    if( value < -32768 ){ return -32768; }
+    return value;
+}
+
+inline q31_t biquad_output(s64 accumulator, s8 post_shift, q31_t){
+    //wraps like the CMSIS q31 biquad
+    return (q31_t)(accumulator >> (31 - post_shift));
+}
+
+//one stage for every channel -- coefficients and state hold one value per channel for each term
+template<typename T> void biquad_stage(T * data, u32 frames, u32 channels, const T * coefficients, T * state, s8 post_shift){
+    u32 channel;
+    u32 i;
+    for(channel=0; channel < channels; channel++){
+        const s64 b0 = coefficients[channel];
+        const s64 b1 = coefficients[channels + channel];
+        const s64 b2 = coefficients[2*channels + channel];
+        const s64 a1 = coefficients[3*channels + channel];
+        const s64 a2 = coefficients[4*channels + channel];
+        T x1 = state[channel];
+        T x2 = state[channels + channel];
+        T y1 = state[2*channels + channel];
+        T y2 = state[3*channels + channel];
+        T * value = data + channel;
+        for(i=0; i < frames; i++){
+            T x0 = *value;
+            s64 accumulator = b0*x0 + b1*x1 + b2*x2 + a1*y1 + a2*y2;
+            T y0 = biquad_output(accumulator, post_shift, x0);
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            *value = y0;
+            value += channels;
+        }
+        state[channel] = x1;
+        state[channels + channel] = x2;
+        state[2*channels + channel] = y1;
+        state[3*channels + channel] = y2;
+    }
+}
+
+void biquad_stage(float32_t * data, u32 frames, u32 channels, const float32_t * coefficients, float32_t * state, s8 post_shift){
+    u32 channel = 0;
+    u32 i;
+
+    //each vector holds adjacent channels of one frame (same operation order as the mono filter)
+#if defined __AVX2__
+    for(; channel + 8 <= channels; channel += 8){
+        const __m256 b0 = _mm256_loadu_ps(coefficients + channel);
+        const __m256 b1 = _mm256_loadu_ps(coefficients + channels + channel);
+        const __m256 b2 = _mm256_loadu_ps(coefficients + 2*channels + channel);
+        const __m256 a1 = _mm256_loadu_ps(coefficients + 3*channels + channel);
+        const __m256 a2 = _mm256_loadu_ps(coefficients + 4*channels + channel);
+        __m256 x1 = _mm256_loadu_ps(state + channel);
+        __m256 x2 = _mm256_loadu_ps(state + channels + channel);
+        __m256 y1 = _mm256_loadu_ps(state + 2*channels + channel);
+        __m256 y2 = _mm256_loadu_ps(state + 3*channels + channel);
+        float32_t * value = data + channel;
+        for(i=0; i < frames; i++){
+            __m256 x0 = _mm256_loadu_ps(value);
+            __m256 y0 = _mm256_mul_ps(b0, x0);
+            y0 = _mm256_add_ps(y0, _mm256_mul_ps(b1, x1));
+            y0 = _mm256_add_ps(y0, _mm256_mul_ps(b2, x2));
+            y0 = _mm256_add_ps(y0, _mm256_mul_ps(a1, y1));
+            y0 = _mm256_add_ps(y0, _mm256_mul_ps(a2, y2));
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            _mm256_storeu_ps(value, y0);
+            value += channels;
+        }
+        _mm256_storeu_ps(state + channel, x1);
+        _mm256_storeu_ps(state + channels + channel, x2);
+        _mm256_storeu_ps(state + 2*channels + channel, y1);
+        _mm256_storeu_ps(state + 3*channels + channel, y2);
+    }
+#endif
+
+#if defined __SSE2__
+    for(; channel + 4 <= channels; channel += 4){
+        const __m128 b0 = _mm_loadu_ps(coefficients + channel);
+        const __m128 b1 = _mm_loadu_ps(coefficients + channels + channel);
+        const __m128 b2 = _mm_loadu_ps(coefficients + 2*channels + channel);
+        const __m128 a1 = _mm_loadu_ps(coefficients + 3*channels + channel);
+        const __m128 a2 = _mm_loadu_ps(coefficients + 4*channels + channel);
+        __m128 x1 = _mm_loadu_ps(state + channel);
+        __m128 x2 = _mm_loadu_ps(state + channels + channel);
+        __m128 y1 = _mm_loadu_ps(state + 2*channels + channel);
+        __m128 y2 = _mm_loadu_ps(state + 3*channels + channel);
+        float32_t * value = data + channel;
+        for(i=0; i < frames; i++){
+            __m128 x0 = _mm_loadu_ps(value);
+            __m128 y0 = _mm_mul_ps(b0, x0);
+            y0 = _mm_add_ps(y0, _mm_mul_ps(b1, x1));
+            y0 = _mm_add_ps(y0, _mm_mul_ps(b2, x2));
+            y0 = _mm_add_ps(y0, _mm_mul_ps(a1, y1));
+            y0 = _mm_add_ps(y0, _mm_mul_ps(a2, y2));
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            _mm_storeu_ps(value, y0);
+            value += channels;
+        }
+        _mm_storeu_ps(state + channel, x1);
+        _mm_storeu_ps(state + channels + channel, x2);
+        _mm_storeu_ps(state + 2*channels + channel, y1);
+        _mm_storeu_ps(state + 3*channels + channel, y2);
+    }
+#endif
+
+    for(; channel < channels; channel++){
+        const float32_t b0 = coefficients[channel];
+        const float32_t b1 = coefficients[channels + channel];
+        const float32_t b2 = coefficients[2*channels + channel];
+        const float32_t a1 = coefficients[3*channels + channel];
+        const float32_t a2 = coefficients[4*channels + channel];
+        float32_t x1 = state[channel];
+        float32_t x2 = state[channels + channel];
+        float32_t y1 = state[2*channels + channel];
+        float32_t y2 = state[3*channels + channel];
+        float32_t * value = data + channel;
+        for(i=0; i < frames; i++){
+            float32_t x0 = *value;
+            float32_t y0 = b0*x0 + b1*x1 + b2*x2 + a1*y1 + a2*y2;
+            x2 = x1; x1 = x0;
+            y2 = y1; y1 = y0;
+            *value = y0;
+            value += channels;
+        }
+        state[channel] = x1;
+        state[channels + channel] = x2;
+        state[2*channels + channel] = y1;
+        state[3*channels + channel] = y2;
+    }
+
+    (void)post_shift;
+}
+}
+
+template<typename T, typename CoefficientsType> BiquadMultichannel<T, CoefficientsType>::BiquadMultichannel(u8 channels, const CoefficientsType & coefficients, s8 post_shift){
+    u8 channel;
+    initialize(channels, biquad_stages(coefficients), post_shift);
+    for(channel=0; channel < m_channels; channel++){
+        set_coefficients(channel, coefficients);
+    }
+}
+
+template<typename T, typename CoefficientsType> BiquadMultichannel<T, CoefficientsType>::BiquadMultichannel(u8 channels, u8 stages, s8 post_shift){
+    initialize(channels, stages, post_shift);
+}
+
+template<typename T, typename CoefficientsType> void BiquadMultichannel<T, CoefficientsType>::initialize(u8 channels, u8 stages, s8 post_shift){
+    m_channels = 0;
+    m_stages = stages;
+    m_post_shift = post_shift;
+
+    if( channels == 0 ){
+        set_error_number(EINVAL);
+        return;
+    }
+
+    if( (m_coefficients.resize((u32)stages*5*channels) < 0) || (m_state.resize((u32)stages*4*channels) < 0) ){
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    m_channels = channels;
+    memset(m_coefficients.vector_data(), 0, m_coefficients.count()*sizeof(T));
+    reset();
+}
+
+template<typename T, typename CoefficientsType> int BiquadMultichannel<T, CoefficientsType>::set_coefficients(u8 channel, const CoefficientsType & coefficients){
+    u32 stage;
+    u32 index;
+
+    if( (channel >= m_channels) || (biquad_stages(coefficients) != m_stages) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    for(stage=0; stage < m_stages; stage++){
+        for(index=0; index < 5; index++){
+            m_coefficients[(stage*5 + index)*m_channels + channel] = biquad_coefficient(coefficients, stage, index);
+        }
+    }
+    return 0;
+}
+
+template<typename T, typename CoefficientsType> void BiquadMultichannel<T, CoefficientsType>::reset(){
+    memset(m_state.vector_data(), 0, m_state.count()*sizeof(T));
+}
+
+template<typename T, typename CoefficientsType> void BiquadMultichannel<T, CoefficientsType>::process(T * data, u32 frames){
+    const u32 channels = m_channels;
+    u32 frame;
+    u32 stage;
+
+    if( channels == 0 ){ return; }
+
+    //each block goes through every stage while it is in the cache
+    for(frame=0; frame < frames; frame += BIQUAD_MULTICHANNEL_FRAMES){
+        u32 page = frames - frame;
+        if( page > BIQUAD_MULTICHANNEL_FRAMES ){ page = BIQUAD_MULTICHANNEL_FRAMES; }
+        for(stage=0; stage < m_stages; stage++){
+            biquad_stage(data + frame*channels,
+                         page,
+                         channels,
+                         m_coefficients.vector_data_const() + stage*5*channels,
+                         m_state.vector_data() + stage*4*channels,
+                         m_post_shift);
+        }
+    }
+}
+
+template<typename T, typename CoefficientsType> int BiquadMultichannel<T, CoefficientsType>::process(var::Vector<T> & output, const var::Vector<T> & input){
+    if( (m_channels == 0) || (input.count() % m_channels) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( &output != &input ){
+        if( (output.count() != input.count()) && (output.resize(input.count()) < 0) ){
+            set_error_number(ENOMEM);
+            return -1;
+        }
+        memcpy(output.vector_data(), input.vector_data_const(), input.count()*sizeof(T));
+    }
+
+    process(output.vector_data(), output.count() / m_channels);
+    return 0;
+}
+
+namespace dsp {
+template class BiquadMultichannel<q15_t, BiquadCoefficientsQ15>;
+template class BiquadMultichannel<q31_t, BiquadCoefficientsQ31>;
+template class BiquadMultichannel<float32_t, BiquadCoefficientsF32>;
+}
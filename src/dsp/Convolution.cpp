@@ -0,0 +1,288 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cstring>
+#include "dsp/Convolution.hpp"
+
+using namespace dsp;
+
+ConvolutionF32::ConvolutionF32(const SignalF32 & impulse_response, u32 n_samples) : m_fft(calc_fft_samples(n_samples)){
+    u32 i;
+    u32 fft_samples;
+
+    m_position = 0;
+    if( (n_samples < MIN_SAMPLES) || (n_samples > MAX_SAMPLES) || (n_samples & (n_samples-1)) ){
+        m_samples = 0;
+        m_partitions = 0;
+        set_error_number(EINVAL);
+        return;
+    }
+
+    m_samples = n_samples;
+    m_partitions = (impulse_response.count() + m_samples - 1) / m_samples;
+    if( m_partitions == 0 ){ m_partitions = 1; }
+    fft_samples = m_samples*2;
+
+    if( (m_impulse_response.resize(m_partitions*fft_samples) < 0) ||
+            (m_history.resize(m_partitions*fft_samples) < 0) ||
+            (m_input.resize(fft_samples) < 0) ||
+            (m_accumulator.resize(fft_samples) < 0) ||
+            (m_scratch.resize(fft_samples) < 0) ){
+        m_samples = 0;
+        m_partitions = 0;
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    //each partition of the impulse response is zero padded to the FFT size and stored in the frequency domain
+    for(i=0; i < m_partitions; i++){
+        u32 offset = i*m_samples;
+        u32 count = impulse_response.count() - offset;
+        if( count > m_samples ){ count = m_samples; }
+        if( offset >= impulse_response.count() ){ count = 0; }
+        memset(m_scratch.vector_data(), 0, fft_samples*sizeof(float32_t));
+        memcpy(m_scratch.vector_data(), impulse_response.vector_data_const() + offset, count*sizeof(float32_t));
+        arm_dsp_api_f32()->rfft_fast(m_fft.instance(), m_scratch.vector_data(), m_impulse_response.vector_data() + i*fft_samples, 0);
+    }
+
+    reset();
+}
+
+void ConvolutionF32::reset(){
+    memset(m_history.vector_data(), 0, m_history.count()*sizeof(float32_t));
+    memset(m_input.vector_data(), 0, m_input.count()*sizeof(float32_t));
+    m_position = 0;
+}
+
+int ConvolutionF32::convolve(SignalF32 & output, const SignalF32 & input){
+    u32 i;
+    const u32 fft_samples = m_samples*2;
+    float32_t * buffer = m_input.vector_data();
+
+    if( (m_samples == 0) || (input.count() != m_samples) || (output.count() < m_samples) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    //overlap-save: the FFT window is the previous block followed by the current block
+    memmove(buffer, buffer + m_samples, m_samples*sizeof(float32_t));
+    memcpy(buffer + m_samples, input.vector_data_const(), m_samples*sizeof(float32_t));
+
+    //rfft_fast uses the source as scratch memory
+    memcpy(m_scratch.vector_data(), buffer, fft_samples*sizeof(float32_t));
+    arm_dsp_api_f32()->rfft_fast(m_fft.instance(), m_scratch.vector_data(), m_history.vector_data() + m_position*fft_samples, 0);
+
+    //sum the products of the input history and the impulse response partitions
+    memset(m_accumulator.vector_data(), 0, fft_samples*sizeof(float32_t));
+    for(i=0; i < m_partitions; i++){
+        u32 slot = (m_position + m_partitions - i) % m_partitions;
+        multiply_accumulate(m_accumulator.vector_data(),
+                            m_history.vector_data_const() + slot*fft_samples,
+                            m_impulse_response.vector_data_const() + i*fft_samples,
+                            fft_samples);
+    }
+
+    arm_dsp_api_f32()->rfft_fast(m_fft.instance(), m_accumulator.vector_data(), m_scratch.vector_data(), 1);
+
+    //the first half of the window is circularly wrapped -- only the second half is valid
+    memcpy(output.vector_data(), m_scratch.vector_data_const() + m_samples, m_samples*sizeof(float32_t));
+
+    m_position++;
+    if( m_position == m_partitions ){ m_position = 0; }
+    return 0;
+}
+
+int ConvolutionF32::convolve(SignalF32 & output, const SignalF32 & a, const SignalF32 & b){
+    const SignalF32 & x = a.count() >= b.count() ? a : b;
+    const SignalF32 & h = a.count() >= b.count() ? b : a;
+    const u32 n = x.count();
+    const u32 m = h.count();
+    u32 start;
+    u32 i;
+
+    if( (n == 0) || (m == 0) || (output.count() < n + m - 1) ){
+        return -1;
+    }
+
+    if( m > MAX_SAMPLES ){
+        //long impulse responses are partitioned
+        ConvolutionF32 convolution(h, MAX_SAMPLES);
+        SignalF32 input(MAX_SAMPLES);
+        SignalF32 block(MAX_SAMPLES);
+        if( convolution.samples() == 0 ){ return -1; }
+        for(start=0; start < n + m - 1; start += MAX_SAMPLES){
+            u32 count = start < n ? n - start : 0;
+            u32 output_count = n + m - 1 - start;
+            if( count > MAX_SAMPLES ){ count = MAX_SAMPLES; }
+            if( output_count > MAX_SAMPLES ){ output_count = MAX_SAMPLES; }
+            memset(input.vector_data(), 0, MAX_SAMPLES*sizeof(float32_t));
+            memcpy(input.vector_data(), x.vector_data_const() + start, count*sizeof(float32_t));
+            convolution.convolve(block, input);
+            memcpy(output.vector_data() + start, block.vector_data_const(), output_count*sizeof(float32_t));
+        }
+        return 0;
+    }
+
+    //overlap-add with blocks of x sized to fill the FFT
+    const u32 fft_samples = calc_fft_samples(m);
+    const u32 hop = fft_samples - m + 1;
+    FftRealF32 fft(fft_samples);
+    SignalF32 spectrum(fft_samples);
+    SignalF32 block(fft_samples);
+    SignalF32 product(fft_samples);
+
+    memset(block.vector_data(), 0, fft_samples*sizeof(float32_t));
+    memcpy(block.vector_data(), h.vector_data_const(), m*sizeof(float32_t));
+    arm_dsp_api_f32()->rfft_fast(fft.instance(), block.vector_data(), spectrum.vector_data(), 0);
+
+    memset(output.vector_data(), 0, (n + m - 1)*sizeof(float32_t));
+    for(start=0; start < n; start += hop){
+        u32 count = n - start;
+        if( count > hop ){ count = hop; }
+        memset(block.vector_data(), 0, fft_samples*sizeof(float32_t));
+        memcpy(block.vector_data(), x.vector_data_const() + start, count*sizeof(float32_t));
+        arm_dsp_api_f32()->rfft_fast(fft.instance(), block.vector_data(), product.vector_data(), 0);
+        memset(block.vector_data(), 0, fft_samples*sizeof(float32_t));
+        multiply_accumulate(block.vector_data(), product.vector_data_const(), spectrum.vector_data_const(), fft_samples);
+        arm_dsp_api_f32()->rfft_fast(fft.instance(), block.vector_data(), product.vector_data(), 1);
+
+        float32_t * dest = output.vector_data() + start;
+        const float32_t * src = product.vector_data_const();
+        for(i=0; i < count + m - 1; i++){
+            dest[i] += src[i];
+        }
+    }
+
+    return 0;
+}
+
+bool ConvolutionF32::is_fft_faster(u32 a_count, u32 b_count){
+    const u32 n = a_count > b_count ? a_count : b_count;
+    const u32 m = a_count > b_count ? b_count : a_count;
+    float direct;
+    float fft;
+    u32 fft_samples;
+
+    if( m == 0 ){ return false; }
+
+    //costs are estimated in multiply-accumulate operations
+    direct = (float)n * m;
+    if( m > MAX_SAMPLES ){
+        u32 partitions = (m + MAX_SAMPLES - 1) / MAX_SAMPLES;
+        u32 blocks = (n + m - 1 + MAX_SAMPLES - 1) / MAX_SAMPLES;
+        fft_samples = MAX_SAMPLES*2;
+        fft = 1.25f * fft_samples * calc_log2(fft_samples);
+        return (partitions + 1) * fft + blocks * (2*fft + partitions*2.0f*fft_samples) < direct;
+    }
+
+    fft_samples = calc_fft_samples(m);
+    u32 blocks = (n + (fft_samples - m)) / (fft_samples - m + 1);
+    fft = 1.25f * fft_samples * calc_log2(fft_samples);
+    return (2*blocks + 1) * fft + blocks * 3.0f * fft_samples < direct;
+}
+
+void ConvolutionF32::multiply_accumulate(float32_t * accumulator, const float32_t * a, const float32_t * b, u32 fft_samples){
+    u32 i;
+    //rfft_fast packs the real DC and Nyquist values in the first complex value
+    accumulator[0] += a[0] * b[0];
+    accumulator[1] += a[1] * b[1];
+    for(i=2; i < fft_samples; i += 2){
+        float32_t ar = a[i];
+        float32_t ai = a[i+1];
+        float32_t br = b[i];
+        float32_t bi = b[i+1];
+        accumulator[i] += ar*br - ai*bi;
+        accumulator[i+1] += ar*bi + ai*br;
+    }
+}
+
+u32 ConvolutionF32::calc_fft_samples(u32 count){
+    //smallest power of two that holds count*2 (within the range supported by rfft_fast)
+    u32 fft_samples = MIN_SAMPLES*2;
+    while( (fft_samples < count*2) && (fft_samples < MAX_SAMPLES*2) ){
+        fft_samples <<= 1;
+    }
+    return fft_samples;
+}
+
+u32 ConvolutionF32::calc_log2(u32 value){
+    u32 result = 0;
+    while( value > 1 ){
+        value >>= 1;
+        result++;
+    }
+    return result;
+}
+
+ConvolutionQ31::ConvolutionQ31(const SignalQ31 & impulse_response, u32 n_samples) :
+    m_convolution(convert(impulse_response), n_samples){
+    if( m_convolution.samples() == 0 ){
+        set_error_number(m_convolution.error_number());
+        return;
+    }
+    m_input.resize(samples());
+    m_output.resize(samples());
+}
+
+int ConvolutionQ31::convolve(SignalQ31 & output, const SignalQ31 & input){
+    if( (samples() == 0) || (input.count() != samples()) || (output.count() < samples()) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    convert(m_input, input);
+    m_convolution.convolve(m_output, m_input);
+    convert(output, m_output);
+    return 0;
+}
+
+int ConvolutionQ31::convolve(SignalQ31 & output, const SignalQ31 & a, const SignalQ31 & b){
+    if( (a.count() == 0) || (b.count() == 0) || (output.count() < a.count() + b.count() - 1) ){
+        return -1;
+    }
+
+    SignalF32 result(a.count() + b.count() - 1);
+    SignalF32 a_float(a.count());
+    SignalF32 b_float(b.count());
+
+    convert(a_float, a);
+    convert(b_float, b);
+    if( ConvolutionF32::convolve(result, a_float, b_float) < 0 ){
+        return -1;
+    }
+    convert(output, result);
+    return 0;
+}
+
+SignalF32 ConvolutionQ31::convert(const SignalQ31 & input){
+    SignalF32 ret(input.count());
+    convert(ret, input);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+void ConvolutionQ31::convert(SignalF32 & output, const SignalQ31 & input){
+    u32 i;
+    u32 count = input.count() < output.count() ? input.count() : output.count();
+    const q31_t * src = input.vector_data_const();
+    float32_t * dest = output.vector_data();
+    for(i=0; i < count; i++){
+        dest[i] = src[i] * (1.0f / 2147483648.0f);
+    }
+}
+
+void ConvolutionQ31::convert(SignalQ31 & output, const SignalF32 & input){
+    u32 i;
+    u32 count = input.count() < output.count() ? input.count() : output.count();
+    const float32_t * src = input.vector_data_const();
+    q31_t * dest = output.vector_data();
+    for(i=0; i < count; i++){
+        float32_t value = src[i] * 2147483648.0f;
+        if( value >= 2147483647.0f ){
+            dest[i] = 2147483647;
+        } else if( value <= -2147483648.0f ){
+            dest[i] = -2147483647 - 1;
+        } else {
+            dest[i] = (q31_t)value;
+        }
+    }
+}
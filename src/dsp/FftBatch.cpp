@@ -0,0 +1,216 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cstring>
+#include "sys/Thread.hpp"
+#include "dsp/FftBatch.hpp"
+
+using namespace dsp;
+
+//host threads need at least PTHREAD_STACK_MIN
+#if defined __link
+#define FFT_BATCH_STACK_SIZE (64*1024)
+#else
+#define FFT_BATCH_STACK_SIZE 2048
+#endif
+
+/*! \cond */
+class FftBatchRealF32::Worker {
+public:
+    Worker() : thread(FFT_BATCH_STACK_SIZE, false){
+        object = 0;
+        index = 0;
+        batch = 0;
+    }
+
+    FftBatchRealF32 * object;
+    u32 index;
+    u32 batch; //the last batch this worker has seen
+    sys::Thread thread;
+};
+/*! \endcond */
+
+FftBatchRealF32::FftBatchRealF32(u32 n_samples, u32 channels, u32 threads) : m_fft(n_samples){
+    u32 i;
+
+    m_channels = channels;
+    m_threads = threads;
+    if( m_threads == 0 ){ m_threads = 1; }
+    if( m_threads > MAX_THREADS ){ m_threads = MAX_THREADS; }
+
+    m_workers = 0;
+    m_groups = 0;
+    m_batch = 0;
+    m_pending = 0;
+    m_is_stopping = false;
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_start, 0);
+    pthread_cond_init(&m_done, 0);
+
+    if( m_fft.error_number() ){
+        set_error_number(m_fft.error_number());
+        return;
+    }
+
+    if( m_scratch.resize(m_threads*n_samples*2) < 0 ){
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    if( m_threads > 1 ){
+        m_workers = new Worker[m_threads];
+        if( m_workers == 0 ){
+            set_error_number(ENOMEM);
+            return;
+        }
+
+        //workers that can't be created are not valid -- transform() does their channels on the calling thread
+        for(i=1; i < m_threads; i++){
+            m_workers[i].object = this;
+            m_workers[i].index = i;
+            m_workers[i].thread.create(execute_worker, m_workers + i);
+        }
+    }
+}
+
+FftBatchRealF32::~FftBatchRealF32(){
+    u32 i;
+
+    if( m_workers ){
+        pthread_mutex_lock(&m_mutex);
+        m_is_stopping = true;
+        pthread_cond_broadcast(&m_start);
+        pthread_mutex_unlock(&m_mutex);
+
+        for(i=1; i < m_threads; i++){
+            if( m_workers[i].thread.is_valid() ){
+                sys::Thread::join(m_workers[i].thread);
+            }
+        }
+        delete [] m_workers;
+    }
+
+    pthread_cond_destroy(&m_done);
+    pthread_cond_destroy(&m_start);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+int FftBatchRealF32::transform(SignalF32 & output, const SignalF32 & input, enum layout time_layout, bool is_inverse){
+    const u32 n = samples();
+    const u32 total = m_channels*n;
+    u32 groups;
+    u32 i;
+
+    if( (n == 0) || (input.count() != total) || (output.count() != total) || (m_scratch.count() < m_threads*n*2) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    groups = m_threads;
+    if( groups > m_channels ){ groups = m_channels; }
+
+    for(i=0; i < groups; i++){
+        m_jobs[i].input = input.vector_data_const();
+        m_jobs[i].output = output.vector_data();
+        m_jobs[i].scratch = m_scratch.vector_data() + i*n*2;
+        m_jobs[i].first = m_channels*i/groups;
+        m_jobs[i].last = m_channels*(i+1)/groups;
+        m_jobs[i].time_layout = time_layout;
+        m_jobs[i].is_inverse = is_inverse;
+    }
+
+    //start the workers that have a group
+    if( m_workers ){
+        pthread_mutex_lock(&m_mutex);
+        m_groups = groups;
+        m_pending = 0;
+        for(i=1; i < groups; i++){
+            if( m_workers[i].thread.is_valid() ){
+                m_pending++;
+            }
+        }
+        m_batch++;
+        pthread_cond_broadcast(&m_start);
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    //the calling thread takes the first group and any group without a worker
+    transform_channels(m_jobs[0]);
+    for(i=1; i < groups; i++){
+        if( (m_workers == 0) || (m_workers[i].thread.is_valid() == false) ){
+            transform_channels(m_jobs[i]);
+        }
+    }
+
+    if( m_workers ){
+        pthread_mutex_lock(&m_mutex);
+        while( m_pending ){
+            pthread_cond_wait(&m_done, &m_mutex);
+        }
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    return 0;
+}
+
+void * FftBatchRealF32::execute_worker(void * args){
+    Worker * worker = (Worker*)args;
+    FftBatchRealF32 * object = worker->object;
+
+    pthread_mutex_lock(&object->m_mutex);
+    while( 1 ){
+        while( (object->m_batch == worker->batch) && (object->m_is_stopping == false) ){
+            pthread_cond_wait(&object->m_start, &object->m_mutex);
+        }
+
+        if( object->m_is_stopping ){
+            break;
+        }
+
+        worker->batch = object->m_batch;
+        if( worker->index < object->m_groups ){
+            pthread_mutex_unlock(&object->m_mutex);
+            object->transform_channels(object->m_jobs[worker->index]);
+            pthread_mutex_lock(&object->m_mutex);
+            object->m_pending--;
+            if( object->m_pending == 0 ){
+                pthread_cond_signal(&object->m_done);
+            }
+        }
+    }
+    pthread_mutex_unlock(&object->m_mutex);
+    return 0;
+}
+
+void FftBatchRealF32::transform_channels(const job_t & job){
+    const u32 n = samples();
+    const u32 stride = m_channels;
+    float32_t * source = job.scratch;
+    float32_t * destination = job.scratch + n;
+    u32 channel;
+    u32 i;
+
+    for(channel = job.first; channel < job.last; channel++){
+        //the source is used as scratch memory by the transform so input is always copied
+        if( job.is_inverse ){
+            memcpy(source, job.input + channel*n, n*sizeof(float32_t));
+            if( job.time_layout == INTERLEAVED ){
+                arm_dsp_api_f32()->rfft_fast(m_fft.instance(), source, destination, 1);
+                for(i=0; i < n; i++){
+                    job.output[i*stride + channel] = destination[i];
+                }
+            } else {
+                arm_dsp_api_f32()->rfft_fast(m_fft.instance(), source, job.output + channel*n, 1);
+            }
+        } else {
+            if( job.time_layout == INTERLEAVED ){
+                for(i=0; i < n; i++){
+                    source[i] = job.input[i*stride + channel];
+                }
+            } else {
+                memcpy(source, job.input + channel*n, n*sizeof(float32_t));
+            }
+            arm_dsp_api_f32()->rfft_fast(m_fft.instance(), source, job.output + channel*n, 0);
+        }
+    }
+}
@@ -34,7 +34,7 @@ BiquadFilterQ15::BiquadFilterQ15(const BiquadCoefficientsQ15 & coefficients, s8
     m_state.resize( coefficients.stages()*4 );
     if( arm_dsp_api_q15() && arm_dsp_api_q15()->biquad_cascade_df1_init ){
         arm_dsp_api_q15()->biquad_cascade_df1_init(instance(),
-                                                   coefficients.count(),
+                                                   coefficients.stages(),
                                                    (q15_t*)coefficients.vector_data_const(),
                                                    m_state.vector_data(),
                                                    post_shift);
@@ -47,7 +47,7 @@ BiquadFilterQ31::BiquadFilterQ31(const BiquadCoefficientsQ31 & coefficients, s8
     m_state.resize( coefficients.stages()*4 );
     if( arm_dsp_api_q31() && arm_dsp_api_q31()->biquad_cascade_df1_init ){
         arm_dsp_api_q31()->biquad_cascade_df1_init(instance(),
-                                                   coefficients.count(),
+                                                   coefficients.stages(),
                                                    (q31_t*)coefficients.vector_data_const(),
                                                    m_state.vector_data(),
                                                    post_shift);
@@ -60,7 +60,7 @@ BiquadFilterF32::BiquadFilterF32(const BiquadCoefficientsF32 & coefficients){
     m_state.resize( coefficients.stages()*4 );
     if( arm_dsp_api_f32() && arm_dsp_api_f32()->biquad_cascade_df1_init ){
         arm_dsp_api_f32()->biquad_cascade_df1_init(instance(),
-                                                   coefficients.count(),
+                                                   coefficients.stages(),
                                                    (float32_t*)coefficients.vector_data_const(),
                                                    m_state.vector_data());
     } else {
@@ -0,0 +1,146 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include "dsp/FilterPipeline.hpp"
+
+using namespace dsp;
+
+namespace {
+//dispatches to the api for each type -- the fixed point types use the fast versions (like SignalQ15::filter())
+class FilterStageApi : public api::DspWorkObject {
+public:
+    static void fir(const arm_fir_instance_q15 * instance, q15_t * data, u32 count){
+        arm_dsp_api_q15()->fir_fast(instance, data, data, count);
+    }
+
+    static void fir(const arm_fir_instance_q31 * instance, q31_t * data, u32 count){
+        arm_dsp_api_q31()->fir_fast(instance, data, data, count);
+    }
+
+    static void fir(const arm_fir_instance_f32 * instance, float32_t * data, u32 count){
+        arm_dsp_api_f32()->fir(instance, data, data, count);
+    }
+
+    static void biquad(const arm_biquad_casd_df1_inst_q15 * instance, q15_t * data, u32 count){
+        arm_dsp_api_q15()->biquad_cascade_df1_fast(instance, data, data, count);
+    }
+
+    static void biquad(const arm_biquad_casd_df1_inst_q31 * instance, q31_t * data, u32 count){
+        arm_dsp_api_q31()->biquad_cascade_df1_fast(instance, data, data, count);
+    }
+
+    static void biquad(const arm_biquad_casd_df1_inst_f32 * instance, float32_t * data, u32 count){
+        arm_dsp_api_f32()->biquad_cascade_df1(instance, data, data, count);
+    }
+
+    static void scale(q15_t * data, q15_t scale_fraction, s8 shift, u32 count){
+        arm_dsp_api_q15()->scale(data, scale_fraction, shift, data, count);
+    }
+
+    static void scale(q31_t * data, q31_t scale_fraction, s8 shift, u32 count){
+        arm_dsp_api_q31()->scale(data, scale_fraction, shift, data, count);
+    }
+
+    //the shift only applies to fixed point
+    static void scale(float32_t * data, float32_t scale_fraction, s8 /*shift*/, u32 count){
+        arm_dsp_api_f32()->scale(data, scale_fraction, data, count);
+    }
+};
+}
+
+template<typename T, typename FilterType> u32 FirStage<T, FilterType>::process(T * data, u32 count){
+    //the state of the filter holds numTaps - 1 samples plus one block
+    const u32 block_size = m_filter.samples() - m_filter.instance()->numTaps + 1;
+    u32 i;
+    for(i=0; i < count; i += block_size){
+        u32 n = count - i;
+        if( n > block_size ){ n = block_size; }
+        FilterStageApi::fir(m_filter.instance(), data + i, n);
+    }
+    return count;
+}
+
+template<typename T, typename FilterType> u32 BiquadStage<T, FilterType>::process(T * data, u32 count){
+    FilterStageApi::biquad(m_filter.instance(), data, count);
+    return count;
+}
+
+template<typename T> u32 GainStage<T>::process(T * data, u32 count){
+    FilterStageApi::scale(data, m_scale_fraction, m_shift, count);
+    return count;
+}
+
+template<typename T> u32 DecimateStage<T>::process(T * data, u32 count){
+    u32 i;
+    u32 result = 0;
+    //m_phase is the index (within this chunk) of the next sample to keep
+    for(i=m_phase; i < count; i += m_factor){
+        data[result++] = data[i];
+    }
+    m_phase = i - count;
+    return result;
+}
+
+FirDecimateStageQ31::FirDecimateStageQ31(const FirDecimateFilterQ31 & filter) : m_filter(filter){
+    m_pending_count = 0;
+    if( m_filter.instance()->M > MAX_FACTOR ){
+        set_error_number(EINVAL);
+    }
+}
+
+u32 FirDecimateStageQ31::process(q31_t * data, u32 count){
+    const arm_fir_decimate_instance_q31 * instance = m_filter.instance();
+    const u32 factor = instance->M;
+    //the largest multiple of M the state was created for
+    const u32 block_size = (m_filter.samples() - instance->numTaps + 1) / factor * factor;
+    u32 result = 0;
+    u32 i = 0;
+    q31_t output;
+
+    if( (factor > MAX_FACTOR) || (block_size == 0) ){
+        return 0;
+    }
+
+    //complete the group left over from the last call
+    if( m_pending_count ){
+        while( (m_pending_count < factor) && (i < count) ){
+            m_pending[m_pending_count++] = data[i++];
+        }
+        if( m_pending_count < factor ){
+            return 0;
+        }
+        arm_dsp_api_q31()->fir_decimate_fast(instance, m_pending, &output, factor);
+        data[result++] = output;
+        m_pending_count = 0;
+    }
+
+    //outputs are written behind the inputs being read
+    while( count - i >= factor ){
+        u32 n = (count - i) / factor * factor;
+        if( n > block_size ){ n = block_size; }
+        arm_dsp_api_q31()->fir_decimate_fast(instance, data + i, data + result, n);
+        i += n;
+        result += n / factor;
+    }
+
+    while( i < count ){
+        m_pending[m_pending_count++] = data[i++];
+    }
+
+    return result;
+}
+
+namespace dsp {
+template class FirStage<q15_t, FirFilterQ15>;
+template class FirStage<q31_t, FirFilterQ31>;
+template class FirStage<float32_t, FirFilterF32>;
+template class BiquadStage<q15_t, BiquadFilterQ15>;
+template class BiquadStage<q31_t, BiquadFilterQ31>;
+template class BiquadStage<float32_t, BiquadFilterF32>;
+template class GainStage<q15_t>;
+template class GainStage<q31_t>;
+template class GainStage<float32_t>;
+template class DecimateStage<q15_t>;
+template class DecimateStage<q31_t>;
+template class DecimateStage<float32_t>;
+}
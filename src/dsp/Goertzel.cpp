@@ -0,0 +1,239 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cmath>
+#include <cstring>
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined __AVX2__
+#include <immintrin.h>
+#endif
+#include "dsp/Goertzel.hpp"
+
+using namespace dsp;
+
+namespace {
+enum {
+    GOERTZEL_LANES = 8 //bins are padded to a multiple of this
+};
+
+//s[n] = x[n] + 2*cos(w)*s[n-1] - s[n-2] for each bin over count samples
+//(the vector loops may run into the padding)
+void goertzel_update(const float32_t * input, u32 count, const float32_t * coefficient, float32_t * s1, float32_t * s2, u32 bins){
+    u32 bin = 0;
+    u32 i;
+
+#if defined __AVX2__
+    //two groups at a time hide the latency of the recurrence
+    for(; bin + 8 < bins; bin += 16){
+        __m256 c0 = _mm256_loadu_ps(coefficient + bin);
+        __m256 c1 = _mm256_loadu_ps(coefficient + bin + 8);
+        __m256 a0 = _mm256_loadu_ps(s1 + bin);
+        __m256 a1 = _mm256_loadu_ps(s1 + bin + 8);
+        __m256 b0 = _mm256_loadu_ps(s2 + bin);
+        __m256 b1 = _mm256_loadu_ps(s2 + bin + 8);
+        for(i=0; i < count; i++){
+            __m256 x = _mm256_set1_ps(input[i]);
+            __m256 t0 = _mm256_sub_ps(_mm256_add_ps(x, _mm256_mul_ps(c0, a0)), b0);
+            __m256 t1 = _mm256_sub_ps(_mm256_add_ps(x, _mm256_mul_ps(c1, a1)), b1);
+            b0 = a0;
+            b1 = a1;
+            a0 = t0;
+            a1 = t1;
+        }
+        _mm256_storeu_ps(s1 + bin, a0);
+        _mm256_storeu_ps(s1 + bin + 8, a1);
+        _mm256_storeu_ps(s2 + bin, b0);
+        _mm256_storeu_ps(s2 + bin + 8, b1);
+    }
+    for(; bin < bins; bin += 8){
+        __m256 c = _mm256_loadu_ps(coefficient + bin);
+        __m256 a = _mm256_loadu_ps(s1 + bin);
+        __m256 b = _mm256_loadu_ps(s2 + bin);
+        for(i=0; i < count; i++){
+            __m256 s0 = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(input[i]), _mm256_mul_ps(c, a)), b);
+            b = a;
+            a = s0;
+        }
+        _mm256_storeu_ps(s1 + bin, a);
+        _mm256_storeu_ps(s2 + bin, b);
+    }
+#elif defined __SSE2__
+    for(; bin + 4 < bins; bin += 8){
+        __m128 c0 = _mm_loadu_ps(coefficient + bin);
+        __m128 c1 = _mm_loadu_ps(coefficient + bin + 4);
+        __m128 a0 = _mm_loadu_ps(s1 + bin);
+        __m128 a1 = _mm_loadu_ps(s1 + bin + 4);
+        __m128 b0 = _mm_loadu_ps(s2 + bin);
+        __m128 b1 = _mm_loadu_ps(s2 + bin + 4);
+        for(i=0; i < count; i++){
+            __m128 x = _mm_set1_ps(input[i]);
+            __m128 t0 = _mm_sub_ps(_mm_add_ps(x, _mm_mul_ps(c0, a0)), b0);
+            __m128 t1 = _mm_sub_ps(_mm_add_ps(x, _mm_mul_ps(c1, a1)), b1);
+            b0 = a0;
+            b1 = a1;
+            a0 = t0;
+            a1 = t1;
+        }
+        _mm_storeu_ps(s1 + bin, a0);
+        _mm_storeu_ps(s1 + bin + 4, a1);
+        _mm_storeu_ps(s2 + bin, b0);
+        _mm_storeu_ps(s2 + bin + 4, b1);
+    }
+    for(; bin < bins; bin += 4){
+        __m128 c = _mm_loadu_ps(coefficient + bin);
+        __m128 a = _mm_loadu_ps(s1 + bin);
+        __m128 b = _mm_loadu_ps(s2 + bin);
+        for(i=0; i < count; i++){
+            __m128 s0 = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(input[i]), _mm_mul_ps(c, a)), b);
+            b = a;
+            a = s0;
+        }
+        _mm_storeu_ps(s1 + bin, a);
+        _mm_storeu_ps(s2 + bin, b);
+    }
+#endif
+
+    //the states stay in registers while the block is read
+    for(; bin < bins; bin++){
+        float32_t c = coefficient[bin];
+        float32_t a = s1[bin];
+        float32_t b = s2[bin];
+        for(i=0; i < count; i++){
+            float32_t s0 = input[i] + c*a - b;
+            b = a;
+            a = s0;
+        }
+        s1[bin] = a;
+        s2[bin] = b;
+    }
+}
+
+//q1.31 state times q2.29 coefficient -- split so the 64-bit products can't overflow
+inline s64 goertzel_multiply(s64 state, s32 coefficient){
+    return (((state >> 24) * coefficient) >> 5) + (((state & 0xFFFFFF) * coefficient) >> 29);
+}
+
+inline s64 goertzel_sample(q15_t value){ return (s64)value * 65536; }
+inline s64 goertzel_sample(q31_t value){ return value; }
+
+template<typename T> void goertzel_update(const T * input, u32 count, const s32 * coefficient, s64 * s1, s64 * s2, u32 bins){
+    u32 bin;
+    u32 i;
+    for(bin=0; bin < bins; bin++){
+        s32 c = coefficient[bin];
+        s64 a = s1[bin];
+        s64 b = s2[bin];
+        for(i=0; i < count; i++){
+            s64 s0 = goertzel_sample(input[i]) + goertzel_multiply(a, c) - b;
+            b = a;
+            a = s0;
+        }
+        s1[bin] = a;
+        s2[bin] = b;
+    }
+}
+
+void goertzel_convert(double value, float32_t & output){ output = value; }
+void goertzel_convert(double value, s32 & output){ output = (s32)round(value * 536870912.0); }
+
+double goertzel_value(float32_t value){ return value; }
+double goertzel_value(s32 value){ return value / 536870912.0; }
+double goertzel_value(s64 value){ return value / 2147483648.0; }
+}
+
+template<typename T> GoertzelBank<T>::GoertzelBank(const var::Vector<float32_t> & frequencies, float32_t sample_rate, u32 block_size){
+    u32 padded;
+    u32 i;
+
+    m_bins = 0;
+    m_block_size = block_size;
+    m_fill = 0;
+
+    if( (block_size == 0) || (sample_rate <= 0.0f) ){
+        set_error_number(EINVAL);
+        return;
+    }
+
+    padded = (frequencies.count() + GOERTZEL_LANES - 1) / GOERTZEL_LANES * GOERTZEL_LANES;
+    if( (m_coefficient.resize(padded) < 0) || (m_state.resize(padded*2) < 0) || (m_power.resize(frequencies.count()) < 0) ){
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    //unused lanes have a zero coefficient
+    for(i=0; i < padded; i++){
+        double w = i < frequencies.count() ? 2.0 * M_PI * frequencies.vector_data_const()[i] / sample_rate : M_PI / 2.0;
+        goertzel_convert(2.0 * cos(w), m_coefficient[i]);
+    }
+
+    m_bins = frequencies.count();
+    reset();
+}
+
+template<typename T> void GoertzelBank<T>::reset(){
+    memset(m_state.vector_data(), 0, m_state.count()*sizeof(state_type));
+    memset(m_power.vector_data(), 0, m_power.count()*sizeof(float32_t));
+    m_fill = 0;
+}
+
+template<typename T> u32 GoertzelBank<T>::process(const var::Vector<T> & input){
+    return process(input.vector_data_const(), input.count(), 0);
+}
+
+template<typename T> u32 GoertzelBank<T>::process(var::Ring<float32_t> & output, const var::Vector<T> & input){
+    return process(input.vector_data_const(), input.count(), &output);
+}
+
+template<typename T> u32 GoertzelBank<T>::process(const T * input, u32 count, var::Ring<float32_t> * ring){
+    const u32 padded = m_coefficient.count();
+    state_type * s1 = m_state.vector_data();
+    u32 result = 0;
+    u32 i = 0;
+
+    if( m_bins == 0 ){ return 0; }
+
+    while( i < count ){
+        u32 page = count - i;
+        if( page > m_block_size - m_fill ){ page = m_block_size - m_fill; }
+
+        goertzel_update(input + i, page, m_coefficient.vector_data_const(), s1, s1 + padded, m_bins);
+        m_fill += page;
+        i += page;
+
+        if( m_fill == m_block_size ){
+            calculate_power();
+            if( ring ){
+                ring->write(m_power.vector_data_const(), m_bins);
+            }
+            memset(m_state.vector_data(), 0, m_state.count()*sizeof(state_type));
+            m_fill = 0;
+            result++;
+        }
+    }
+
+    return result;
+}
+
+template<typename T> void GoertzelBank<T>::calculate_power(){
+    const u32 padded = m_coefficient.count();
+    const state_type * s1 = m_state.vector_data_const();
+    const state_type * s2 = s1 + padded;
+    //scaled so a full scale sine wave has a power of one
+    const double scale = 4.0 / ((double)m_block_size * m_block_size);
+    u32 bin;
+
+    for(bin=0; bin < m_bins; bin++){
+        double a = goertzel_value(s1[bin]);
+        double b = goertzel_value(s2[bin]);
+        double c = goertzel_value(m_coefficient.vector_data_const()[bin]);
+        m_power[bin] = (a*a + b*b - c*a*b) * scale;
+    }
+}
+
+namespace dsp {
+template class GoertzelBank<q15_t>;
+template class GoertzelBank<q31_t>;
+template class GoertzelBank<float32_t>;
+}
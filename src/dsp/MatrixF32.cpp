@@ -0,0 +1,24 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cstring>
+#include "dsp/Matrix.hpp"
+
+using namespace dsp;
+
+#define IS_FLOAT 1
+#define HAS_SHIFT 0
+#define HAS_MULTIPLY_STATE 0
+#define native_type float32_t
+#define arm_dsp_api_function() arm_dsp_api_f32()
+#define MatrixType MatrixF32
+
+#include "MatrixGeneric.h"
+
+void MatrixF32::set_identity(){
+    u32 i;
+    memset(vector_data(), 0, count()*sizeof(float32_t));
+    for(i=0; (i < rows()) && (i < columns()); i++){
+        at(i,i) = 1.0f;
+    }
+}
@@ -0,0 +1,275 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+//This file is included by MatrixQ15.cpp, MatrixQ31.cpp and MatrixF32.cpp
+
+MatrixType MatrixType::operator + (const MatrixType & a) const {
+    MatrixType ret;
+    add(ret, a);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+MatrixType MatrixType::operator - (const MatrixType & a) const {
+    MatrixType ret;
+    subtract(ret, a);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+MatrixType MatrixType::operator * (const MatrixType & a) const {
+    MatrixType ret;
+    multiply(ret, a);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+MatrixType & MatrixType::operator += (const MatrixType & a){
+    add(*this, a);
+    return *this;
+}
+
+MatrixType & MatrixType::operator -= (const MatrixType & a){
+    subtract(*this, a);
+    return *this;
+}
+
+MatrixType & MatrixType::operator *= (const MatrixType & a){
+    multiply(*this, a);
+    return *this;
+}
+
+int MatrixType::add(MatrixType & output, const MatrixType & a) const {
+    if( (a.rows() != rows()) || (a.columns() != columns()) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( arm_dsp_api_function()->mat_add(instance(), a.instance(), output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+
+int MatrixType::subtract(MatrixType & output, const MatrixType & a) const {
+    if( (a.rows() != rows()) || (a.columns() != columns()) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( arm_dsp_api_function()->mat_sub(instance(), a.instance(), output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+
+int MatrixType::multiply(MatrixType & output, const MatrixType & a) const {
+    arm_status status;
+
+    if( columns() != a.rows() ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    //the output can't overlap the inputs
+    if( (&output == this) || (&output == &a) ){
+        MatrixType result;
+        if( multiply(result, a) < 0 ){
+            return -1;
+        }
+        output = result;
+        return 0;
+    }
+
+    if( output.set_size(rows(), a.columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+#if HAS_MULTIPLY_STATE
+    {
+        //holds the transpose of a
+        native_type * state = scratch(a.count());
+        if( state == 0 ){
+            set_error_number(ENOMEM);
+            return -1;
+        }
+        status = arm_dsp_api_function()->mat_mult(instance(), a.instance(), output.instance(), state);
+    }
+#else
+    status = arm_dsp_api_function()->mat_mult(instance(), a.instance(), output.instance());
+#endif
+
+    if( status != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+
+MatrixType MatrixType::transpose() const {
+    MatrixType ret;
+    transpose(ret);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+int MatrixType::transpose(MatrixType & output) const {
+    if( &output == this ){
+        if( is_square() ){
+            u16 i, j;
+            MatrixType & self = output;
+            for(i=0; i < rows(); i++){
+                for(j=i+1; j < columns(); j++){
+                    native_type value = self.at(i,j);
+                    self.at(i,j) = self.at(j,i);
+                    self.at(j,i) = value;
+                }
+            }
+            return 0;
+        }
+
+        MatrixType source(*this);
+        return source.transpose(output);
+    }
+
+    if( output.set_size(columns(), rows()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( arm_dsp_api_function()->mat_trans(instance(), output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+
+MatrixType MatrixType::inverse() const {
+    MatrixType ret;
+    inverse(ret);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+#if IS_FLOAT
+int MatrixType::inverse(MatrixType & output) const {
+    arm_matrix_instance_f32 source;
+
+    if( !is_square() ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    //the CMSIS function uses the source as working memory
+    source.numRows = rows();
+    source.numCols = columns();
+    source.pData = scratch(count());
+    if( source.pData == 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+    memcpy(source.pData, vector_data_const(), count()*sizeof(float32_t));
+
+    if( arm_dsp_api_f32()->mat_inverse(&source, output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+#else
+int MatrixType::inverse(MatrixType & output) const {
+    MatrixF32 source(rows(), columns());
+    MatrixF32 result;
+    u32 i;
+
+    if( !is_square() ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    for(i=0; i < count(); i++){
+        source[i] = vector_data_const()[i] / fixed_scale;
+    }
+
+    if( source.inverse(result) < 0 ){
+        set_error_number(source.error_number());
+        return -1;
+    }
+
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    for(i=0; i < count(); i++){
+        float32_t value = result[i] * fixed_scale;
+        if( value >= fixed_scale ){
+            output[i] = fixed_max;
+        } else if( value <= -fixed_scale ){
+            output[i] = fixed_min;
+        } else {
+            output[i] = (native_type)value;
+        }
+    }
+    return 0;
+}
+#endif
+
+#if HAS_SHIFT
+MatrixType MatrixType::scale(native_type scale_fraction, s8 shift) const {
+    MatrixType ret;
+    scale(ret, scale_fraction, shift);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+int MatrixType::scale(MatrixType & output, native_type scale_fraction, s8 shift) const {
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( arm_dsp_api_function()->mat_scale(instance(), scale_fraction, shift, output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+#else
+MatrixType MatrixType::scale(native_type value) const {
+    MatrixType ret;
+    scale(ret, value);
+    ret.set_transfer_ownership();
+    return ret;
+}
+
+int MatrixType::scale(MatrixType & output, native_type value) const {
+    if( output.set_size(rows(), columns()) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( arm_dsp_api_function()->mat_scale(instance(), value, output.instance()) != ARM_MATH_SUCCESS ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,18 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include "dsp/Matrix.hpp"
+
+using namespace dsp;
+
+#define IS_FLOAT 0
+#define HAS_SHIFT 1
+#define HAS_MULTIPLY_STATE 1
+#define native_type q15_t
+#define arm_dsp_api_function() arm_dsp_api_q15()
+#define MatrixType MatrixQ15
+#define fixed_scale 32768.0f
+#define fixed_max 0x7FFF
+#define fixed_min ((q15_t)0x8000)
+
+#include "MatrixGeneric.h"
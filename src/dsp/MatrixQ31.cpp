@@ -0,0 +1,18 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include "dsp/Matrix.hpp"
+
+using namespace dsp;
+
+#define IS_FLOAT 0
+#define HAS_SHIFT 1
+#define HAS_MULTIPLY_STATE 0
+#define native_type q31_t
+#define arm_dsp_api_function() arm_dsp_api_q31()
+#define MatrixType MatrixQ31
+#define fixed_scale 2147483648.0f
+#define fixed_max 0x7FFFFFFF
+#define fixed_min ((q31_t)0x80000000)
+
+#include "MatrixGeneric.h"
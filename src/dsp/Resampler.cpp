@@ -0,0 +1,217 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cmath>
+#include <cstring>
+#include "dsp/Resampler.hpp"
+
+using namespace dsp;
+
+namespace {
+//the fixed point types accumulate in 64-bits and saturate like the CMSIS filters
+q15_t resampler_dot(const q15_t * coefficients, const q15_t * samples, u32 count){
+    s64 accumulator = 0;
+    u32 i;
+    for(i=0; i < count; i++){
+        accumulator += (s32)coefficients[i] * samples[i];
+    }
+    accumulator >>= 15;
+    if( accumulator > 32767 ){ return 32767; }
+    if( accumulator < -32768 ){ return -32768; }
+    return accumulator;
+}
+
+q31_t resampler_dot(const q31_t * coefficients, const q31_t * samples, u32 count){
+    s64 accumulator = 0;
+    u32 i;
+    //products are kept as q9.54 to leave guard bits for the sum
+    for(i=0; i < count; i++){
+        accumulator += ((s64)coefficients[i] * samples[i]) >> 8;
+    }
+    accumulator >>= 23;
+    if( accumulator > 0x7FFFFFFF ){ return 0x7FFFFFFF; }
+    if( accumulator < -(s64)0x80000000 ){ return 0x80000000; }
+    return accumulator;
+}
+
+float32_t resampler_dot(const float32_t * coefficients, const float32_t * samples, u32 count){
+    float32_t accumulator = 0.0f;
+    u32 i;
+    for(i=0; i < count; i++){
+        accumulator += coefficients[i] * samples[i];
+    }
+    return accumulator;
+}
+
+void resampler_convert(double value, q15_t & output){
+    value = round(value * 32768.0);
+    if( value > 32767.0 ){ value = 32767.0; }
+    if( value < -32768.0 ){ value = -32768.0; }
+    output = (q15_t)value;
+}
+
+void resampler_convert(double value, q31_t & output){
+    value = round(value * 2147483648.0);
+    if( value > 2147483647.0 ){ value = 2147483647.0; }
+    if( value < -2147483648.0 ){ value = -2147483648.0; }
+    output = (q31_t)value;
+}
+
+void resampler_convert(double value, float32_t & output){
+    output = value;
+}
+
+//Blackman windowed sinc (cutoff is in cycles per sample)
+double resampler_prototype(u32 i, u32 n, double cutoff){
+    double x = 2.0 * cutoff * (i - (n - 1) / 2.0);
+    double sinc = (x == 0.0) ? 1.0 : sin(M_PI*x) / (M_PI*x);
+    double window = 0.42 - 0.5*cos(2.0*M_PI*i/(n-1)) + 0.08*cos(4.0*M_PI*i/(n-1));
+    return sinc * window;
+}
+
+u32 resampler_gcd(u32 a, u32 b){
+    while( b ){
+        u32 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+}
+
+template<typename T> Resampler<T>::Resampler(u32 up, u32 down, u32 zero_crossings){
+    var::Vector<T> coefficients;
+    u32 longest;
+    u32 n;
+    u32 i;
+    double cutoff;
+    double sum;
+
+    set_ratio(up, down);
+    if( zero_crossings == 0 ){ zero_crossings = 1; }
+
+    longest = m_up > m_down ? m_up : m_down;
+    n = 2*zero_crossings*longest;
+    n = (n + m_up - 1) / m_up * m_up;
+
+    if( coefficients.resize(n) < 0 ){
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    //designed at the interpolated rate -- the cutoff is moved
+    //below the lower Nyquist frequency by part of the transition band
+    cutoff = 0.5 / longest * (1.0 - 2.0 / (zero_crossings + 2));
+    sum = 0.0;
+    for(i=0; i < n; i++){
+        sum += resampler_prototype(i, n, cutoff);
+    }
+
+    //scaled so each branch has a DC gain of about one
+    for(i=0; i < n; i++){
+        resampler_convert(resampler_prototype(i, n, cutoff) * m_up / sum, coefficients[i]);
+    }
+
+    set_coefficients(coefficients.vector_data_const(), n);
+}
+
+template<typename T> Resampler<T>::Resampler(u32 up, u32 down, const var::Vector<T> & coefficients){
+    set_ratio(up, down);
+    set_coefficients(coefficients.vector_data_const(), coefficients.count());
+}
+
+template<typename T> void Resampler<T>::set_ratio(u32 up, u32 down){
+    u32 divisor;
+    m_taps = 0;
+    if( (up == 0) || (down == 0) ){
+        set_error_number(EINVAL);
+        up = 1;
+        down = 1;
+    }
+    divisor = resampler_gcd(up, down);
+    m_up = up / divisor;
+    m_down = down / divisor;
+}
+
+template<typename T> int Resampler<T>::set_coefficients(const T * coefficients, u32 count){
+    u32 phase;
+    u32 tap;
+
+    m_taps = (count + m_up - 1) / m_up;
+    if( m_taps == 0 ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( (m_coefficients.resize(m_up*m_taps) < 0) || (m_delay.resize(m_taps*2) < 0) ){
+        m_taps = 0;
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    //branch p uses h[p], h[p+L], h[p+2L], ... (zero padded)
+    for(phase=0; phase < m_up; phase++){
+        for(tap=0; tap < m_taps; tap++){
+            u32 i = phase + tap*m_up;
+            m_coefficients[phase*m_taps + tap] = i < count ? coefficients[i] : 0;
+        }
+    }
+
+    reset();
+    return 0;
+}
+
+template<typename T> void Resampler<T>::reset(){
+    memset(m_delay.vector_data(), 0, m_delay.count()*sizeof(T));
+    m_phase = 0;
+    m_position = 0;
+}
+
+template<typename T> u32 Resampler<T>::calculate_output_count(u32 input_count) const {
+    u64 total = (u64)input_count * m_up;
+    if( total <= m_phase ){
+        return 0;
+    }
+    return (total - m_phase + m_down - 1) / m_down;
+}
+
+template<typename T> u32 Resampler<T>::process(T * output, const T * input, u32 count){
+    const u32 taps = m_taps;
+    const T * coefficients = m_coefficients.vector_data_const();
+    T * delay = m_delay.vector_data();
+    u32 result = 0;
+    u32 i;
+
+    if( taps == 0 ){
+        return 0;
+    }
+
+    for(i=0; i < count; i++){
+        //the delay line runs newest to oldest starting at m_position
+        m_position = m_position ? m_position - 1 : taps - 1;
+        delay[m_position] = input[i];
+        delay[m_position + taps] = input[i];
+
+        while( m_phase < m_up ){
+            output[result++] = resampler_dot(coefficients + m_phase*taps, delay + m_position, taps);
+            m_phase += m_down;
+        }
+        m_phase -= m_up;
+    }
+
+    return result;
+}
+
+template<typename T> int Resampler<T>::process(var::Vector<T> & output, const var::Vector<T> & input){
+    if( output.resize(calculate_output_count(input.count())) < 0 ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+    return process(output.vector_data(), input.vector_data_const(), input.count());
+}
+
+namespace dsp {
+template class Resampler<q15_t>;
+template class Resampler<q31_t>;
+template class Resampler<float32_t>;
+}
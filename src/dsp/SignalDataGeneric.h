@@ -92,6 +92,13 @@ void SignalType::negate(SignalType & output) const {
 
 SignalType SignalType::convolve(const SignalType & a) const {
     SignalType ret(count() + a.count() - 1);
+#if defined ConvolutionType
+    if( ConvolutionType::is_fft_faster(count(), a.count()) ){
+        ConvolutionType::convolve(ret, *this, a);
+        ret.set_transfer_ownership();
+        return ret;
+    }
+#endif
 #if IS_FLOAT == 0
     arm_dsp_api_function()->conv_fast((native_type*)vector_data_const(), count(), (native_type*)a.vector_data_const(), a.count(), ret.vector_data());
 #else
@@ -103,6 +110,12 @@ SignalType SignalType::convolve(const SignalType & a) const {
 
 void SignalType::convolve(SignalType & output, const SignalType & a) const {
     //check output length?
+#if defined ConvolutionType
+    if( ConvolutionType::is_fft_faster(count(), a.count()) ){
+        ConvolutionType::convolve(output, *this, a);
+        return;
+    }
+#endif
 #if IS_FLOAT == 0
     arm_dsp_api_function()->conv_fast((native_type*)vector_data_const(), count(), (native_type*)a.vector_data_const(), a.count(), output.vector_data());
 #else
@@ -1,6 +1,7 @@
 #include "dsp/SignalData.hpp"
 #include "dsp/Transform.hpp"
 #include "dsp/Filter.hpp"
+#include "dsp/Convolution.hpp"
 
 using namespace dsp;
 
@@ -14,6 +15,7 @@ using namespace dsp;
 #define FftComplexType FftComplexF32
 #define BiquadFilterType BiquadFilterF32
 #define FirFilterType FirFilterF32
+#define ConvolutionType ConvolutionF32
 #define big_type float32_t
 
 #include "SignalDataGeneric.h"
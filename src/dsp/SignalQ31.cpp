@@ -1,6 +1,7 @@
 #include "dsp/SignalData.hpp"
 #include "dsp/Transform.hpp"
 #include "dsp/Filter.hpp"
+#include "dsp/Convolution.hpp"
 
 using namespace dsp;
 
@@ -14,6 +15,7 @@ using namespace dsp;
 #define FftComplexType FftComplexQ31
 #define BiquadFilterType BiquadFilterQ31
 #define FirFilterType FirFilterQ31
+#define ConvolutionType ConvolutionQ31
 #define big_type q63_t
 
 #include "SignalDataGeneric.h"
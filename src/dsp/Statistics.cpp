@@ -0,0 +1,195 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cmath>
+#include "dsp/Statistics.hpp"
+
+using namespace dsp;
+
+namespace {
+enum {
+    STATISTICS_BLOCK = 256 //samples summarized before merging (bounds the float error)
+};
+
+//Each block is summarized relative to its first sample (shifted data) which
+//avoids the cancellation of sum(x^2) - sum(x)^2/n. The q15 sums are exact.
+void statistics_block(const q15_t * input, u32 count, double & mean, double & m2, u32 & min_index, u32 & max_index){
+    const s32 shift = input[0];
+    s64 sum = 0;
+    s64 sum_squares = 0;
+    u32 i;
+    min_index = 0;
+    max_index = 0;
+    for(i=0; i < count; i++){
+        s32 value = input[i] - shift;
+        sum += value;
+        sum_squares += (s64)value*value;
+        if( input[i] < input[min_index] ){ min_index = i; }
+        if( input[i] > input[max_index] ){ max_index = i; }
+    }
+    mean = shift + (double)sum / count;
+    m2 = (double)sum_squares - (double)sum * sum / count;
+}
+
+void statistics_block(const q31_t * input, u32 count, double & mean, double & m2, u32 & min_index, u32 & max_index){
+    const s64 shift = input[0];
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    u32 i;
+    min_index = 0;
+    max_index = 0;
+    for(i=0; i < count; i++){
+        double value = (double)(input[i] - shift);
+        sum += value;
+        sum_squares += value*value;
+        if( input[i] < input[min_index] ){ min_index = i; }
+        if( input[i] > input[max_index] ){ max_index = i; }
+    }
+    mean = shift + sum / count;
+    m2 = sum_squares - sum * sum / count;
+}
+
+void statistics_block(const float32_t * input, u32 count, double & mean, double & m2, u32 & min_index, u32 & max_index){
+    const float32_t shift = input[0];
+    float32_t sum = 0.0f;
+    float32_t sum_squares = 0.0f;
+    u32 i;
+    min_index = 0;
+    max_index = 0;
+    for(i=0; i < count; i++){
+        float32_t value = input[i] - shift;
+        sum += value;
+        sum_squares += value*value;
+        if( input[i] < input[min_index] ){ min_index = i; }
+        if( input[i] > input[max_index] ){ max_index = i; }
+    }
+    mean = shift + (double)sum / count;
+    m2 = (double)sum_squares - (double)sum * sum / count;
+}
+
+void statistics_convert(double value, q15_t & output){
+    value = round(value);
+    if( value > 32767.0 ){ value = 32767.0; }
+    if( value < -32768.0 ){ value = -32768.0; }
+    output = (q15_t)value;
+}
+
+void statistics_convert(double value, q31_t & output){
+    value = round(value);
+    if( value > 2147483647.0 ){ value = 2147483647.0; }
+    if( value < -2147483648.0 ){ value = -2147483648.0; }
+    output = (q31_t)value;
+}
+
+void statistics_convert(double value, float32_t & output){
+    output = value;
+}
+
+//full scale of the type (squared values are returned in the same format as the samples)
+double statistics_scale(q15_t){ return 32768.0; }
+double statistics_scale(q31_t){ return 2147483648.0; }
+double statistics_scale(float32_t){ return 1.0; }
+}
+
+template<typename T> void Statistics<T>::reset(){
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_min = 0;
+    m_max = 0;
+    m_min_index = 0;
+    m_max_index = 0;
+}
+
+template<typename T> void Statistics<T>::update(const T * input, u32 count){
+    u32 i;
+    for(i=0; i < count; i += STATISTICS_BLOCK){
+        u32 page = count - i;
+        double mean;
+        double m2;
+        u32 min_index;
+        u32 max_index;
+
+        if( page > STATISTICS_BLOCK ){ page = STATISTICS_BLOCK; }
+
+        statistics_block(input + i, page, mean, m2, min_index, max_index);
+
+        if( (m_count == 0) || (input[i + min_index] < m_min) ){
+            m_min = input[i + min_index];
+            m_min_index = m_count + min_index;
+        }
+
+        if( (m_count == 0) || (input[i + max_index] > m_max) ){
+            m_max = input[i + max_index];
+            m_max_index = m_count + max_index;
+        }
+
+        merge(page, mean, m2);
+    }
+}
+
+template<typename T> void Statistics<T>::merge(const Statistics & a){
+    if( a.m_count == 0 ){
+        return;
+    }
+
+    if( (m_count == 0) || (a.m_min < m_min) ){
+        m_min = a.m_min;
+        m_min_index = m_count + a.m_min_index;
+    }
+
+    if( (m_count == 0) || (a.m_max > m_max) ){
+        m_max = a.m_max;
+        m_max_index = m_count + a.m_max_index;
+    }
+
+    merge(a.m_count, a.m_mean, a.m_m2);
+}
+
+template<typename T> void Statistics<T>::merge(u64 count, double mean, double m2){
+    //Chan et al. -- combines two sets of (count, mean, m2)
+    u64 total = m_count + count;
+    double delta = mean - m_mean;
+    m_mean += delta * count / total;
+    m_m2 += m2 + delta * delta * ((double)m_count * count / total);
+    m_count = total;
+}
+
+template<typename T> T Statistics<T>::mean() const {
+    T result;
+    statistics_convert(m_mean, result);
+    return result;
+}
+
+template<typename T> T Statistics<T>::variance() const {
+    T result;
+    double value = m_count > 1 ? m_m2 / (m_count - 1) : 0.0;
+    statistics_convert(value / statistics_scale(T()), result);
+    return result;
+}
+
+template<typename T> T Statistics<T>::std() const {
+    T result;
+    double value = m_count > 1 ? m_m2 / (m_count - 1) : 0.0;
+    statistics_convert(sqrt(value), result);
+    return result;
+}
+
+template<typename T> T Statistics<T>::rms() const {
+    T result;
+    //sum(x^2)/n = m2/n + mean^2
+    double value = m_count ? m_m2 / m_count + m_mean * m_mean : 0.0;
+    statistics_convert(sqrt(value), result);
+    return result;
+}
+
+template<typename T> T Statistics<T>::peak_to_peak() const {
+    T result;
+    statistics_convert((double)m_max - (double)m_min, result);
+    return result;
+}
+
+namespace dsp {
+template class Statistics<q15_t>;
+template class Statistics<q31_t>;
+template class Statistics<float32_t>;
+}
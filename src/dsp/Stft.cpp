@@ -0,0 +1,143 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <errno.h>
+#include <cmath>
+#include <cstring>
+#include "dsp/Stft.hpp"
+
+using namespace dsp;
+
+StftF32::StftF32(u32 n_samples, u32 hop, enum window_type window, enum output_type output) : m_fft(n_samples){
+    u32 i;
+    const float32_t two_pi = 6.283185307179586f;
+
+    m_hop = hop ? hop : 1;
+    m_output = output;
+    m_fill = 0;
+    m_skip = 0;
+    m_row = 0;
+
+    if( m_fft.error_number() ){
+        set_error_number(m_fft.error_number());
+        return;
+    }
+
+    if( hop == 0 ){
+        set_error_number(EINVAL);
+    }
+
+    m_window.resize(n_samples);
+    m_frame.resize(n_samples);
+    m_scratch.resize(n_samples);
+    m_spectrum.resize(n_samples);
+
+    //periodic windows are used so overlapping frames sum evenly
+    for(i=0; i < n_samples; i++){
+        float32_t x = two_pi * i / n_samples;
+        switch(window){
+        case RECTANGULAR: m_window[i] = 1.0f; break;
+        case HANN: m_window[i] = 0.5f - 0.5f*cosf(x); break;
+        case HAMMING: m_window[i] = 0.54f - 0.46f*cosf(x); break;
+        case BLACKMAN: m_window[i] = 0.42f - 0.5f*cosf(x) + 0.08f*cosf(2*x); break;
+        }
+    }
+}
+
+void StftF32::reset(){
+    m_fill = 0;
+    m_skip = 0;
+    m_row = 0;
+}
+
+u32 StftF32::process(SignalF32 & spectrogram, const SignalF32 & input){
+    return process(input.vector_data_const(), input.count(), spectrogram.vector_data(), spectrogram.count() / bins(), 0);
+}
+
+u32 StftF32::process(var::Ring<float32_t> & output, const SignalF32 & input){
+    return process(input.vector_data_const(), input.count(), 0, 0, &output);
+}
+
+u32 StftF32::process(const float32_t * input, u32 count, float32_t * rows, u32 row_count, var::Ring<float32_t> * ring){
+    const u32 n = m_frame.count();
+    u32 result = 0;
+    u32 i = 0;
+
+    if( n == 0 ){ return 0; }
+
+    while( i < count ){
+        u32 page;
+
+        if( m_skip ){
+            page = count - i;
+            if( page > m_skip ){ page = m_skip; }
+            m_skip -= page;
+            i += page;
+            continue;
+        }
+
+        page = count - i;
+        if( page > n - m_fill ){ page = n - m_fill; }
+        memcpy(m_frame.vector_data() + m_fill, input + i, page*sizeof(float32_t));
+        m_fill += page;
+        i += page;
+
+        if( m_fill == n ){
+            if( ring ){
+                calculate_frame(m_scratch.vector_data());
+                ring->write(m_scratch.vector_data_const(), bins());
+            } else if( row_count ){
+                calculate_frame(rows + m_row*bins());
+                m_row++;
+                if( m_row >= row_count ){ m_row = 0; }
+            }
+            result++;
+
+            //keep the overlap with the next frame
+            if( m_hop < n ){
+                memmove(m_frame.vector_data(), m_frame.vector_data_const() + m_hop, (n - m_hop)*sizeof(float32_t));
+                m_fill = n - m_hop;
+            } else {
+                m_fill = 0;
+                m_skip = m_hop - n;
+            }
+        }
+    }
+
+    return result;
+}
+
+void StftF32::calculate_frame(float32_t * row){
+    const u32 n = m_frame.count();
+    const u32 half = n/2;
+    const float32_t * frame = m_frame.vector_data_const();
+    const float32_t * window = m_window.vector_data_const();
+    float32_t * scratch = m_scratch.vector_data();
+    const float32_t * spectrum = m_spectrum.vector_data_const();
+    u32 i;
+
+    for(i=0; i < n; i++){
+        scratch[i] = frame[i] * window[i];
+    }
+
+    //the source is used as scratch memory by the transform
+    arm_dsp_api_f32()->rfft_fast(m_fft.instance(), scratch, m_spectrum.vector_data(), 0);
+
+    //DC and Nyquist are packed into the first complex value
+    row[0] = spectrum[0]*spectrum[0];
+    row[half] = spectrum[1]*spectrum[1];
+    for(i=1; i < half; i++){
+        row[i] = spectrum[2*i]*spectrum[2*i] + spectrum[2*i+1]*spectrum[2*i+1];
+    }
+
+    switch(m_output){
+    case MAGNITUDE:
+        for(i=0; i <= half; i++){ row[i] = sqrtf(row[i]); }
+        break;
+    case DECIBEL:
+        //-200dB floor avoids log10(0)
+        for(i=0; i <= half; i++){ row[i] = 10.0f*log10f(row[i] + 1e-20f); }
+        break;
+    case POWER:
+        break;
+    }
+}
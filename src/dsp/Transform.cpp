@@ -1,9 +1,48 @@
 #include <errno.h>
+#include <cmath>
 #include "dsp/Transform.hpp"
 #include "dsp/SignalData.hpp"
 
 using namespace dsp;
 
+namespace {
+void dct_convert(float32_t value, q15_t & output){
+    value = value < 0.0f ? value - 0.5f : value + 0.5f;
+    if( value > 32767.0f ){ value = 32767.0f; }
+    if( value < -32768.0f ){ value = -32768.0f; }
+    output = (q15_t)value;
+}
+
+void dct_convert(float32_t value, q31_t & output){
+    double result = value < 0.0f ? (double)value - 0.5 : (double)value + 0.5;
+    if( result > 2147483647.0 ){ result = 2147483647.0; }
+    if( result < -2147483648.0 ){ result = -2147483648.0; }
+    output = (q31_t)result;
+}
+
+//each block is converted to floating point, transformed then scaled back to fixed point
+template<typename T> int dct_fixed_transform(DctF32 & dct, SignalF32 & block_input, SignalF32 & block_output, float32_t input_scale, float32_t scale, T * output, const T * input, u32 count){
+    const u32 n = dct.samples();
+    u32 block;
+    u32 i;
+
+    for(block=0; block < count; block += n){
+        for(i=0; i < n; i++){
+            block_input[i] = input[block + i] * input_scale;
+        }
+
+        if( dct.transform(block_output, block_input) < 0 ){
+            return -1;
+        }
+
+        for(i=0; i < n; i++){
+            dct_convert(block_output[i] * scale, output[block + i]);
+        }
+    }
+    return 0;
+}
+}
+
 FftComplexQ15::FftComplexQ15(u32 n_samples){
     //cfft is initialized using a hack - RFFT init will grab the data needed
     if( arm_dsp_api_q15() && arm_dsp_api_q15()->rfft_init ){
@@ -75,3 +114,221 @@ FftRealF32::FftRealF32(u32 n_samples){
         set_error_number(ENOENT);
     }
 }
+
+//FftComplexF32 is initialized from the real FFT so it calculates n_samples/2 complex points
+DctF32::DctF32(u32 n_samples, enum dct_type type) : m_rfft(n_samples), m_cfft(n_samples){
+    const double pi = 3.14159265358979323846;
+    const u32 half = n_samples/2;
+    u32 i;
+
+    m_samples = 0;
+    m_type = type;
+
+    if( m_rfft.error_number() || m_cfft.error_number() ){
+        set_error_number(m_rfft.error_number() ? m_rfft.error_number() : m_cfft.error_number());
+        return;
+    }
+
+    if( (m_twiddle.resize(type == DCT_IV ? 2*n_samples : n_samples + 2) < 0) || (m_scratch.resize(n_samples) < 0) || (m_spectrum.resize(n_samples) < 0) ){
+        set_error_number(ENOMEM);
+        return;
+    }
+
+    if( type == DCT_IV ){
+        //pre-twiddle exp(-i*pi*(4n+1)/(4N)) then post-twiddle sqrt(2/N)*exp(-i*pi*k/N)
+        const double scale = sqrt(2.0 / n_samples);
+        for(i=0; i < half; i++){
+            double angle = pi * (4*i + 1) / (4.0 * n_samples);
+            m_twiddle[2*i] = cos(angle);
+            m_twiddle[2*i+1] = sin(angle);
+            angle = pi * i / n_samples;
+            m_twiddle[n_samples + 2*i] = scale * cos(angle);
+            m_twiddle[n_samples + 2*i+1] = scale * sin(angle);
+        }
+    } else {
+        //exp(-i*pi*k/(2N)) for k = 0 to N/2 (the upper half is mirrored)
+        for(i=0; i <= half; i++){
+            double angle = pi * i / (2.0 * n_samples);
+            m_twiddle[2*i] = cos(angle);
+            m_twiddle[2*i+1] = sin(angle);
+        }
+    }
+
+    m_samples = n_samples;
+}
+
+int DctF32::transform(SignalF32 & output, const SignalF32 & input){
+    const u32 n = m_samples;
+    u32 block;
+
+    if( (n == 0) || (input.count() % n) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( (output.count() != input.count()) && (output.resize(input.count()) < 0) ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    for(block=0; block < input.count(); block += n){
+        transform_block(output.vector_data() + block, input.vector_data_const() + block);
+    }
+    return 0;
+}
+
+void DctF32::transform_block(float32_t * output, const float32_t * input){
+    const u32 n = m_samples;
+    const u32 half = n/2;
+    const float32_t * twiddle = m_twiddle.vector_data_const();
+    float32_t * scratch = m_scratch.vector_data();
+    float32_t * spectrum = m_spectrum.vector_data();
+    u32 k;
+
+    //input is completely read into scratch memory before output is written so they can overlap
+    switch(m_type){
+    case DCT_II:
+    {
+        //Makhoul: even samples in order followed by odd samples reversed
+        const float32_t scale = sqrtf(2.0f / n);
+        for(k=0; k < half; k++){
+            scratch[k] = input[2*k];
+            scratch[n-1-k] = input[2*k+1];
+        }
+
+        arm_dsp_api_f32()->rfft_fast(m_rfft.instance(), scratch, spectrum, 0);
+
+        //X[k] = Re(exp(-i*pi*k/(2N)) * V[k]) with V[N-k] = conj(V[k])
+        output[0] = spectrum[0] * sqrtf(1.0f / n);
+        output[half] = spectrum[1] * twiddle[2*half] * scale;
+        for(k=1; k < half; k++){
+            float32_t real = spectrum[2*k];
+            float32_t imag = spectrum[2*k+1];
+            output[k] = (real*twiddle[2*k] + imag*twiddle[2*k+1]) * scale;
+            output[n-k] = (real*twiddle[2*k+1] - imag*twiddle[2*k]) * scale;
+        }
+        break;
+    }
+
+    case DCT_III:
+    {
+        //V[k] = exp(i*pi*k/(2N)) * (X[k] - i*X[N-k]) is the spectrum of the reordered output
+        const float32_t scale = sqrtf(n / 2.0f);
+        spectrum[0] = input[0] * sqrtf(n);
+        spectrum[1] = input[half] * scale * 1.41421356237f;
+        for(k=1; k < half; k++){
+            float32_t a = input[k] * scale;
+            float32_t b = input[n-k] * scale;
+            spectrum[2*k] = a*twiddle[2*k] + b*twiddle[2*k+1];
+            spectrum[2*k+1] = a*twiddle[2*k+1] - b*twiddle[2*k];
+        }
+
+        arm_dsp_api_f32()->rfft_fast(m_rfft.instance(), spectrum, scratch, 1);
+
+        for(k=0; k < half; k++){
+            output[2*k] = scratch[k];
+            output[2*k+1] = scratch[n-1-k];
+        }
+        break;
+    }
+
+    case DCT_IV:
+    {
+        //N/2 point complex FFT of (x[2n] + i*x[N-1-2n]) with pre and post twiddles
+        const float32_t * post = twiddle + n;
+        for(k=0; k < half; k++){
+            float32_t a = input[2*k];
+            float32_t b = input[n-1-2*k];
+            scratch[2*k] = a*twiddle[2*k] + b*twiddle[2*k+1];
+            scratch[2*k+1] = b*twiddle[2*k] - a*twiddle[2*k+1];
+        }
+
+        arm_dsp_api_f32()->cfft(m_cfft.instance(), scratch, 0, 1);
+
+        for(k=0; k < half; k++){
+            float32_t real = scratch[2*k];
+            float32_t imag = scratch[2*k+1];
+            output[2*k] = real*post[2*k] + imag*post[2*k+1];
+            output[n-1-2*k] = real*post[2*k+1] - imag*post[2*k];
+        }
+        break;
+    }
+    }
+}
+
+DctQ15::DctQ15(u32 n_samples, enum DctF32::dct_type type) : m_dct(n_samples, type){
+    //like the fixed point FFT, the forward transforms are scaled down by sqrt(N)
+    m_scale = 32768.0f;
+    if( type == DctF32::DCT_III ){
+        m_scale *= sqrtf(n_samples);
+    } else {
+        m_scale /= sqrtf(n_samples);
+    }
+
+    if( m_dct.error_number() ){
+        set_error_number(m_dct.error_number());
+        return;
+    }
+
+    if( (m_input.resize(n_samples) < 0) || (m_output.resize(n_samples) < 0) ){
+        set_error_number(ENOMEM);
+    }
+}
+
+int DctQ15::transform(SignalQ15 & output, const SignalQ15 & input){
+    const u32 n = samples();
+
+    if( (n == 0) || (input.count() % n) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( (output.count() != input.count()) && (output.resize(input.count()) < 0) ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( dct_fixed_transform(m_dct, m_input, m_output, 1.0f/32768.0f, m_scale, output.vector_data(), input.vector_data_const(), input.count()) < 0 ){
+        set_error_number(m_dct.error_number());
+        return -1;
+    }
+    return 0;
+}
+
+DctQ31::DctQ31(u32 n_samples, enum DctF32::dct_type type) : m_dct(n_samples, type){
+    m_scale = 2147483648.0f;
+    if( type == DctF32::DCT_III ){
+        m_scale *= sqrtf(n_samples);
+    } else {
+        m_scale /= sqrtf(n_samples);
+    }
+
+    if( m_dct.error_number() ){
+        set_error_number(m_dct.error_number());
+        return;
+    }
+
+    if( (m_input.resize(n_samples) < 0) || (m_output.resize(n_samples) < 0) ){
+        set_error_number(ENOMEM);
+    }
+}
+
+int DctQ31::transform(SignalQ31 & output, const SignalQ31 & input){
+    const u32 n = samples();
+
+    if( (n == 0) || (input.count() % n) ){
+        set_error_number(EINVAL);
+        return -1;
+    }
+
+    if( (output.count() != input.count()) && (output.resize(input.count()) < 0) ){
+        set_error_number(ENOMEM);
+        return -1;
+    }
+
+    if( dct_fixed_transform(m_dct, m_input, m_output, 1.0f/2147483648.0f, m_scale, output.vector_data(), input.vector_data_const(), input.count()) < 0 ){
+        set_error_number(m_dct.error_number());
+        return -1;
+    }
+    return 0;
+}
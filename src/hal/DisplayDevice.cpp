@@ -2,11 +2,15 @@
 
 #include "../../include/hal/DisplayDevice.hpp"
 
+#include <cstring>
+#include <errno.h>
 #include "sys.hpp"
 
 namespace hal {
 
-DisplayDevice::DisplayDevice(){}
+DisplayDevice::DisplayDevice(){
+	m_is_partial_refresh = false;
+}
 
 /*! \brief Pure virtual function to initialize the LCD */
 int DisplayDevice::init(const char * name){
@@ -36,9 +40,67 @@ int DisplayDevice::init(const char * name){
 
 /*! \brief Pure virtual function that copies local LCD memory to the LCD screen */
 void DisplayDevice::refresh() const {
+	if( m_is_partial_refresh ){
+		if( is_dirty() == false ){
+			return;
+		}
+		refresh_regions(dirty_regions(), dirty_count());
+	} else {
+		ioctl(I_DISPLAY_REFRESH);
+	}
+	clear_dirty();
+}
+
+void DisplayDevice::refresh_regions(const sg_region_t * regions, u8 count) const {
+	s32 x0, y0, x1, y1;
+	u8 i;
+
+	if( count == 0 ){
+		return;
+	}
+
+	//one window that contains all the regions
+	x0 = regions[0].point.x;
+	y0 = regions[0].point.y;
+	x1 = x0 + regions[0].dim.width;
+	y1 = y0 + regions[0].dim.height;
+	for(i=1; i < count; i++){
+		if( regions[i].point.x < x0 ){ x0 = regions[i].point.x; }
+		if( regions[i].point.y < y0 ){ y0 = regions[i].point.y; }
+		if( regions[i].point.x + regions[i].dim.width > x1 ){ x1 = regions[i].point.x + regions[i].dim.width; }
+		if( regions[i].point.y + regions[i].dim.height > y1 ){ y1 = regions[i].point.y + regions[i].dim.height; }
+	}
+
+	if( (x0 > 0) || (y0 > 0) || (x1 < width()) || (y1 < height()) ){
+		if( set_window(sg_region(sg_point(x0, y0), sg_dim(x1 - x0, y1 - y0))) == 0 ){
+			ioctl(I_DISPLAY_REFRESH);
+			//later refreshes (including refresh() without partial refresh) write the whole display
+			set_window(sg_region(sg_point(0,0), sg_dim(width(), height())));
+			return;
+		}
+	}
+
+	//the driver can't write a window (or the window is the whole display)
 	ioctl(I_DISPLAY_REFRESH);
 }
 
+int DisplayDevice::set_window(const sg_region_t & region) const {
+#if defined I_DISPLAY_SETATTR
+	display_attr_t attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.o_flags = DISPLAY_FLAG_SET_WINDOW;
+	attr.window_x = region.point.x;
+	attr.window_y = region.point.y;
+	attr.window_width = region.dim.width;
+	attr.window_height = region.dim.height;
+	return ioctl(I_DISPLAY_SETATTR, &attr);
+#else
+	//the display driver has no request for a window
+	errno = ENOTSUP;
+	return -1;
+#endif
+}
+
 int DisplayDevice::enable() const {
 	return ioctl(I_DISPLAY_ENABLE);
 }
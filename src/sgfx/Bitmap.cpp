@@ -6,6 +6,7 @@
 #include "calc/Rle.hpp"
 #include "sys/File.hpp"
 #include "sgfx/Bitmap.hpp"
+#include "sgfx/RleBitmap.hpp"
 
 using namespace sgfx;
 using namespace sys;
@@ -19,7 +20,10 @@ Region Bitmap::get_viewable_region() const {
 }
 
 void Bitmap::calc_members(sg_size_t w, sg_size_t h){
-	sg_api()->bmap_set_data(&m_bmap, (sg_bmap_data_t*)data_const(), sg_dim(w,h));
+	sgfx_api()->bmap_set_data(&m_bmap, (sg_bmap_data_t*)data_const(), sg_dim(w,h));
+	//new memory or size -- none of the old regions apply
+	m_dirty_count = 0;
+	mark_dirty();
 }
 
 void Bitmap::init_members(){
@@ -28,6 +32,7 @@ void Bitmap::init_members(){
 	m_bmap.pen.thickness = 1;
 	m_bmap.pen.o_flags = 0;
 	m_bmap.pen.color = 65535;
+	m_dirty_count = 0;
 }
 
 void Bitmap::set_data(sg_bmap_data_t * mem, sg_size_t w, sg_size_t h, bool readonly){
@@ -97,23 +102,127 @@ sg_point_t Bitmap::calc_center() const{
 
 bool Bitmap::set_size(sg_size_t w, sg_size_t h, sg_size_t offset){
 	if( calc_size(w,h) <= capacity() ){
-		sg_api()->bmap_set_data(&m_bmap, (sg_bmap_data_t*)data_const(), sg_dim(w,h));
+		calc_members(w,h);
 		return true;
 	}
 	return false;
 }
 
+void Bitmap::fill(unsigned char d){
+	Data::fill(d);
+	mark_dirty();
+}
+
+void Bitmap::mark_dirty_stroke(sg_point_t p1, sg_point_t p2) const {
+	s32 thickness = m_bmap.pen.thickness;
+	s32 x0 = (p1.x < p2.x ? p1.x : p2.x) - thickness;
+	s32 y0 = (p1.y < p2.y ? p1.y : p2.y) - thickness;
+	s32 x1 = (p1.x > p2.x ? p1.x : p2.x) + thickness;
+	s32 y1 = (p1.y > p2.y ? p1.y : p2.y) + thickness;
+	if( x0 < 0 ){ x0 = 0; }
+	if( y0 < 0 ){ y0 = 0; }
+	if( (x1 < x0) || (y1 < y0) ){
+		return;
+	}
+	mark_dirty(sg_region(sg_point(x0, y0), sg_dim(x1 - x0 + 1, y1 - y0 + 1)));
+}
+
+void Bitmap::mark_dirty(const sg_region_t & region) const {
+	s32 x0, y0, x1, y1; //x1 and y1 are exclusive
+	u32 best_growth;
+	u8 best;
+	u8 i;
+
+	x0 = region.point.x < 0 ? 0 : region.point.x;
+	y0 = region.point.y < 0 ? 0 : region.point.y;
+	x1 = region.point.x + region.dim.width;
+	y1 = region.point.y + region.dim.height;
+	if( x1 > width() ){ x1 = width(); }
+	if( y1 > height() ){ y1 = height(); }
+	if( (x0 >= x1) || (y0 >= y1) ){
+		return;
+	}
+
+	i = 0;
+	while( i < m_dirty_count ){
+		const sg_region_t & r = m_dirty[i];
+		if( (x0 <= r.point.x + r.dim.width) && (r.point.x <= x1) &&
+				(y0 <= r.point.y + r.dim.height) && (r.point.y <= y1) ){
+			//touching or overlapping -- merge then check the others against the larger region
+			if( r.point.x < x0 ){ x0 = r.point.x; }
+			if( r.point.y < y0 ){ y0 = r.point.y; }
+			if( r.point.x + r.dim.width > x1 ){ x1 = r.point.x + r.dim.width; }
+			if( r.point.y + r.dim.height > y1 ){ y1 = r.point.y + r.dim.height; }
+			m_dirty[i] = m_dirty[--m_dirty_count];
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+
+	if( m_dirty_count == DIRTY_REGION_MAX ){
+		//merge with the region whose area grows the least
+		best = 0;
+		best_growth = 0xffffffff;
+		for(i=0; i < m_dirty_count; i++){
+			const sg_region_t & r = m_dirty[i];
+			s32 ux0 = r.point.x < x0 ? r.point.x : x0;
+			s32 uy0 = r.point.y < y0 ? r.point.y : y0;
+			s32 ux1 = r.point.x + r.dim.width > x1 ? r.point.x + r.dim.width : x1;
+			s32 uy1 = r.point.y + r.dim.height > y1 ? r.point.y + r.dim.height : y1;
+			u32 growth = (u32)(ux1 - ux0)*(uy1 - uy0) - (u32)r.dim.width*r.dim.height;
+			if( growth < best_growth ){
+				best_growth = growth;
+				best = i;
+			}
+		}
+		sg_region_t merged = m_dirty[best];
+		m_dirty[best] = m_dirty[--m_dirty_count];
+		if( merged.point.x < x0 ){ x0 = merged.point.x; }
+		if( merged.point.y < y0 ){ y0 = merged.point.y; }
+		if( merged.point.x + merged.dim.width > x1 ){ x1 = merged.point.x + merged.dim.width; }
+		if( merged.point.y + merged.dim.height > y1 ){ y1 = merged.point.y + merged.dim.height; }
+		//the larger region may now touch others
+		mark_dirty(sg_region(sg_point(x0, y0), sg_dim(x1 - x0, y1 - y0)));
+		return;
+	}
+
+	m_dirty[m_dirty_count++] = sg_region(sg_point(x0, y0), sg_dim(x1 - x0, y1 - y0));
+}
+
+Region Bitmap::calc_dirty_bounds() const {
+	s32 x0, y0, x1, y1;
+	u8 i;
+
+	if( m_dirty_count == 0 ){
+		return Region(0, 0, 0, 0);
+	}
+
+	x0 = m_dirty[0].point.x;
+	y0 = m_dirty[0].point.y;
+	x1 = x0 + m_dirty[0].dim.width;
+	y1 = y0 + m_dirty[0].dim.height;
+	for(i=1; i < m_dirty_count; i++){
+		const sg_region_t & r = m_dirty[i];
+		if( r.point.x < x0 ){ x0 = r.point.x; }
+		if( r.point.y < y0 ){ y0 = r.point.y; }
+		if( r.point.x + r.dim.width > x1 ){ x1 = r.point.x + r.dim.width; }
+		if( r.point.y + r.dim.height > y1 ){ y1 = r.point.y + r.dim.height; }
+	}
+	return Region(x0, y0, x1 - x0, y1 - y0);
+}
+
 sg_bmap_data_t * Bitmap::data(sg_point_t p) const {
 
 	if( data() == 0 ){
 		return 0;
 	}
 
-	return sg_api()->bmap_data(bmap_const(),p);
+	return sgfx_api()->bmap_data(bmap_const(),p);
 }
 
 sg_bmap_data_t * Bitmap::data(sg_int_t x, sg_int_t y) const{
-	return sg_api()->bmap_data(bmap_const(), sg_point(x,y));
+	return sgfx_api()->bmap_data(bmap_const(), sg_point(x,y));
 }
 
 const sg_bmap_data_t * Bitmap::data_const(sg_point_t p) const {
@@ -140,7 +249,7 @@ int Bitmap::load(const char * path){
 		return -1;
 	}
 
-	if( (hdr.version != sg_api()->version) || (hdr.bits_per_pixel != sg_api()->bits_per_pixel) ){
+	if( (hdr.version != sgfx_api()->version) || (hdr.bits_per_pixel != sgfx_api()->bits_per_pixel) ){
 		f.close();
 		return -1;
 	}
@@ -183,7 +292,7 @@ Dim Bitmap::load_dim(const char * path){
 
 	f.close();
 
-	if( (hdr.version != sg_api()->version) || (hdr.bits_per_pixel != sg_api()->bits_per_pixel) ){
+	if( (hdr.version != sgfx_api()->version) || (hdr.bits_per_pixel != sgfx_api()->bits_per_pixel) ){
 		return Dim(0,0);
 	}
 
@@ -196,8 +305,8 @@ int Bitmap::save(const char * path) const{
 	hdr.width = width();
 	hdr.height = height();
 	hdr.size = calc_size(width(), height());
-	hdr.bits_per_pixel = sg_api()->bits_per_pixel;
-	hdr.version = sg_api()->version;
+	hdr.bits_per_pixel = sgfx_api()->bits_per_pixel;
+	hdr.version = sgfx_api()->version;
 
 	File f;
 	if( f.create(path, true) < 0 ){
@@ -223,33 +332,118 @@ int Bitmap::save(const char * path) const{
 	return 0;
 }
 
+int Bitmap::load_rle(const char * path){
+	sg_bmap_header_t hdr;
+	RleFile f;
+
+	if( f.open(path, File::READONLY) < 0 ){
+		return -1;
+	}
+
+	//the header is not encoded
+	if( f.File::read(&hdr, sizeof(hdr)) != sizeof(hdr) ){
+		f.close();
+		return -1;
+	}
+
+	if( (hdr.version != sgfx_api()->version) || (hdr.bits_per_pixel != sgfx_api()->bits_per_pixel) ){
+		f.close();
+		return -1;
+	}
+
+	if( set_size(hdr.width, hdr.height) == false ){
+		if( alloc(hdr.width, hdr.height) < 0 ){
+			f.close();
+			return -1;
+		}
+	}
+
+	if( f.read(data(), hdr.size) != (s32)hdr.size ){
+		f.close();
+		return -1;
+	}
+
+	return f.close();
+}
+
+int Bitmap::save_rle(const char * path) const {
+	sg_bmap_header_t hdr;
+	RleFile f;
+
+	hdr.width = width();
+	hdr.height = height();
+	hdr.size = calc_size(width(), height());
+	hdr.bits_per_pixel = sgfx_api()->bits_per_pixel;
+	hdr.version = sgfx_api()->version;
+
+	if( f.create(path, true) < 0 ){
+		return -1;
+	}
+
+	if( (f.File::write(&hdr, sizeof(hdr)) != sizeof(hdr)) ||
+			(f.write(data(), hdr.size) != (s32)hdr.size) ){
+		f.close();
+		unlink(path);
+		return -1;
+	}
+
+	//close() flushes the last encoded elements
+	if( f.close() < 0 ){
+		unlink(path);
+		return -1;
+	}
+
+	return 0;
+}
+
+int Bitmap::decode_rle(const void * src, u32 nbyte){
+	s32 size = calc_size(width(), height());
+	if( data() == 0 ){
+		return -1;
+	}
+	Rle::decode(data(), size, src, nbyte);
+	mark_dirty();
+	if( size != (s32)calc_size(width(), height()) ){
+		return -1;
+	}
+	return 0;
+}
+
+void Bitmap::draw_bitmap(sg_point_t p_dest, const RleBitmap & src) const {
+	src.draw(*this, p_dest);
+}
+
+void Bitmap::draw_sub_bitmap(sg_point_t p_dest, const RleBitmap & src, const sg_region_t & region_src) const {
+	src.draw(*this, p_dest, region_src);
+}
+
 void Bitmap::show() const{
-	//sg_api()->show(bmap_const());
+	//sgfx_api()->show(bmap_const());
 	sg_size_t i,j;
 
 	sg_color_t color;
 	sg_cursor_t y_cursor;
 	sg_cursor_t x_cursor;
 
-	sg_api()->cursor_set(&y_cursor, bmap_const(), sg_point(0,0));
+	sgfx_api()->cursor_set(&y_cursor, bmap_const(), sg_point(0,0));
 
 	for(i=0; i < bmap_const()->dim.height; i++){
 		sg_cursor_copy(&x_cursor, &y_cursor);
 		for(j=0; j < bmap_const()->dim.width; j++){
-			color = sg_api()->cursor_get_pixel(&x_cursor);
-			if( sg_api()->bits_per_pixel > 8 ){
+			color = sgfx_api()->cursor_get_pixel(&x_cursor);
+			if( sgfx_api()->bits_per_pixel > 8 ){
                 ::printf("%04X", color);
-			} else if(sg_api()->bits_per_pixel > 4){
+			} else if(sgfx_api()->bits_per_pixel > 4){
                 ::printf("%02X", color);
 			} else {
                 ::printf("%X", color);
 			}
-			if( (j < bmap_const()->dim.width - 1) && (sg_api()->bits_per_pixel > 4)){
+			if( (j < bmap_const()->dim.width - 1) && (sgfx_api()->bits_per_pixel > 4)){
                 ::printf(" ");
 			}
 		}
         ::printf("\n");
-		sg_api()->cursor_inc_y(&y_cursor);
+		sgfx_api()->cursor_inc_y(&y_cursor);
 	}
 }
 
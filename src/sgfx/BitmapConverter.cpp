@@ -0,0 +1,402 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cerrno>
+#include <cstring>
+
+#if defined __link && defined __SSE2__
+#include <emmintrin.h>
+#define BITMAPCONVERTER_SSE2 1
+#endif
+
+#include "sgfx/BitmapConverter.hpp"
+
+using namespace sgfx;
+
+namespace {
+
+//4x4 ordered dither matrix (indexed by y & 3 then x & 3)
+const u8 bayer_matrix[4][4] = {
+	{ 0,  8,  2, 10},
+	{12,  4, 14,  6},
+	{ 3, 11,  1,  9},
+	{15,  7, 13,  5}
+};
+
+bool is_valid_depth(u8 bits_per_pixel){
+	switch(bits_per_pixel){
+	case 1:
+	case 2:
+	case 4:
+	case 8:
+	case 16:
+	case 24:
+	case 32:
+		return true;
+	}
+	return false;
+}
+
+inline bool is_level_depth(u8 bits_per_pixel){
+	return bits_per_pixel <= 8;
+}
+
+inline u32 get_value(const u8 * row, u32 x, u8 bits_per_pixel){
+	u32 bit;
+	switch(bits_per_pixel){
+	case 8:
+		return row[x];
+	case 16:
+		return row[x*2] | (row[x*2+1] << 8);
+	case 24:
+		return row[x*3] | (row[x*3+1] << 8) | (row[x*3+2] << 16);
+	case 32:
+		return row[x*4] | (row[x*4+1] << 8) | (row[x*4+2] << 16) | ((u32)row[x*4+3] << 24);
+	}
+	bit = x * bits_per_pixel;
+	return (row[bit / 8] >> (bit % 8)) & ((1<<bits_per_pixel)-1);
+}
+
+inline void set_value(u8 * row, u32 x, u8 bits_per_pixel, u32 value){
+	u32 bit;
+	u8 mask;
+	switch(bits_per_pixel){
+	case 8:
+		row[x] = value;
+		return;
+	case 16:
+		row[x*2] = value;
+		row[x*2+1] = value >> 8;
+		return;
+	case 24:
+		row[x*3] = value;
+		row[x*3+1] = value >> 8;
+		row[x*3+2] = value >> 16;
+		return;
+	case 32:
+		row[x*4] = value;
+		row[x*4+1] = value >> 8;
+		row[x*4+2] = value >> 16;
+		row[x*4+3] = value >> 24;
+		return;
+	}
+	bit = x * bits_per_pixel;
+	mask = ((1<<bits_per_pixel)-1) << (bit % 8);
+	row[bit / 8] = (row[bit / 8] & ~mask) | ((value << (bit % 8)) & mask);
+}
+
+//repeats the bits of a level to make an 8-bit gray level
+inline u8 level_to_gray(u32 value, u8 bits_per_pixel){
+	switch(bits_per_pixel){
+	case 1: return value ? 0xff : 0;
+	case 2: return value * 0x55;
+	case 4: return value * 0x11;
+	}
+	return value;
+}
+
+inline u32 to_rgb888(u32 value, u8 bits_per_pixel){
+	u32 r, g, b;
+	if( is_level_depth(bits_per_pixel) ){
+		return level_to_gray(value, bits_per_pixel) * 0x010101;
+	}
+
+	if( bits_per_pixel == 16 ){
+		r = (value >> 11) & 0x1f;
+		g = (value >> 5) & 0x3f;
+		b = value & 0x1f;
+		r = (r << 3) | (r >> 2);
+		g = (g << 2) | (g >> 4);
+		b = (b << 3) | (b >> 2);
+		return (r << 16) | (g << 8) | b;
+	}
+
+	return value & 0x00ffffff;
+}
+
+inline u8 to_gray(u32 value, u8 bits_per_pixel){
+	u32 rgb;
+	if( is_level_depth(bits_per_pixel) ){
+		return level_to_gray(value, bits_per_pixel);
+	}
+	rgb = to_rgb888(value, bits_per_pixel);
+	return (((rgb >> 16) & 0xff) * 77 + ((rgb >> 8) & 0xff) * 150 + (rgb & 0xff) * 29) >> 8;
+}
+
+inline u32 from_rgb888(u32 rgb, u8 bits_per_pixel){
+	if( is_level_depth(bits_per_pixel) ){
+		return to_gray(rgb, 24) >> (8 - bits_per_pixel);
+	}
+
+	if( bits_per_pixel == 16 ){
+		return ((rgb >> 8) & 0xf800) | ((rgb >> 5) & 0x07e0) | ((rgb >> 3) & 0x001f);
+	}
+
+	return rgb & 0x00ffffff;
+}
+
+inline u32 convert_value(u32 value, u8 dest_bpp, u8 src_bpp){
+	if( dest_bpp == src_bpp ){
+		return value;
+	}
+
+	if( is_level_depth(dest_bpp) && is_level_depth(src_bpp) ){
+		return level_to_gray(value, src_bpp) >> (8 - dest_bpp);
+	}
+
+	return from_rgb888(to_rgb888(value, src_bpp), dest_bpp);
+}
+
+}
+
+BitmapConverter::BitmapConverter(){
+	m_operation = OPERATION_CONVERT;
+	m_palette = 0;
+	m_level = 128;
+	m_table_src_bpp = 0;
+	m_table_dest_bpp = 0;
+}
+
+BitmapConverter::buffer_t BitmapConverter::buffer(const Bitmap & bitmap){
+	buffer_t result;
+	result.data = bitmap.data();
+	result.stride = bitmap.columns() * sizeof(sg_bmap_data_t);
+	result.width = bitmap.width();
+	result.height = bitmap.height();
+	result.bits_per_pixel = Bitmap::bits_per_pixel();
+	return result;
+}
+
+BitmapConverter::buffer_t BitmapConverter::buffer(void * data, u8 bits_per_pixel, sg_size_t width, sg_size_t height){
+	buffer_t result;
+	result.data = data;
+	result.stride = ((width * bits_per_pixel + 31) / 32) * 4;
+	result.width = width;
+	result.height = height;
+	result.bits_per_pixel = bits_per_pixel;
+	return result;
+}
+
+int BitmapConverter::convert(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src){
+	return run(OPERATION_CONVERT, dest, p_dest, src, region_src);
+}
+
+int BitmapConverter::lookup(const buffer_t & dest, sg_point_t p_dest, const display_palette_t & palette, const buffer_t & src, const sg_region_t & region_src){
+	if( (palette.colors == 0) ||
+			(palette.pixel_size == 0) ||
+			(palette.pixel_size > 4) ||
+			(palette.pixel_size * 8 != dest.bits_per_pixel) ||
+			(is_level_depth(src.bits_per_pixel) == false) ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+
+	m_palette = &palette;
+	return run(OPERATION_LOOKUP, dest, p_dest, src, region_src);
+}
+
+int BitmapConverter::dither(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src){
+	if( is_level_depth(dest.bits_per_pixel) == false ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+	return run(OPERATION_DITHER, dest, p_dest, src, region_src);
+}
+
+int BitmapConverter::threshold(const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src, u8 level){
+	m_level = level;
+	return run(OPERATION_THRESHOLD, dest, p_dest, src, region_src);
+}
+
+int BitmapConverter::run(enum operation value, const buffer_t & dest, sg_point_t p_dest, const buffer_t & src, const sg_region_t & region_src){
+	s32 x0, y0, x1, y1;
+	s32 dest_x, dest_y;
+	s32 y;
+	row_t row;
+	u32 start;
+
+	if( (is_valid_depth(dest.bits_per_pixel) == false) ||
+			(is_valid_depth(src.bits_per_pixel) == false) ||
+			(dest.data == 0) || (src.data == 0) ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+
+	m_operation = value;
+
+	//clip the source region to the source then to the destination
+	x0 = region_src.point.x;
+	y0 = region_src.point.y;
+	x1 = x0 + region_src.dim.width;
+	y1 = y0 + region_src.dim.height;
+	dest_x = p_dest.x;
+	dest_y = p_dest.y;
+	if( x0 < 0 ){ dest_x -= x0; x0 = 0; }
+	if( y0 < 0 ){ dest_y -= y0; y0 = 0; }
+	if( x1 > src.width ){ x1 = src.width; }
+	if( y1 > src.height ){ y1 = src.height; }
+	if( dest_x < 0 ){ x0 -= dest_x; dest_x = 0; }
+	if( dest_y < 0 ){ y0 -= dest_y; dest_y = 0; }
+	if( x1 - x0 > dest.width - dest_x ){ x1 = x0 + dest.width - dest_x; }
+	if( y1 - y0 > dest.height - dest_y ){ y1 = y0 + dest.height - dest_y; }
+
+	if( (x0 >= x1) || (y0 >= y1) ){
+		return 0;
+	}
+
+	row.src_x = x0;
+	row.dest_x = dest_x;
+	row.width = x1 - x0;
+
+	for(y = y0; y < y1; y++, dest_y++){
+		row.src = (const u8*)src.data + y * src.stride;
+		row.dest = (u8*)dest.data + dest_y * dest.stride;
+		row.dest_y = dest_y;
+		start = convert_row_fast(row, dest.bits_per_pixel, src.bits_per_pixel);
+		if( start < row.width ){
+			convert_pixels(row, start, dest.bits_per_pixel, src.bits_per_pixel);
+		}
+	}
+
+	return 0;
+}
+
+int BitmapConverter::build_table(u8 dest_bpp, u8 src_bpp){
+	u32 i;
+	u32 j;
+	u32 pixels_per_byte = 8 / src_bpp;
+	u64 entry;
+	u8 byte;
+
+	if( (m_table_dest_bpp == dest_bpp) && (m_table_src_bpp == src_bpp) ){
+		return 0;
+	}
+
+	m_table_dest_bpp = 0;
+	m_table_src_bpp = 0;
+	if( m_table.resize(256) < 0 ){
+		return -1;
+	}
+
+	for(i=0; i < 256; i++){
+		entry = 0;
+		byte = i;
+		for(j=0; j < pixels_per_byte; j++){
+			entry |= (u64)convert_value(get_value(&byte, j, src_bpp), dest_bpp, src_bpp) << (j * dest_bpp);
+		}
+		m_table[i] = entry;
+	}
+
+	m_table_dest_bpp = dest_bpp;
+	m_table_src_bpp = src_bpp;
+	return 0;
+}
+
+u32 BitmapConverter::convert_row_fast(const row_t & row, u8 dest_bpp, u8 src_bpp){
+	u32 count;
+	u32 i;
+
+	if( m_operation == OPERATION_CONVERT ){
+
+		//the fast paths need whole source and destination bytes
+		if( ((row.src_x * src_bpp) % 8) || ((row.dest_x * dest_bpp) % 8) ){
+			return 0;
+		}
+
+		if( dest_bpp == src_bpp ){
+			count = (row.width * src_bpp) / 8;
+			memcpy(row.dest + (row.dest_x * dest_bpp) / 8, row.src + (row.src_x * src_bpp) / 8, count);
+			return (count * 8) / src_bpp;
+		}
+
+		//expansion: each source byte becomes (dest_bpp / src_bpp) bytes
+		if( is_level_depth(src_bpp) && (dest_bpp > src_bpp) && ((8 / src_bpp) * dest_bpp <= 64) ){
+			const u8 * src;
+			u8 * dest;
+			u32 nbyte = dest_bpp / src_bpp;
+			u64 entry;
+
+			if( build_table(dest_bpp, src_bpp) < 0 ){
+				return 0;
+			}
+
+			count = (row.width * src_bpp) / 8;
+			src = row.src + (row.src_x * src_bpp) / 8;
+			dest = row.dest + (row.dest_x * dest_bpp) / 8;
+			for(i=0; i < count; i++){
+				entry = m_table[src[i]];
+				memcpy(dest, &entry, nbyte); //pixels are little endian
+				dest += nbyte;
+			}
+			return (count * 8) / src_bpp;
+		}
+	}
+
+#if defined BITMAPCONVERTER_SSE2
+	//8bpp to 1bpp (pack, threshold and dither) compares 16 pixels at a time
+	if( (dest_bpp == 1) && (src_bpp == 8) && (row.dest_x % 8 == 0) && (m_operation != OPERATION_LOOKUP) ){
+		u8 levels[16];
+		const u8 * src = row.src + row.src_x;
+		u8 * dest = row.dest + row.dest_x / 8;
+		__m128i bias = _mm_set1_epi8((char)0x80);
+		__m128i level;
+		__m128i value;
+		u32 mask;
+
+		for(i=0; i < 16; i++){
+			if( m_operation == OPERATION_DITHER ){
+				//dest_x is a multiple of 8 so lane i has the same matrix column as the destination
+				levels[i] = 255 - ((2*bayer_matrix[row.dest_y & 3][i & 3] + 1) * 255) / 32;
+			} else if( m_operation == OPERATION_THRESHOLD ){
+				levels[i] = m_level;
+			} else {
+				levels[i] = 128; //packing keeps the top bit
+			}
+		}
+
+		//compare as signed bytes: (a ^ 0x80) < (b ^ 0x80) is the same as a < b unsigned
+		level = _mm_xor_si128(_mm_loadu_si128((const __m128i*)levels), bias);
+		count = row.width / 16;
+		for(i=0; i < count; i++){
+			value = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src + i*16)), bias);
+			mask = ~_mm_movemask_epi8(_mm_cmplt_epi8(value, level));
+			dest[i*2] = mask;
+			dest[i*2+1] = mask >> 8;
+		}
+		return count * 16;
+	}
+#endif
+
+	return 0;
+}
+
+void BitmapConverter::convert_pixels(const row_t & row, u32 start, u8 dest_bpp, u8 src_bpp){
+	u32 i;
+	u32 value;
+	u32 levels = is_level_depth(dest_bpp) ? (1<<dest_bpp) - 1 : 0;
+	u32 white = from_rgb888(0x00ffffff, dest_bpp);
+	const u8 * colors = m_palette ? (const u8*)m_palette->colors : 0;
+	const u8 * matrix_row = bayer_matrix[row.dest_y & 3];
+
+	for(i=start; i < row.width; i++){
+		value = get_value(row.src, row.src_x + i, src_bpp);
+		switch(m_operation){
+		case OPERATION_CONVERT:
+			value = convert_value(value, dest_bpp, src_bpp);
+			break;
+		case OPERATION_LOOKUP:
+			if( value < m_palette->count ){
+				value = get_value(colors, value, dest_bpp);
+			} else {
+				value = 0;
+			}
+			break;
+		case OPERATION_DITHER:
+			value = (to_gray(value, src_bpp) * levels + ((2*matrix_row[(row.dest_x + i) & 3] + 1) * 255) / 32) / 255;
+			break;
+		case OPERATION_THRESHOLD:
+			value = to_gray(value, src_bpp) >= m_level ? white : 0;
+			break;
+		}
+		set_value(row.dest, row.dest_x + i, dest_bpp, value);
+	}
+}
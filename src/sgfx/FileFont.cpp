@@ -1,32 +1,79 @@
 //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
 
-
+#include <cstdlib>
 #include "sgfx/FileFont.hpp"
 using namespace sgfx;
 using namespace sys;
 
+static u32 kerning_key(u16 first, u16 second){
+	return ((u32)first << 16) | second;
+}
+
+static int compare_kerning_pairs(const void * a, const void * b){
+	u32 key_a = kerning_key(((const sg_font_kerning_pair_t*)a)->first, ((const sg_font_kerning_pair_t*)a)->second);
+	u32 key_b = kerning_key(((const sg_font_kerning_pair_t*)b)->first, ((const sg_font_kerning_pair_t*)b)->second);
+	if( key_a < key_b ){ return -1; }
+	if( key_a > key_b ){ return 1; }
+	return 0;
+}
+
 FileFont::FileFont() {
 	m_kerning_pairs = 0;
+	m_chars = 0;
+	m_canvas_cache = 0;
+	m_canvas_cache_size = 0;
+	m_canvas_cache_request = DEFAULT_CANVAS_CACHE_SIZE;
+	m_canvas_count = 0;
+	m_canvas_clock = 0;
+	m_canvas_loads = 0;
 }
 
 FileFont::FileFont(const char * name, int offset) {
 	m_kerning_pairs = 0;
+	m_chars = 0;
+	m_canvas_cache = 0;
+	m_canvas_cache_size = 0;
+	m_canvas_cache_request = DEFAULT_CANVAS_CACHE_SIZE;
+	m_canvas_count = 0;
+	m_canvas_clock = 0;
+	m_canvas_loads = 0;
 	set_file(name, offset);
 }
 
 FileFont::~FileFont(){
+	free_canvas_cache();
+	free_tables();
+	update_generation();
+	m_file.close();
+}
+
+void FileFont::free_tables(){
 	if( m_kerning_pairs != 0 ){
 		free(m_kerning_pairs);
+		m_kerning_pairs = 0;
 	}
-	m_file.close();
+
+	if( m_chars != 0 ){
+		free(m_chars);
+		m_chars = 0;
+	}
+}
+
+void FileFont::free_canvas_cache(){
+	if( m_canvas_cache != 0 ){
+		delete [] m_canvas_cache;
+		m_canvas_cache = 0;
+	}
+	m_canvas_cache_size = 0;
 }
 
 int FileFont::set_file(const char * name, int offset){
 	u32 pair_size;
+	u32 char_size;
+	u32 i;
 
-	if( m_kerning_pairs ){
-		free(m_kerning_pairs);
-	}
+	free_canvas_cache();
+	free_tables();
 
 	//close if not already closed
 	m_file.close();
@@ -40,23 +87,45 @@ int FileFont::set_file(const char * name, int offset){
 		return -1;
 	}
 
-	m_canvas.free();
-	if( m_canvas.alloc(m_hdr.canvas_width, m_hdr.canvas_height) < 0 ){
-		return -1;
-	}
 	m_offset = offset;
-	m_current_canvas = 255;
 	m_canvas_start = m_hdr.size;
-	m_canvas_size = m_canvas.calc_size();
+	m_canvas_size = Bitmap::calc_size(m_hdr.canvas_width, m_hdr.canvas_height);
 
 	pair_size = sizeof(sg_font_kerning_pair_t)*m_hdr.kerning_pairs;
-
 	m_kerning_pairs = (sg_font_kerning_pair_t*)malloc(pair_size);
-
 	if( m_kerning_pairs ){
-		m_file.read(m_offset + sizeof(sg_font_header_t), m_kerning_pairs, pair_size);
+		if( m_file.read(m_offset + sizeof(sg_font_header_t), m_kerning_pairs, pair_size) != (int)pair_size ){
+			free(m_kerning_pairs);
+			m_kerning_pairs = 0;
+		} else {
+			//sorted so load_kerning() can use a binary search
+			qsort(m_kerning_pairs, m_hdr.kerning_pairs, sizeof(sg_font_kerning_pair_t), compare_kerning_pairs);
+		}
+	}
+
+	//all the character descriptors are read at once (load_char() falls back to the file if this fails)
+	char_size = sizeof(sg_font_char_t)*m_hdr.num_chars;
+	m_chars = (sg_font_char_t*)malloc(char_size);
+	if( m_chars ){
+		if( m_file.read(m_offset + sizeof(sg_font_header_t) + pair_size, m_chars, char_size) != (int)char_size ){
+			free(m_chars);
+			m_chars = 0;
+		}
+	}
+
+	m_canvas_count = 0;
+	if( m_chars ){
+		for(i=0; i < m_hdr.num_chars; i++){
+			if( m_chars[i].canvas_idx >= m_canvas_count ){
+				m_canvas_count = m_chars[i].canvas_idx + 1;
+			}
+		}
+	} else {
+		m_canvas_count = 256;
 	}
 
+	set_canvas_cache_size(m_canvas_cache_request);
+
 	set_space_size(m_hdr.max_word_width);
 	set_letter_spacing(m_hdr.max_height/8);
 
@@ -64,6 +133,37 @@ int FileFont::set_file(const char * name, int offset){
 
 }
 
+void FileFont::set_canvas_cache_size(u8 count){
+	u8 i;
+
+	if( count == 0 ){
+		count = 1;
+	}
+
+	m_canvas_cache_request = count;
+	free_canvas_cache();
+
+	if( m_canvas_count == 0 ){
+		return;
+	}
+
+	if( count > m_canvas_count ){
+		count = m_canvas_count;
+	}
+
+	//bitmaps are allocated when a canvas is first loaded
+	m_canvas_cache = new canvas_cache_t[count];
+	if( m_canvas_cache == 0 ){
+		return;
+	}
+
+	for(i=0; i < count; i++){
+		m_canvas_cache[i].canvas_idx = CANVAS_NONE;
+		m_canvas_cache[i].last_used = 0;
+	}
+	m_canvas_cache_size = count;
+}
+
 sg_size_t FileFont::get_height() const { return m_hdr.max_height; }
 sg_size_t FileFont::get_width() const { return m_hdr.max_word_width*32; }
 
@@ -78,10 +178,15 @@ int FileFont::load_char(sg_font_char_t & ch, char c, bool ascii) const {
 		ind = c;
 	}
 
-	if( ind < 0 ){
+	if( (ind < 0) || (ind >= m_hdr.num_chars) ){
 		return -1;
 	}
 
+	if( m_chars ){
+		ch = m_chars[ind];
+		return 0;
+	}
+
 	offset = m_offset + sizeof(sg_font_header_t) + sizeof(sg_font_kerning_pair_t)*m_hdr.kerning_pairs + ind*sizeof(sg_font_char_t);
 	if( (ret = m_file.read(offset, &ch, sizeof(ch))) != sizeof(ch) ){
 		return -1;
@@ -90,38 +195,76 @@ int FileFont::load_char(sg_font_char_t & ch, char c, bool ascii) const {
 }
 
 int FileFont::load_kerning(u16 first, u16 second) const {
-	int kerning_count = m_hdr.kerning_pairs;
-	int i;
+	const u32 key = kerning_key(first, second);
+	int low = 0;
+	int high = (int)m_hdr.kerning_pairs - 1;
 
 	if( m_kerning_pairs == 0 ){
 		return 0;
 	}
 
-	for(i=0; i < kerning_count; i++){
-		if( (m_kerning_pairs[i].first == first) && (m_kerning_pairs[i].second == second) ){
-			return m_kerning_pairs[i].kerning;
+	while( low <= high ){
+		int middle = (low + high) / 2;
+		u32 value = kerning_key(m_kerning_pairs[middle].first, m_kerning_pairs[middle].second);
+		if( value == key ){
+			return m_kerning_pairs[middle].kerning;
+		} else if( value < key ){
+			low = middle + 1;
+		} else {
+			high = middle - 1;
 		}
 	}
 
 	return 0;
 }
 
-void FileFont::draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const {
+const Bitmap * FileFont::load_canvas(u8 canvas_idx) const {
+	u8 i;
+	u8 oldest = 0;
 	u32 canvas_offset;
-	if( ch.canvas_idx != m_current_canvas ){
-		canvas_offset = m_canvas_start + ch.canvas_idx*m_canvas_size;
-		if( m_file.read(m_offset + canvas_offset, m_canvas.data(), m_canvas_size) != (int)m_canvas_size ){
-			printf("failed to load canvas %ld\n", canvas_offset);
-			return;
+
+	if( m_canvas_cache_size == 0 ){
+		return 0;
+	}
+
+	m_canvas_clock++;
+
+	for(i=0; i < m_canvas_cache_size; i++){
+		if( m_canvas_cache[i].canvas_idx == canvas_idx ){
+			m_canvas_cache[i].last_used = m_canvas_clock;
+			return &m_canvas_cache[i].canvas;
 		}
-		m_current_canvas = ch.canvas_idx;
+
+		//unused entries have last_used == 0 and are taken first
+		if( m_canvas_cache[i].last_used < m_canvas_cache[oldest].last_used ){
+			oldest = i;
+		}
+	}
+
+	canvas_cache_t & entry = m_canvas_cache[oldest];
+	if( (entry.canvas.data() == 0) && (entry.canvas.alloc(m_hdr.canvas_width, m_hdr.canvas_height) < 0) ){
+		return 0;
+	}
+
+	canvas_offset = m_canvas_start + canvas_idx*m_canvas_size;
+	m_canvas_loads++;
+	if( m_file.read(m_offset + canvas_offset, entry.canvas.data(), m_canvas_size) != (int)m_canvas_size ){
+		entry.canvas_idx = CANVAS_NONE;
+		entry.last_used = 0;
+		return 0;
 	}
 
-	printf("Loaded canvas %d %ld (%d,%d %dx%d)\n",
-			m_current_canvas,
-			m_canvas_start + ch.canvas_idx*m_canvas_size,
-			ch.canvas_x, ch.canvas_y, ch.width, ch.height);
+	entry.canvas_idx = canvas_idx;
+	entry.last_used = m_canvas_clock;
+	return &entry.canvas;
+}
+
+void FileFont::draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const {
+	const Bitmap * canvas = load_canvas(ch.canvas_idx);
+	if( canvas == 0 ){
+		return;
+	}
 
 	Region region(ch.canvas_x, ch.canvas_y, ch.width, ch.height);
-	dest.draw_sub_bitmap(point, m_canvas, region);
+	dest.draw_sub_bitmap(point, *canvas, region);
 }
@@ -20,11 +20,18 @@ int Font::to_charset(char ascii){
 }
 
 
+u32 Font::m_generation_count = 0;
+
 Font::Font() {
 	//m_bitmap = 0;
 	m_offset = 0;
 	m_space_size = 8;
 	m_letter_spacing = 1;
+	update_generation();
+}
+
+void Font::update_generation(){
+	m_generation = ++m_generation_count;
 }
 
 int Font::calc_len(const char * str) const {
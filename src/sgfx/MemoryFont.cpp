@@ -20,6 +20,7 @@ MemoryFont::MemoryFont(const void * ptr) {
 void MemoryFont::set_font_memory(const void * ptr){
 	const sg_font_header_t * hdr_ptr;
 	m_font = ptr;
+	update_generation();
 	if( m_font != 0 ){
 		hdr_ptr = (const sg_font_header_t*)m_font;
 		memcpy(&m_hdr, hdr_ptr, sizeof(sg_font_header_t));
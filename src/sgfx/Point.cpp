@@ -16,12 +16,12 @@ Point Point::operator*(float f) const {
 
 Point Point::operator+(const sg_point_t & a) const{
 	Point p(*this);
-	sg_api()->point_shift(&p.m_value, a);
+	sgfx_api()->point_shift(&p.m_value, a);
 	return p;
 }
 
 Point Point::operator-(const sg_point_t & a) const {
 	Point p(*this);
-	sg_api()->point_subtract(&p.m_value, &a);
+	sgfx_api()->point_subtract(&p.m_value, &a);
 	return p;
 }
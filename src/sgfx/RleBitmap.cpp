@@ -0,0 +1,363 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#include "sys/File.hpp"
+#include "sgfx/RleBitmap.hpp"
+
+using namespace sgfx;
+using namespace sys;
+
+namespace {
+
+enum {
+	LITERAL_MAX = 128,
+	RUN_MIN = 2,
+	RUN_MAX = 129
+};
+
+//the unit is one pixel for 16 and 32 bpp (so colors repeat) or one byte
+u32 rle_unit(){
+	u32 bits_per_pixel = api::SgfxObject::sgfx_api()->bits_per_pixel;
+	return bits_per_pixel > 8 ? bits_per_pixel / 8 : 1;
+}
+
+u32 rle_calc_run(const u8 * src, u32 count, u32 unit){
+	u32 run = 1;
+	while( (run < count) && (run < RUN_MAX) && (memcmp(src, src + run*unit, unit) == 0) ){
+		run++;
+	}
+	return run;
+}
+
+//PackBits: a control byte below 128 is followed by (control + 1) literal units, otherwise
+//the next unit is repeated (control - 126) times -- returns the encoded size (dest can be null)
+u32 rle_encode_row(u8 * dest, const u8 * src, u32 nbyte, u32 unit){
+	u32 count = nbyte / unit;
+	u32 encoded = 0;
+	u32 i = 0;
+	u32 run;
+
+	while( i < count ){
+		run = rle_calc_run(src + i*unit, count - i, unit);
+		if( run >= RUN_MIN ){
+			if( dest ){
+				dest[encoded] = run + 126;
+				memcpy(dest + encoded + 1, src + i*unit, unit);
+			}
+			encoded += 1 + unit;
+			i += run;
+		} else {
+			//collect literals until the next run
+			u32 start = i;
+			do {
+				i++;
+			} while( (i < count) && (i - start < LITERAL_MAX) &&
+					(rle_calc_run(src + i*unit, count - i, unit) < RUN_MIN) );
+			if( dest ){
+				dest[encoded] = i - start - 1;
+				memcpy(dest + encoded + 1, src + start*unit, (i - start)*unit);
+			}
+			encoded += 1 + (i - start)*unit;
+		}
+	}
+
+	return encoded;
+}
+
+int rle_decode_row(u8 * dest, u32 nbyte, const u8 * src, u32 src_size, u32 unit){
+	u32 decoded = 0;
+	u32 i = 0;
+	u32 count;
+	u32 k;
+
+	while( (i < src_size) && (decoded < nbyte) ){
+		u8 control = src[i++];
+		if( control < LITERAL_MAX ){
+			count = (control + 1)*unit;
+			if( (decoded + count > nbyte) || (i + count > src_size) ){
+				return -1;
+			}
+			memcpy(dest + decoded, src + i, count);
+			i += count;
+			decoded += count;
+		} else {
+			count = control - 126;
+			if( (decoded + count*unit > nbyte) || (i + unit > src_size) ){
+				return -1;
+			}
+			if( unit == 1 ){
+				memset(dest + decoded, src[i], count);
+				decoded += count;
+			} else {
+				for(k=0; k < count; k++){
+					memcpy(dest + decoded, src + i, unit);
+					decoded += unit;
+				}
+			}
+			i += unit;
+		}
+	}
+
+	return decoded == nbyte ? 0 : -1;
+}
+
+}
+
+RleBitmap::RleBitmap(){
+	m_is_valid = false;
+}
+
+RleBitmap::RleBitmap(const void * data, u32 nbyte){
+	m_is_valid = false;
+	set_data(data, nbyte);
+}
+
+bool RleBitmap::validate(u32 nbyte){
+	const header_t * hdr = header();
+	const u32 * table;
+	u32 table_size;
+	u32 i;
+
+	m_is_valid = false;
+
+	if( nbyte < sizeof(header_t) ){
+		return false;
+	}
+
+	if( (hdr->signature != SIGNATURE) ||
+			(hdr->bmap.version != sgfx_api()->version) ||
+			(hdr->bmap.bits_per_pixel != sgfx_api()->bits_per_pixel) ||
+			(hdr->size > nbyte) ){
+		return false;
+	}
+
+	table_size = sizeof(header_t) + (hdr->bmap.height + 1) * sizeof(u32);
+	if( table_size > hdr->size ){
+		return false;
+	}
+
+	//each row ends where the next one starts so the offsets can't decrease and the last one is the end of the last row
+	table = offsets();
+	for(i=0; i < hdr->bmap.height; i++){
+		if( table[i] > table[i+1] ){
+			return false;
+		}
+	}
+
+	if( table[hdr->bmap.height] > hdr->size - table_size ){
+		return false;
+	}
+
+	m_is_valid = true;
+	return m_is_valid;
+}
+
+int RleBitmap::set_data(const void * data, u32 nbyte){
+	Data::set((void*)data, nbyte, true);
+	if( validate(nbyte) == false ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+	return 0;
+}
+
+int RleBitmap::encode(const Bitmap & bitmap){
+	header_t hdr;
+	u32 row_bytes = Bitmap::calc_size(bitmap.width(), 1);
+	u32 unit = rle_unit();
+	u32 rows_size = 0;
+	u32 table_size;
+	u32 * table;
+	u8 * dest;
+	sg_int_t y;
+
+	for(y=0; y < bitmap.height(); y++){
+		rows_size += rle_encode_row(0, (const u8*)(bitmap.data_const() + y * bitmap.columns()), row_bytes, unit);
+	}
+
+	table_size = sizeof(header_t) + (bitmap.height() + 1) * sizeof(u32);
+
+	hdr.bmap.version = sgfx_api()->version;
+	hdr.bmap.bits_per_pixel = sgfx_api()->bits_per_pixel;
+	hdr.bmap.width = bitmap.width();
+	hdr.bmap.height = bitmap.height();
+	hdr.bmap.size = Bitmap::calc_size(bitmap.width(), bitmap.height());
+	hdr.signature = SIGNATURE;
+	hdr.size = table_size + rows_size;
+
+	m_is_valid = false;
+	Data::free();
+	if( Data::alloc(hdr.size) < 0 ){
+		set_error_number(ENOMEM);
+		return -1;
+	}
+
+	memcpy(data(), &hdr, sizeof(hdr));
+	table = (u32*)((u8*)data() + sizeof(header_t));
+	dest = (u8*)data() + table_size;
+
+	table[0] = 0;
+	for(y=0; y < bitmap.height(); y++){
+		table[y+1] = table[y] + rle_encode_row(dest + table[y], (const u8*)(bitmap.data_const() + y * bitmap.columns()), row_bytes, unit);
+	}
+
+	validate(hdr.size);
+	return 0;
+}
+
+int RleBitmap::load(const char * path){
+	header_t hdr;
+	File f;
+
+	m_is_valid = false;
+
+	if( f.open(path, File::READONLY) < 0 ){
+		return -1;
+	}
+
+	if( f.read(&hdr, sizeof(hdr)) != sizeof(hdr) ){
+		f.close();
+		return -1;
+	}
+
+	if( (hdr.signature != SIGNATURE) || (hdr.size < sizeof(hdr)) ){
+		f.close();
+		set_error_number(EINVAL);
+		return -1;
+	}
+
+	Data::free();
+	if( Data::alloc(hdr.size) < 0 ){
+		f.close();
+		set_error_number(ENOMEM);
+		return -1;
+	}
+
+	memcpy(data(), &hdr, sizeof(hdr));
+	if( f.read((u8*)data() + sizeof(hdr), hdr.size - sizeof(hdr)) != (s32)(hdr.size - sizeof(hdr)) ){
+		f.close();
+		return -1;
+	}
+
+	if( f.close() < 0 ){
+		return -1;
+	}
+
+	if( validate(hdr.size) == false ){
+		set_error_number(EINVAL);
+		return -1;
+	}
+
+	return 0;
+}
+
+int RleBitmap::save(const char * path) const {
+	File f;
+
+	if( m_is_valid == false ){
+		return -1;
+	}
+
+	if( f.create(path, true) < 0 ){
+		return -1;
+	}
+
+	if( f.write(data_const(), encoded_size()) != (s32)encoded_size() ){
+		f.close();
+		unlink(path);
+		return -1;
+	}
+
+	if( f.close() < 0 ){
+		return -1;
+	}
+
+	return 0;
+}
+
+int RleBitmap::decode_row(sg_int_t y, sg_bmap_data_t * dest) const {
+	u32 offset;
+
+	if( (m_is_valid == false) || (y < 0) || (y >= height()) ){
+		return -1;
+	}
+
+	offset = offsets()[y];
+	if( offsets()[y+1] < offset ){
+		return -1;
+	}
+	return rle_decode_row((u8*)dest, Bitmap::calc_size(width(), 1), rows() + offset, offsets()[y+1] - offset, rle_unit());
+}
+
+int RleBitmap::decode(Bitmap & bitmap) const {
+	sg_int_t y;
+
+	if( m_is_valid == false ){
+		return -1;
+	}
+
+	if( bitmap.set_size(width(), height()) == false ){
+		if( bitmap.alloc(width(), height()) < 0 ){
+			return -1;
+		}
+	}
+
+	for(y=0; y < height(); y++){
+		if( decode_row(y, bitmap.data() + y * bitmap.columns()) < 0 ){
+			return -1;
+		}
+	}
+
+	bitmap.mark_dirty();
+	return 0;
+}
+
+void RleBitmap::draw(const Bitmap & dest, sg_point_t p_dest, const sg_region_t & region_src) const {
+	s32 x0, y0, x1, y1;
+	s32 dest_x, dest_y;
+	s32 y;
+
+	if( m_is_valid == false ){
+		return;
+	}
+
+	//clip the source region to this bitmap
+	x0 = region_src.point.x;
+	y0 = region_src.point.y;
+	x1 = x0 + region_src.dim.width;
+	y1 = y0 + region_src.dim.height;
+	dest_x = p_dest.x;
+	dest_y = p_dest.y;
+	if( x0 < 0 ){ dest_x -= x0; x0 = 0; }
+	if( y0 < 0 ){ dest_y -= y0; y0 = 0; }
+	if( x1 > width() ){ x1 = width(); }
+	if( y1 > height() ){ y1 = height(); }
+
+	//only decode the rows that land on the destination
+	if( dest_y < 0 ){
+		y0 -= dest_y;
+		dest_y = 0;
+	}
+	if( y1 - y0 > dest.height() - dest_y ){
+		y1 = y0 + dest.height() - dest_y;
+	}
+
+	if( (x0 >= x1) || (y0 >= y1) ){
+		return;
+	}
+
+	if( (m_row.width() != width()) || (m_row.height() != 1) ){
+		if( (m_row.set_size(width(), 1) == false) && (m_row.alloc(width(), 1) < 0) ){
+			return;
+		}
+	}
+
+	for(y = y0; y < y1; y++, dest_y++){
+		if( decode_row(y, m_row.data()) == 0 ){
+			dest.draw_sub_bitmap(sg_point(dest_x, dest_y), m_row, sg_region(sg_point(x0, 0), sg_dim(x1 - x0, 1)));
+		}
+	}
+}
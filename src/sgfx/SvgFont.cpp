@@ -6,10 +6,101 @@
 using namespace sgfx;
 
 SvgFont::SvgFont() {
-
+	m_height = 0;
+	m_width = 0;
+	m_cache_budget = DEFAULT_CACHE_BUDGET;
+	m_cache_usage = 0;
+	m_cache_hits = 0;
+	m_cache_misses = 0;
+	m_cache_clock = 0;
 }
 
 SvgFont::~SvgFont() {
+	clear_cache();
+}
+
+void SvgFont::set_height(sg_size_t height){
+	m_height = height;
+	update_generation();
+}
+
+void SvgFont::set_cache_budget(u32 bytes){
+	m_cache_budget = bytes;
+	free_glyphs(bytes);
+}
+
+void SvgFont::clear_cache(){
+	free_glyphs(0);
+}
+
+void SvgFont::free_glyphs(u32 budget) const {
+	//frees the least recently used glyphs until the usage is within budget
+	while( (m_cache_usage > budget) && m_glyphs.count() ){
+		u32 oldest = 0;
+		u32 i;
+		for(i=1; i < m_glyphs.count(); i++){
+			if( m_glyphs[i].last_used < m_glyphs[oldest].last_used ){
+				oldest = i;
+			}
+		}
+
+		m_cache_usage -= m_glyphs[oldest].bitmap->capacity();
+		delete m_glyphs[oldest].bitmap;
 
+		//the order doesn't matter so the last entry fills the gap
+		m_glyphs[oldest] = m_glyphs[m_glyphs.count()-1];
+		m_glyphs.pop_back();
+	}
 }
 
+void SvgFont::draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const {
+	u32 size;
+	u32 i;
+	glyph_t glyph;
+
+	m_cache_clock++;
+	for(i=0; i < m_glyphs.count(); i++){
+		if( (m_glyphs[i].id == ch.id) && (m_glyphs[i].height == m_height) ){
+			m_glyphs[i].last_used = m_cache_clock;
+			m_cache_hits++;
+			dest.draw_bitmap(point, *m_glyphs[i].bitmap);
+			return;
+		}
+	}
+
+	m_cache_misses++;
+
+	//the cache usage counts the rounded capacity of each glyph bitmap
+	size = Bitmap::calc_size(ch.width, ch.height);
+	if( size ){
+		size = Bitmap::calc_capacity(size);
+	}
+	if( (size == 0) || (size > m_cache_budget) ){
+		draw_char_path(ch, dest, point);
+		return;
+	}
+
+	free_glyphs(m_cache_budget - size);
+
+	glyph.bitmap = new Bitmap(ch.width, ch.height);
+	if( (glyph.bitmap == 0) || (glyph.bitmap->data() == 0) ){
+		delete glyph.bitmap;
+		draw_char_path(ch, dest, point);
+		return;
+	}
+
+	glyph.bitmap->clear();
+	draw_char_path(ch, *glyph.bitmap, sg_point(0,0));
+	glyph.id = ch.id;
+	glyph.height = m_height;
+	glyph.last_used = m_cache_clock;
+
+	if( m_glyphs.push_back(glyph) < 0 ){
+		dest.draw_bitmap(point, *glyph.bitmap);
+		delete glyph.bitmap;
+		return;
+	}
+
+	m_cache_usage += glyph.bitmap->capacity();
+	dest.draw_bitmap(point, *glyph.bitmap);
+}
@@ -3,12 +3,19 @@
 #include "sgfx/SvgMemoryFont.hpp"
 
 #include <cstdio>
+#include <cstring>
 #include <errno.h>
 
 using namespace sgfx;
 
 SvgMemoryFont::SvgMemoryFont() {
+	m_glyphs = 0;
+	m_count = 0;
+}
 
+SvgMemoryFont::SvgMemoryFont(const glyph_path_t * glyphs, u16 count){
+	m_glyphs = glyphs;
+	m_count = count;
 }
 
 SvgMemoryFont::~SvgMemoryFont() {
@@ -16,6 +23,27 @@ SvgMemoryFont::~SvgMemoryFont() {
 }
 
 int SvgMemoryFont::load_char(sg_font_char_t & ch, char c, bool ascii) const {
+	int ind;
+	u32 width;
+
+	if( ascii ){
+		ind = to_charset(c);
+	} else {
+		ind = c;
+	}
+
+	if( (ind < 0) || (ind >= m_count) || (get_height() == 0) ){
+		return -1;
+	}
+
+	width = ((u32)m_glyphs[ind].advance * get_height() + SG_MAX/2) / SG_MAX;
+	if( width > 255 ){ width = 255; }
+
+	memset(&ch, 0, sizeof(ch));
+	ch.id = ind;
+	ch.width = width;
+	ch.height = get_height() > 255 ? 255 : get_height();
+	ch.xadvance = width;
 	return 0;
 }
 
@@ -23,8 +51,15 @@ int SvgMemoryFont::load_kerning(u16 first, u16 second) const {
 	return -1;
 }
 
-void SvgMemoryFont::draw_char_on_bitmap(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const {
+void SvgMemoryFont::draw_char_path(const sg_font_char_t & ch, Bitmap & dest, sg_point_t point) const {
+	sg_vector_map_t map;
 
+	if( ch.id >= m_count ){
+		return;
+	}
 
-	//draw directly on the dest bitmap using Vector::draw_path()
+	//the glyph box is filled with the pen of dest
+	map.region = sg_region(point, sg_dim(ch.width, ch.height));
+	map.rotation = 0;
+	m_rasterizer.fill(dest, m_glyphs[ch.id].path, map);
 }
@@ -0,0 +1,149 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstring>
+#include "sgfx/TextLayout.hpp"
+
+using namespace sgfx;
+
+TextLayout::TextLayout(){
+	m_font = 0;
+	m_generation = 0;
+	m_hash = 0;
+	m_width = 0;
+	m_height = 0;
+}
+
+u32 TextLayout::calc_hash(const char * str){
+	u32 hash = 2166136261UL;
+	while( *str ){
+		hash ^= (u8)*str++;
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+bool TextLayout::is_match(const Font & font, const char * str, u32 hash) const {
+	return (m_font == &font) && (m_generation == font.generation()) && (m_hash == hash) && (m_text == str);
+}
+
+int TextLayout::set(const Font & font, const char * str){
+	const char * p;
+	sg_font_char_t character;
+	sg_int_t x = 0;
+	char c;
+
+	m_font = 0;
+	m_width = 0;
+	m_height = 0;
+	m_glyphs.clear();
+	m_glyphs.reserve(strlen(str));
+
+	if( m_text.assign(str) < 0 ){
+		return -1;
+	}
+
+	//same steps as Font::draw_str()
+	p = str;
+	while( (c = *(p++)) != 0 ){
+		sg_size_t w;
+		if( c == ' ' ){
+			w = font.space_size();
+		} else if( font.load_char(character, c, true) == 0 ){
+			glyph_t glyph;
+			glyph.character = character;
+			glyph.x = x + character.xoffset;
+			if( m_glyphs.push_back(glyph) < 0 ){
+				return -1;
+			}
+			w = character.xadvance;
+		} else {
+			w = 0;
+		}
+
+		w += font.load_kerning(c, *p);
+		x += w;
+	}
+
+	m_font = &font;
+	m_generation = font.generation();
+	m_hash = calc_hash(str);
+	m_width = x;
+	m_height = font.get_height();
+	return 0;
+}
+
+void TextLayout::draw(Bitmap & dest, sg_point_t point) const {
+	const glyph_t * glyph = m_glyphs.vector_data_const();
+	u32 i;
+
+	if( m_font == 0 ){
+		return;
+	}
+
+	for(i=0; i < m_glyphs.count(); i++){
+		sg_point_t p;
+		p.x = point.x + glyph[i].x;
+		p.y = point.y + glyph[i].character.yoffset;
+		m_font->draw_char_on_bitmap(glyph[i].character, dest, p);
+	}
+}
+
+TextLayoutCache::TextLayoutCache(u8 count){
+	u8 i;
+	if( count == 0 ){
+		count = 1;
+	}
+	m_entries = new entry_t[count];
+	m_size = m_entries ? count : 0;
+	for(i=0; i < m_size; i++){
+		m_entries[i].last_used = 0;
+	}
+	m_clock = 0;
+	m_hits = 0;
+	m_misses = 0;
+}
+
+TextLayoutCache::~TextLayoutCache(){
+	if( m_entries ){
+		delete [] m_entries;
+	}
+}
+
+void TextLayoutCache::clear(){
+	u8 i;
+	//unused entries are skipped by get() (the memory is kept for the next layout)
+	for(i=0; i < m_size; i++){
+		m_entries[i].last_used = 0;
+	}
+}
+
+const TextLayout * TextLayoutCache::get(const Font & font, const char * str){
+	const u32 hash = TextLayout::calc_hash(str);
+	u8 oldest = 0;
+	u8 i;
+
+	if( m_size == 0 ){
+		return 0;
+	}
+
+	m_clock++;
+	for(i=0; i < m_size; i++){
+		if( m_entries[i].last_used && m_entries[i].layout.is_match(font, str, hash) ){
+			m_entries[i].last_used = m_clock;
+			m_hits++;
+			return &m_entries[i].layout;
+		}
+
+		if( m_entries[i].last_used < m_entries[oldest].last_used ){
+			oldest = i;
+		}
+	}
+
+	m_misses++;
+	if( m_entries[oldest].layout.set(font, str) < 0 ){
+		m_entries[oldest].last_used = 0;
+		return 0;
+	}
+	m_entries[oldest].last_used = m_clock;
+	return &m_entries[oldest].layout;
+}
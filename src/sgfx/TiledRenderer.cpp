@@ -0,0 +1,373 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cerrno>
+#include <cstring>
+#include "sys/Thread.hpp"
+#include "sgfx/TiledRenderer.hpp"
+#include "sgfx/VectorRasterizer.hpp"
+
+using namespace sgfx;
+
+namespace {
+
+void renderer_set_bounds(s32 * bounds, s32 x0, s32 y0, s32 x1, s32 y1, s32 margin){
+	bounds[0] = (x0 < x1 ? x0 : x1) - margin;
+	bounds[1] = (y0 < y1 ? y0 : y1) - margin;
+	bounds[2] = (x0 > x1 ? x0 : x1) + margin + 1;
+	bounds[3] = (y0 > y1 ? y0 : y1) + margin + 1;
+}
+
+void renderer_set_map_bounds(s32 * bounds, const sg_vector_map_t & map, s32 margin){
+	//rotated corners can extend past the map by up to (sqrt(2)-1)/2
+	if( map.rotation != 0 ){
+		margin += (map.region.dim.width > map.region.dim.height ? map.region.dim.width : map.region.dim.height) * 207UL / 1000UL + 1;
+	}
+	renderer_set_bounds(bounds,
+			map.region.point.x, map.region.point.y,
+			map.region.point.x + map.region.dim.width, map.region.point.y + map.region.dim.height,
+			margin);
+}
+
+sg_point_t renderer_shift(sg_point_t p, const sg_point_t & offset){
+	return sg_point(p.x - offset.x, p.y - offset.y);
+}
+
+}
+
+/*! \cond */
+class TiledRenderer::Worker {
+public:
+	Worker() : thread(DEFAULT_STACK_SIZE, false){
+		renderer = 0;
+		index = 0;
+	}
+
+	TiledRenderer * renderer;
+	u16 index;
+	Bitmap view; //shares the target's memory (with its own pen)
+	Bitmap tile;
+	VectorRasterizer rasterizer;
+	sys::Thread thread;
+};
+/*! \endcond */
+
+TiledRenderer::TiledRenderer(){
+	m_thread_count = 1;
+	m_tile_width = 0;
+	m_tile_height = DEFAULT_TILE_HEIGHT;
+	m_stack_size = DEFAULT_STACK_SIZE;
+	m_target = 0;
+	m_width = 0;
+	m_columns = 0;
+	m_tile_count = 0;
+}
+
+int TiledRenderer::record(command_t & command){
+	command.pen = m_pen.item();
+	if( m_commands.push_back(command) < 0 ){
+		set_error_number(ENOMEM);
+		return -1;
+	}
+	return 0;
+}
+
+int TiledRenderer::draw_pixel(sg_point_t p){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_PIXEL;
+	command.point[0] = p;
+	renderer_set_bounds(command.bounds, p.x, p.y, p.x, p.y, 0);
+	return record(command);
+}
+
+int TiledRenderer::draw_line(sg_point_t p1, sg_point_t p2){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_LINE;
+	command.point[0] = p1;
+	command.point[1] = p2;
+	renderer_set_bounds(command.bounds, p1.x, p1.y, p2.x, p2.y, m_pen.thickness());
+	return record(command);
+}
+
+int TiledRenderer::draw_arc(const sg_region_t & region, s16 start, s16 end, s16 rotation){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_ARC;
+	command.region = region;
+	command.value[0] = start;
+	command.value[1] = end;
+	command.value[2] = rotation;
+	//covers the region whether it is rotated about its corner or center
+	renderer_set_bounds(command.bounds,
+			region.point.x - region.dim.width, region.point.y - region.dim.height,
+			region.point.x + region.dim.width, region.point.y + region.dim.height,
+			m_pen.thickness());
+	return record(command);
+}
+
+int TiledRenderer::draw_rectangle(const sg_region_t & region){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_RECTANGLE;
+	command.region = region;
+	renderer_set_bounds(command.bounds,
+			region.point.x, region.point.y,
+			region.point.x + region.dim.width - 1, region.point.y + region.dim.height - 1, 0);
+	return record(command);
+}
+
+int TiledRenderer::draw_pattern(const sg_region_t & region, sg_bmap_data_t odd_pattern, sg_bmap_data_t even_pattern, sg_size_t pattern_height){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_PATTERN;
+	command.region = region;
+	command.pattern[0] = odd_pattern;
+	command.pattern[1] = even_pattern;
+	command.value[0] = pattern_height;
+	renderer_set_bounds(command.bounds,
+			region.point.x, region.point.y,
+			region.point.x + region.dim.width - 1, region.point.y + region.dim.height - 1, 0);
+	return record(command);
+}
+
+int TiledRenderer::draw_bitmap(sg_point_t p_dest, const Bitmap & src){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_BITMAP;
+	command.point[0] = p_dest;
+	command.object = &src;
+	renderer_set_bounds(command.bounds,
+			p_dest.x, p_dest.y,
+			p_dest.x + src.width() - 1, p_dest.y + src.height() - 1, 0);
+	return record(command);
+}
+
+int TiledRenderer::draw_sub_bitmap(sg_point_t p_dest, const Bitmap & src, const sg_region_t & region_src){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_SUB_BITMAP;
+	command.point[0] = p_dest;
+	command.region = region_src;
+	command.object = &src;
+	renderer_set_bounds(command.bounds,
+			p_dest.x, p_dest.y,
+			p_dest.x + region_src.dim.width - 1, p_dest.y + region_src.dim.height - 1, 0);
+	return record(command);
+}
+
+int TiledRenderer::draw_icon(const sg_vector_icon_t & icon, const sg_vector_map_t & map){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_ICON;
+	command.map = map;
+	command.object = &icon;
+	renderer_set_map_bounds(command.bounds, map, m_pen.thickness());
+	return record(command);
+}
+
+int TiledRenderer::draw_path(const sg_vector_path_t & path, const sg_vector_map_t & map){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_PATH;
+	command.map = map;
+	command.object = &path;
+	renderer_set_map_bounds(command.bounds, map, m_pen.thickness());
+	return record(command);
+}
+
+int TiledRenderer::draw_function(draw_function_t function, void * context){
+	command_t command;
+	memset(&command, 0, sizeof(command));
+	command.type = COMMAND_FUNCTION;
+	command.function = function;
+	command.context = context;
+	//the function can draw anywhere on the tile
+	command.bounds[0] = -65536;
+	command.bounds[1] = -65536;
+	command.bounds[2] = 65536;
+	command.bounds[3] = 65536;
+	return record(command);
+}
+
+void TiledRenderer::draw_command(Worker & worker, Bitmap & tile, const command_t & command, const sg_point_t & offset) const {
+	sg_region_t region;
+	sg_vector_map_t map;
+
+	tile.set_pen(command.pen);
+
+	switch(command.type){
+	case COMMAND_PIXEL:
+		tile.draw_pixel(renderer_shift(command.point[0], offset));
+		break;
+	case COMMAND_LINE:
+		tile.draw_line(renderer_shift(command.point[0], offset), renderer_shift(command.point[1], offset));
+		break;
+	case COMMAND_ARC:
+		region = sg_region(renderer_shift(command.region.point, offset), command.region.dim);
+		tile.draw_arc(region, command.value[0], command.value[1], command.value[2]);
+		break;
+	case COMMAND_RECTANGLE:
+		tile.draw_rectangle(sg_region(renderer_shift(command.region.point, offset), command.region.dim));
+		break;
+	case COMMAND_PATTERN:
+		//tiles start on a word boundary so the pattern bits line up
+		tile.draw_pattern(sg_region(renderer_shift(command.region.point, offset), command.region.dim),
+				command.pattern[0], command.pattern[1], command.value[0]);
+		break;
+	case COMMAND_BITMAP:
+		tile.draw_bitmap(renderer_shift(command.point[0], offset), *(const Bitmap*)command.object);
+		break;
+	case COMMAND_SUB_BITMAP:
+		tile.draw_sub_bitmap(renderer_shift(command.point[0], offset), *(const Bitmap*)command.object, command.region);
+		break;
+	case COMMAND_ICON:
+		map = command.map;
+		map.region.point = renderer_shift(map.region.point, offset);
+		//Vector::draw() isn't used because the cache is shared
+		sgfx_api()->vector_draw_icon(tile.bmap(), (const sg_vector_icon_t*)command.object, &map, 0);
+		break;
+	case COMMAND_PATH:
+		{
+			//each thread needs its own copy because the path region is written by the library
+			sg_vector_path_t path = *(const sg_vector_path_t*)command.object;
+			map = command.map;
+			map.region.point = renderer_shift(map.region.point, offset);
+			if( (command.pen.o_flags & SG_PEN_FLAG_IS_FILL) &&
+					(worker.rasterizer.fill(tile, path, map) == 0) ){
+				break;
+			}
+			sgfx_api()->vector_draw_path(tile.bmap(), &path, &map);
+		}
+		break;
+	case COMMAND_FUNCTION:
+		command.function(command.context, tile, offset);
+		break;
+	}
+}
+
+void TiledRenderer::draw_tile(Worker & worker, u32 tile) const {
+	sg_point_t offset;
+	sg_dim_t dim;
+	s32 x1, y1;
+	u32 i;
+
+	offset.x = (tile % m_columns) * m_width;
+	offset.y = (tile / m_columns) * m_tile_height;
+	dim.width = m_width;
+	dim.height = m_tile_height;
+	if( offset.x + dim.width > m_target->width() ){
+		dim.width = m_target->width() - offset.x;
+	}
+	if( offset.y + dim.height > m_target->height() ){
+		dim.height = m_target->height() - offset.y;
+	}
+	x1 = offset.x + dim.width;
+	y1 = offset.y + dim.height;
+
+	if( m_columns == 1 ){
+		//a row band is a whole number of rows of the target so the memory is shared
+		worker.tile.set_data(m_target->data() + offset.y * m_target->columns(), dim.width, dim.height);
+	} else {
+		worker.tile.set_size(dim.width, dim.height);
+		worker.tile.set_pen_flags(SG_PEN_FLAG_IS_SOLID);
+		worker.tile.draw_sub_bitmap(sg_point(0,0), worker.view, sg_region(offset, dim));
+	}
+
+	for(i=0; i < m_commands.count(); i++){
+		const command_t & command = m_commands[i];
+		if( (command.bounds[0] < x1) && (command.bounds[2] > offset.x) &&
+				(command.bounds[1] < y1) && (command.bounds[3] > offset.y) ){
+			draw_command(worker, worker.tile, command, offset);
+		}
+	}
+
+	if( m_columns != 1 ){
+		worker.view.draw_sub_bitmap(offset, worker.tile, sg_region(sg_point(0,0), dim));
+	}
+}
+
+void * TiledRenderer::render_thread(void * args){
+	Worker * worker = (Worker*)args;
+	const TiledRenderer * renderer = worker->renderer;
+	u32 tile;
+
+	//tiles are interleaved so that each thread gets part of every area of the bitmap
+	for(tile = worker->index; tile < renderer->m_tile_count; tile += renderer->m_thread_count){
+		renderer->draw_tile(*worker, tile);
+	}
+	return 0;
+}
+
+int TiledRenderer::render(Bitmap & bitmap){
+	Worker * workers;
+	u32 word_pixels;
+	u16 rows;
+	u16 i;
+
+	if( (bitmap.width() == 0) || (bitmap.height() == 0) ){
+		return 0;
+	}
+
+	m_target = &bitmap;
+
+	m_width = bitmap.width();
+	if( (m_tile_width != 0) && (m_tile_width < bitmap.width()) ){
+		//narrow tiles must start and end on a word boundary
+		word_pixels = 32 / Bitmap::bits_per_pixel();
+		if( word_pixels == 0 ){
+			word_pixels = 1;
+		}
+		m_width = (m_tile_width + word_pixels - 1) / word_pixels * word_pixels;
+		if( m_width > bitmap.width() ){
+			m_width = bitmap.width();
+		}
+	}
+
+	m_columns = (bitmap.width() + m_width - 1) / m_width;
+	rows = (bitmap.height() + m_tile_height - 1) / m_tile_height;
+	m_tile_count = (u32)m_columns * rows;
+
+	workers = new Worker[m_thread_count];
+	if( workers == 0 ){
+		set_error_number(ENOMEM);
+		return -1;
+	}
+
+	for(i=0; i < m_thread_count; i++){
+		workers[i].renderer = this;
+		workers[i].index = i;
+		if( m_columns != 1 ){
+			workers[i].view.set_data(bitmap.data(), bitmap.width(), bitmap.height());
+			workers[i].view.set_pen_flags(SG_PEN_FLAG_IS_SOLID);
+			if( workers[i].tile.alloc(m_width, m_tile_height) < 0 ){
+				delete [] workers;
+				set_error_number(ENOMEM);
+				return -1;
+			}
+		}
+	}
+
+	//the calling thread is worker 0
+	for(i=1; i < m_thread_count; i++){
+		workers[i].thread.set_stacksize(m_stack_size);
+		workers[i].thread.create(render_thread, workers + i);
+	}
+
+	render_thread(workers);
+
+	for(i=1; i < m_thread_count; i++){
+		if( workers[i].thread.is_valid() ){
+			sys::Thread::join(workers[i].thread);
+		} else {
+			//the thread couldn't be created so its tiles are drawn here
+			render_thread(workers + i);
+		}
+	}
+
+	delete [] workers;
+	m_target = 0;
+
+	bitmap.mark_dirty();
+	return 0;
+}
@@ -1,10 +1,15 @@
 //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
 
 #include "sgfx/Vector.hpp"
+#include "sgfx/VectorCache.hpp"
+#include "sgfx/VectorRasterizer.hpp"
 #include <cstdio>
 
 using namespace sgfx;
 
+VectorCache * Vector::m_cache = 0;
+VectorRasterizer * Vector::m_rasterizer = 0;
+
 
 void VectorMap::set_region(const sg_region_t & region, s16 rotation){
 	data()->region = region;
@@ -67,11 +72,38 @@ void VectorMap::fill_region(const sg_region_t & region, s16 rotation){
 
 
 void Vector::draw(Bitmap & bitmap, const sg_vector_icon_t & icon, const sg_vector_map_t & map, sg_region_t * bounds){
-	sg_api()->vector_draw_icon(bitmap.bmap(), &icon, &map, bounds);
+	if( m_cache && (m_cache->draw(bitmap, icon, map, bounds) == 0) ){
+		return;
+	}
+	sgfx_api()->vector_draw_icon(bitmap.bmap(), &icon, &map, bounds);
+	mark_dirty(bitmap, map);
 }
 
 void Vector::draw_path(Bitmap & bitmap, sg_vector_path_t & path, const sg_vector_map_t & map){
-	sg_api()->vector_draw_path(bitmap.bmap(), &path, &map);
+	if( m_rasterizer && (bitmap.pen_flags() & SG_PEN_FLAG_IS_FILL) ){
+		//the rasterizer marks what it draws as dirty
+		if( m_rasterizer->fill(bitmap, path, map) == 0 ){
+			return;
+		}
+	}
+	sgfx_api()->vector_draw_path(bitmap.bmap(), &path, &map);
+	mark_dirty(bitmap, map);
+}
+
+void Vector::mark_dirty(const Bitmap & bitmap, const sg_vector_map_t & map){
+	sg_region_t region = map.region;
+	s32 margin = bitmap.pen_thickness();
+
+	//rotated corners can extend past the map by up to (sqrt(2)-1)/2
+	if( map.rotation != 0 ){
+		margin += (region.dim.width > region.dim.height ? region.dim.width : region.dim.height) * 207UL / 1000UL + 1;
+	}
+
+	region.point.x -= margin;
+	region.point.y -= margin;
+	region.dim.width += 2*margin;
+	region.dim.height += 2*margin;
+	bitmap.mark_dirty(region);
 }
 
 sg_vector_primitive_t Vector::line(const Point & p1, const Point & p2){
@@ -303,7 +335,7 @@ void Vector::draw_remove(Bitmap & bitmap, const VectorMap & map, sg_region_t * b
 	objs[0] = line(-SG_MAX/2, -SG_MAX/2, SG_MAX/2, SG_MAX/2);
 	objs[1] = line(-SG_MAX/2, SG_MAX/2, SG_MAX/2, -SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -319,7 +351,7 @@ void Vector::draw_ok(Bitmap & bitmap, const VectorMap & map, sg_region_t * bound
 	objs[0] = line(-SG_MAX/2, SG_MAX/4, -SG_MAX/4, SG_MAX/2);
 	objs[1] = line(-SG_MAX/4, SG_MAX/2, SG_MAX/2, -SG_MAX/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -336,7 +368,7 @@ void Vector::draw_bars(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 	objs[1] = Vector::line(SG_MIN/2, 0, SG_MAX/2, 0);
 	objs[2] = Vector::line(SG_MIN/2, SG_MAX/2, SG_MAX/2, SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -350,7 +382,7 @@ void Vector::draw_circle(Bitmap & bitmap, const VectorMap & map, sg_region_t * b
 	icon.total = total;
 	icon.fill_total = 0;
 	objs[0] = circle(0, 0, SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -365,7 +397,7 @@ void Vector::draw_circle_fill(Bitmap & bitmap, const VectorMap & map, sg_region_
 	icon.fill_total = 0;
 	objs[0] = circle(0, 0, SG_MAX/2);
 	objs[1] = fill(0, 0);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -384,7 +416,7 @@ void Vector::draw_toggle_off(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[3] = arc(SG_MAX/4, 0, SG_MAX/4, SG_MAX/4, SG_TRIG_POINTS*3/4, SG_TRIG_POINTS*5/4);
 	objs[4] = circle(-SG_MAX/4, 0, SG_MAX/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -404,7 +436,7 @@ void Vector::draw_toggle_on(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[4] = circle(SG_MAX/4, 0, SG_MAX/4);
 	objs[5] = fill(-SG_MAX/4, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -420,7 +452,7 @@ void Vector::draw_power(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = line(0, 0, 0, -SG_MAX/2);
 	objs[1] = arc(0, 0, SG_MAX/2, SG_MAX/2, SG_TRIG_POINTS*7/8, SG_TRIG_POINTS*7/8 + SG_TRIG_POINTS*3/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -436,7 +468,7 @@ void Vector::draw_chevron(Bitmap & bitmap, const VectorMap & map, sg_region_t *
 	objs[0] = line(-SG_MAX/8, -SG_MAX/2, SG_MAX/8, 0);
 	objs[1] = line(SG_MAX/8, 0, -SG_MAX/8, SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -453,7 +485,7 @@ void Vector::draw_arrow(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = line(0, SG_MAX/2, SG_MAX/2, 0);
 	objs[2] = line(0, -SG_MAX/2, SG_MAX/2, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -469,7 +501,7 @@ void Vector::draw_zoom(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 	objs[0] = circle(SG_MAX/6, -SG_MAX/6, SG_MAX*3/10);
 	objs[1] = line(-SG_MAX/20, SG_MAX/20, -SG_MAX/2, SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -486,7 +518,7 @@ void Vector::draw_reset(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = line(SG_MAX*3/10, 0, SG_MAX*1/10, -SG_MAX*2/20);
 	objs[2] = arc(-SG_MAX/40, 0, SG_MAX*3/10 + SG_MAX*3/40, SG_MAX*3/10 + SG_MAX*3/40, SG_TRIG_POINTS/12, SG_TRIG_POINTS);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -503,7 +535,7 @@ void Vector::draw_lightning(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[1] = line(-SG_MAX/4, SG_MAX/10, SG_MAX/4, -SG_MAX/10);
 	objs[2] = line(SG_MAX/4, -SG_MAX/10, 0, SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -521,7 +553,7 @@ void Vector::draw_play(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 	objs[2] = line(SG_MAX/2, 0, -SG_MAX/2, -SG_MAX/2);
 	objs[3] = fill(0, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -538,7 +570,7 @@ void Vector::draw_pause(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
 	objs[1] = line(SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -559,7 +591,7 @@ void Vector::draw_button_bar(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[5] = Vector::arc(SG_MIN/2+ SG_MAX/32, SG_MAX/4-SG_MAX/32, SG_MAX/32, SG_MAX/32, SG_TRIG_POINTS/4, SG_TRIG_POINTS*2/4);
 	objs[6] = Vector::fill(0, SG_MAX/8);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -583,7 +615,7 @@ void Vector::draw_mic(Bitmap & bitmap, const VectorMap & map, sg_region_t * boun
 	objs[6] = Vector::line(-SG_MAX/5, SG_MAX/2, SG_MAX/5, SG_MAX/2);
 	objs[7] = Vector::fill(0, -SG_MAX/8);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -602,7 +634,7 @@ void Vector::draw_clock(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(0, 0, SG_MAX/4, 0);
 	objs[2] = Vector::line(0, 0, 0, -SG_MAX/3);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -623,7 +655,7 @@ void Vector::draw_heart(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[3] = Vector::line(SG_MAX/2 - SG_MAX*1/20, SG_MAX*3/10 - SG_MAX*3/20, 0, SG_MAX/2);
 	objs[4] = Vector::fill(SG_MAX/4, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -645,7 +677,7 @@ void Vector::draw_plot(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 	objs[4] = Vector::line(0, 0, SG_MAX/4, -SG_MAX/4);
 	objs[5] = Vector::line(SG_MAX/4, -SG_MAX/4, SG_MAX/2, SG_MAX/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -671,7 +703,7 @@ void Vector::draw_bike(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 	objs[9] = Vector::line(SG_MAX*1/16, -SG_MAX*3/8, SG_MAX*3/16, -SG_MAX*3/8);
 	objs[10] = Vector::line(-SG_MAX*4/16, -SG_MAX*5/16, -SG_MAX*2/16, -SG_MAX*5/16);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -692,7 +724,7 @@ void Vector::draw_mountain(Bitmap & bitmap, const VectorMap & map, sg_region_t *
 	objs[4] = Vector::line(-SG_MAX/2, SG_MAX/2, SG_MAX/2, SG_MAX/2);
 	objs[5] = Vector::fill(SG_MAX/8, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -714,7 +746,7 @@ void Vector::draw_compass(Bitmap & bitmap, const VectorMap & map, sg_region_t *
 	objs[4] = Vector::line(SG_MAX/8, 0, 0, SG_MAX/4);
 	objs[5] = Vector::fill(0, -SG_MAX/8);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -739,7 +771,7 @@ void Vector::draw_compass_outer(Bitmap & bitmap, const VectorMap & map, sg_regio
 	objs[7] = Vector::line(SG_MAX*5/20, -SG_MAX*5/20, SG_MAX*7/20, -SG_MAX*7/20);
 	objs[8] = Vector::line(-SG_MAX*5/20, -SG_MAX*5/20, -SG_MAX*7/20, -SG_MAX*7/20);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -762,7 +794,7 @@ void Vector::draw_panel(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[6] = Vector::line(-SG_MAX/2, -SG_MAX/4+SG_MAX/16, -SG_MAX/2, SG_MAX/4-SG_MAX/16);
 	objs[7] = Vector::line(SG_MAX/2, -SG_MAX/4+SG_MAX/16, SG_MAX/2, SG_MAX/4-SG_MAX/16);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -787,7 +819,7 @@ void Vector::draw_panel_fill(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[7] = Vector::line(SG_MAX/2, -SG_MAX/4+SG_MAX/16, SG_MAX/2, SG_MAX/4-SG_MAX/16);
 	objs[8] = Vector::fill(0, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -812,7 +844,7 @@ void Vector::draw_sun(Bitmap & bitmap, const VectorMap & map, sg_region_t * boun
 	objs[7] = Vector::line(SG_MAX*5/20, -SG_MAX*5/20, SG_MAX*7/20, -SG_MAX*7/20);
 	objs[8] = Vector::line(-SG_MAX*5/20, -SG_MAX*5/20, -SG_MAX*7/20, -SG_MAX*7/20);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -835,7 +867,7 @@ void Vector::draw_battery(Bitmap & bitmap, const VectorMap & map, sg_region_t *
 	objs[5] = Vector::line(SG_MAX*4/10, -SG_MAX*1/10, SG_MAX*5/10, -SG_MAX*1/10);
 	objs[6] = Vector::line(SG_MAX*5/10, -SG_MAX*1/10, SG_MAX*5/10, SG_MAX*1/10);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -855,7 +887,7 @@ void Vector::draw_arrowhead(Bitmap & bitmap, const VectorMap & map, sg_region_t
 	objs[2] = Vector::line(SG_MAX/4, SG_MAX/2, 0, SG_MAX/4);
 	objs[3] = Vector::line(-SG_MAX/4, SG_MAX/2, 0, SG_MAX/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -871,7 +903,7 @@ void Vector::draw_dot(Bitmap & bitmap, const VectorMap & map, sg_region_t * boun
 
 	objs[0] = Vector::circle(0, 0, SG_MAX*1/10);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -887,7 +919,7 @@ void Vector::draw_dash(Bitmap & bitmap, const VectorMap & map, sg_region_t * bou
 
 	objs[0] = Vector::line(-SG_MAX/4, 0, SG_MAX/4, 0);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -909,7 +941,7 @@ void Vector::draw_message(Bitmap & bitmap, const VectorMap & map, sg_region_t *
 	objs[4] = Vector::line(-SG_MAX/2, -SG_MAX/4, 0, 0);
 	objs[5] = Vector::line(0, 0, SG_MAX/2, -SG_MAX/4);
 
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){
 		Vector::show(icon);
 	}
@@ -928,7 +960,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, SG_MAX/2, 0, -SG_MAX/2);
 	objs[1] = Vector::line(SG_MAX/4, SG_MAX/2, 0, -SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/8, 0, SG_MAX/8, 0);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//B
@@ -939,7 +971,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/4, -SG_MAX/4, SG_MAX/4);
 	objs[1] = Vector::arc(0,SG_MAX/4,SG_MAX/4,0,0,SG_TRIG_POINTS/2);
 	objs[2] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS/2,SG_TRIG_POINTS);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//D
@@ -951,7 +983,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(-SG_MAX/4, 0, 0, 0);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[3] = Vector::line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//F
@@ -959,7 +991,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, 0, 0, 0);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//G
@@ -970,7 +1002,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, 0, SG_MAX/4, 0);
 	objs[1] = Vector::line(SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//I
@@ -978,7 +1010,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::line(0, -SG_MAX/2, 0, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//J
@@ -989,14 +1021,14 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, 0, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, 0, SG_MAX/4, -SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//L
 	icon.total = 2;
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, -SG_MAX/4, SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, SG_MAX/2, SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//M
@@ -1005,7 +1037,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(SG_MAX/4, SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, 0, SG_MAX/4);
 	objs[3] = Vector::line(SG_MAX/4, -SG_MAX/2, 0, SG_MAX/4);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//N
@@ -1013,7 +1045,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, SG_MAX/2, -SG_MAX/4, -SG_MAX/2);
 	objs[1] = Vector::line(SG_MAX/4, SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//O
@@ -1022,7 +1054,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(SG_MAX/4, -SG_MAX/4, SG_MAX/4, SG_MAX/4);
 	objs[2] = Vector::arc(0,SG_MAX/4,SG_MAX/4,SG_MAX/4,0,SG_TRIG_POINTS/2);
 	objs[3] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS/2,SG_TRIG_POINTS);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//P
@@ -1031,7 +1063,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(-SG_MAX/4, -SG_MAX/2, 0, -SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, 0, 0, 0);
 	objs[3] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS*3/4,SG_TRIG_POINTS*5/4);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//Q
@@ -1041,7 +1073,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[2] = Vector::arc(0,SG_MAX/4,SG_MAX/4,SG_MAX/4,0,SG_TRIG_POINTS/2);
 	objs[3] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS/2,SG_TRIG_POINTS);
 	objs[4] = Vector::line(SG_MAX/4, SG_MAX/4, SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//R
@@ -1051,7 +1083,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[2] = Vector::line(-SG_MAX/4, 0, 0, 0);
 	objs[3] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS*3/4,SG_TRIG_POINTS*5/4);
 	objs[4] = Vector::line(0, 0, SG_MAX/4, SG_MAX/2);
-	//draw(bitmap, icon, map.item());
+	//draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 
@@ -1059,7 +1091,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	icon.total = 2;
 	objs[0] = Vector::arc(0,-SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS/4,SG_TRIG_POINTS);
 	objs[1] = Vector::arc(0,SG_MAX/4,SG_MAX/4,SG_MAX/4,SG_TRIG_POINTS*3/4,SG_TRIG_POINTS*3/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	return;
@@ -1068,7 +1100,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	icon.total = 2;
 	objs[0] = Vector::line(-SG_MAX/4, SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[1] = Vector::line(0, SG_MAX/2, 0, -SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//U
@@ -1076,14 +1108,14 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/4, -SG_MAX/4, SG_MAX/2);
 	objs[1] = Vector::line(SG_MAX/4, -SG_MAX/4, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::arc(0,-SG_MAX/4,0,0,SG_TRIG_POINTS/2,SG_TRIG_POINTS);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//V
 	icon.total = 2;
 	objs[0] = Vector::line(-SG_MAX/4, SG_MAX/2, 0, -SG_MAX/2);
 	objs[1] = Vector::line(SG_MAX/4, SG_MAX/2, 0, -SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//W
@@ -1092,14 +1124,14 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[1] = Vector::line(SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, 0, SG_MAX/4);
 	objs[3] = Vector::line(SG_MAX/4, -SG_MAX/2, 0, SG_MAX/4);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//X
 	icon.total = 2;
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, SG_MAX/2, SG_MAX/4, -SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//Y
@@ -1107,7 +1139,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, 0, 0);
 	objs[1] = Vector::line(SG_MAX/4, SG_MAX/2, 0, 0);
 	objs[2] = Vector::line(0, 0, 0, -SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 
 	//Z
@@ -1115,7 +1147,7 @@ void Vector::draw_ALPHA(Bitmap & bitmap, const VectorMap & map, sg_region_t * bo
 	objs[0] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, -SG_MAX/2);
 	objs[1] = Vector::line(-SG_MAX/4, SG_MAX/2, SG_MAX/4, SG_MAX/2);
 	objs[2] = Vector::line(-SG_MAX/4, -SG_MAX/2, SG_MAX/4, SG_MAX/2);
-	draw(bitmap, icon, map.item());
+	draw(bitmap, icon, map.item(), bounds);
 	if( show ){ Vector::show(icon); }
 }
 
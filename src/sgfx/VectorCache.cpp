@@ -0,0 +1,184 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cstdlib>
+#include <cstring>
+#include "sgfx/VectorCache.hpp"
+
+using namespace sgfx;
+
+VectorCache::VectorCache(u32 budget){
+	m_budget = budget;
+	m_usage = 0;
+	m_hits = 0;
+	m_misses = 0;
+	m_clock = 0;
+}
+
+VectorCache::~VectorCache(){
+	clear();
+}
+
+u32 VectorCache::calc_hash(const sg_vector_icon_t & icon){
+	const u8 * p = (const u8*)icon.primitives;
+	u32 hash = 2166136261UL;
+	u32 i;
+	hash = (hash ^ icon.total) * 16777619UL;
+	hash = (hash ^ icon.fill_total) * 16777619UL;
+	for(i=0; i < icon.total*sizeof(sg_vector_primitive_t); i++){
+		hash ^= p[i];
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+void VectorCache::set_budget(u32 bytes){
+	m_budget = bytes;
+	free_entries(bytes);
+}
+
+void VectorCache::clear(){
+	free_entries(0);
+}
+
+u32 VectorCache::calc_entry_size(sg_size_t width, sg_size_t height, u16 total){
+	//the bitmap memory is rounded up the same way Bitmap::alloc() rounds it
+	return Bitmap::calc_capacity(Bitmap::calc_size(width, height)) + total*sizeof(sg_vector_primitive_t);
+}
+
+bool VectorCache::is_match(const entry_t & entry, const sg_vector_icon_t & icon, const sg_vector_map_t & map, const sg_pen_t & pen){
+	//the pen is compared by field because the structure has padding
+	return (entry.dim.dim == map.region.dim.dim) &&
+			(entry.rotation == map.rotation) &&
+			(entry.pen.o_flags == pen.o_flags) &&
+			(entry.pen.thickness == pen.thickness) &&
+			(entry.pen.color == pen.color) &&
+			(entry.total == icon.total) &&
+			(entry.fill_total == icon.fill_total) &&
+			(memcmp(entry.primitives, icon.primitives, icon.total*sizeof(sg_vector_primitive_t)) == 0);
+}
+
+void VectorCache::free_entries(u32 budget){
+	//frees the least recently used icons until the usage is within budget
+	while( (m_usage > budget) && m_entries.count() ){
+		u32 oldest = 0;
+		u32 i;
+		for(i=1; i < m_entries.count(); i++){
+			if( m_entries[i].last_used < m_entries[oldest].last_used ){
+				oldest = i;
+			}
+		}
+
+		m_usage -= m_entries[oldest].size;
+		delete m_entries[oldest].bitmap;
+		free(m_entries[oldest].primitives);
+
+		//the order doesn't matter so the last entry fills the gap
+		m_entries[oldest] = m_entries[m_entries.count()-1];
+		m_entries.pop_back();
+	}
+}
+
+void VectorCache::draw_entry(Bitmap & bitmap, const entry_t & entry, const sg_vector_map_t & map, sg_region_t * bounds) const {
+	sg_point_t p;
+	p.x = map.region.point.x - entry.offset.x;
+	p.y = map.region.point.y - entry.offset.y;
+
+	//OR the icon so the area around it is not cleared
+	bitmap.store_pen();
+	bitmap.set_pen_flags(SG_PEN_FLAG_IS_BLEND);
+	bitmap.draw_bitmap(p, *entry.bitmap);
+	bitmap.restore_pen();
+
+	if( bounds ){
+		*bounds = entry.bounds;
+		bounds->point.x += p.x;
+		bounds->point.y += p.y;
+	}
+}
+
+int VectorCache::draw(Bitmap & bitmap, const sg_vector_icon_t & icon, const sg_vector_map_t & map, sg_region_t * bounds){
+	sg_pen_t pen = bitmap.pen().item();
+	sg_vector_map_t canvas_map;
+	sg_size_t margin;
+	sg_size_t longest;
+	entry_t entry;
+	u32 hash;
+	u32 size;
+	u32 i;
+
+	if( pen.o_flags & (SG_PEN_FLAG_IS_INVERT | SG_PEN_FLAG_IS_ERASE) ){
+		return -1;
+	}
+	pen.o_flags &= ~SG_PEN_FLAG_IS_BLEND;
+
+	hash = calc_hash(icon);
+	m_clock++;
+	for(i=0; i < m_entries.count(); i++){
+		entry_t & e = m_entries[i];
+		if( (e.hash == hash) && is_match(e, icon, map, pen) ){
+			e.last_used = m_clock;
+			m_hits++;
+			draw_entry(bitmap, e, map, bounds);
+			return 0;
+		}
+	}
+
+	m_misses++;
+
+	//leave room for the pen and for corners that are rotated outside the map
+	margin = pen.thickness + 1;
+	if( map.rotation != 0 ){
+		longest = map.region.dim.width > map.region.dim.height ? map.region.dim.width : map.region.dim.height;
+		margin += longest * 207UL / 1000UL + 1;
+	}
+
+	canvas_map.region.point = sg_point(margin, margin);
+	canvas_map.region.dim = map.region.dim;
+	canvas_map.rotation = map.rotation;
+
+	size = calc_entry_size(map.region.dim.width + 2*margin, map.region.dim.height + 2*margin, icon.total);
+	if( size > m_budget ){
+		return -1;
+	}
+
+	free_entries(m_budget - size);
+
+	entry.bitmap = new Bitmap(map.region.dim.width + 2*margin, map.region.dim.height + 2*margin);
+	if( (entry.bitmap == 0) || (entry.bitmap->data() == 0) ){
+		delete entry.bitmap;
+		return -1;
+	}
+
+	//one extra byte so an icon without primitives still gets a pointer
+	entry.primitives = (sg_vector_primitive_t*)malloc(icon.total*sizeof(sg_vector_primitive_t) + 1);
+	if( entry.primitives == 0 ){
+		delete entry.bitmap;
+		return -1;
+	}
+	memcpy(entry.primitives, icon.primitives, icon.total*sizeof(sg_vector_primitive_t));
+	entry.total = icon.total;
+	entry.fill_total = icon.fill_total;
+
+	entry.bitmap->clear();
+	entry.bitmap->set_pen(pen);
+	api::SgfxObject::sgfx_api()->vector_draw_icon(entry.bitmap->bmap(), &icon, &canvas_map, &entry.bounds);
+
+	entry.hash = hash;
+	entry.last_used = m_clock;
+	entry.dim = map.region.dim;
+	entry.rotation = map.rotation;
+	entry.pen = pen;
+	entry.offset = canvas_map.region.point;
+	entry.size = size;
+
+	if( m_entries.push_back(entry) < 0 ){
+		draw_entry(bitmap, entry, map, bounds);
+		delete entry.bitmap;
+		free(entry.primitives);
+		return 0;
+	}
+
+	m_usage += entry.size;
+	draw_entry(bitmap, entry, map, bounds);
+	return 0;
+}
@@ -0,0 +1,437 @@
+//Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include "sgfx/VectorRasterizer.hpp"
+
+using namespace sgfx;
+
+namespace {
+
+enum {
+	SUBSAMPLES = 4, //anti-aliasing scanlines per pixel
+	CURVE_SEGMENTS_MAX = 32
+};
+
+typedef struct {
+	float x;
+	float y;
+	float cos_r;
+	float sin_r;
+	float scale_x;
+	float scale_y;
+} rasterizer_transform_t;
+
+void rasterizer_set_transform(rasterizer_transform_t & transform, const sg_vector_map_t & map){
+	float angle = map.rotation * 2.0f * (float)M_PI / SG_TRIG_POINTS;
+	transform.cos_r = cosf(angle);
+	transform.sin_r = sinf(angle);
+	transform.scale_x = map.region.dim.width / (2.0f * SG_MAX);
+	transform.scale_y = map.region.dim.height / (2.0f * SG_MAX);
+	transform.x = map.region.point.x + map.region.dim.width / 2.0f;
+	transform.y = map.region.point.y + map.region.dim.height / 2.0f;
+}
+
+//maps a point from vector space (rotated about the center of the map) to pixels
+void rasterizer_map(const rasterizer_transform_t & transform, sg_point_t p, float & x, float & y){
+	float rx = p.x * transform.cos_r - p.y * transform.sin_r;
+	float ry = p.x * transform.sin_r + p.y * transform.cos_r;
+	x = transform.x + rx * transform.scale_x;
+	y = transform.y + ry * transform.scale_y;
+}
+
+//blends \a color over \a dest by \a alpha/256
+sg_color_t rasterizer_blend(sg_color_t dest, sg_color_t color, u32 alpha, u32 bits_per_pixel){
+	u32 shift;
+	u32 result;
+	switch(bits_per_pixel){
+	case 16:
+		{
+			//RGB565
+			s32 r = (dest >> 11) & 0x1f;
+			s32 g = (dest >> 5) & 0x3f;
+			s32 b = dest & 0x1f;
+			r += ((s32)((color >> 11) & 0x1f) - r) * (s32)alpha / 256;
+			g += ((s32)((color >> 5) & 0x3f) - g) * (s32)alpha / 256;
+			b += ((s32)(color & 0x1f) - b) * (s32)alpha / 256;
+			return (r << 11) | (g << 5) | b;
+		}
+	case 32:
+		result = 0;
+		for(shift=0; shift < 32; shift += 8){
+			s32 d = (dest >> shift) & 0xff;
+			d += ((s32)((color >> shift) & 0xff) - d) * (s32)alpha / 256;
+			result |= (u32)d << shift;
+		}
+		return result;
+	default:
+		{
+			//levels (a ramp palette)
+			u32 mask = (1UL << bits_per_pixel) - 1;
+			s32 d = dest & mask;
+			d += ((s32)(color & mask) - d) * (s32)alpha / 256;
+			return d;
+		}
+	}
+}
+
+}
+
+VectorRasterizer::VectorRasterizer(){
+	m_fill_rule = FILL_RULE_NON_ZERO;
+	m_is_antialias = false;
+	m_width = 0;
+	m_coverage_min = 0;
+	m_coverage_max = -1;
+}
+
+int VectorRasterizer::compare_edges(const void * a, const void * b){
+	float y_a = ((const edge_t*)a)->y_top;
+	float y_b = ((const edge_t*)b)->y_top;
+	if( y_a < y_b ){ return -1; }
+	if( y_a > y_b ){ return 1; }
+	return 0;
+}
+
+int VectorRasterizer::add_edge(float x0, float y0, float x1, float y1){
+	edge_t edge;
+
+	if( y0 == y1 ){
+		//horizontal edges never cross a scanline
+		return 0;
+	}
+
+	if( y0 < y1 ){
+		edge.x = x0;
+		edge.y_top = y0;
+		edge.y_bottom = y1;
+		edge.winding = 1;
+	} else {
+		edge.x = x1;
+		edge.y_top = y1;
+		edge.y_bottom = y0;
+		edge.winding = -1;
+	}
+	edge.slope = (x1 - x0) / (y1 - y0);
+	return m_edges.push_back(edge);
+}
+
+int VectorRasterizer::add_curve(const float * x, const float * y, u32 order){
+	float length = 0.0f;
+	float previous_x = x[0];
+	float previous_y = y[0];
+	u32 segments;
+	u32 i;
+
+	//the length of the control polygon is an upper bound on the length of the curve
+	for(i=0; i < order; i++){
+		length += fabsf(x[i+1] - x[i]) + fabsf(y[i+1] - y[i]);
+	}
+
+	segments = 1 + (u32)(sqrtf(length) * 2.0f);
+	if( segments > CURVE_SEGMENTS_MAX ){
+		segments = CURVE_SEGMENTS_MAX;
+	}
+
+	for(i=1; i <= segments; i++){
+		float t = (float)i / segments;
+		float u = 1.0f - t;
+		float next_x, next_y;
+		if( order == 2 ){
+			next_x = u*u*x[0] + 2.0f*u*t*x[1] + t*t*x[2];
+			next_y = u*u*y[0] + 2.0f*u*t*y[1] + t*t*y[2];
+		} else {
+			next_x = u*u*u*x[0] + 3.0f*u*u*t*x[1] + 3.0f*u*t*t*x[2] + t*t*t*x[3];
+			next_y = u*u*u*y[0] + 3.0f*u*u*t*y[1] + 3.0f*u*t*t*y[2] + t*t*t*y[3];
+		}
+		if( add_edge(previous_x, previous_y, next_x, next_y) < 0 ){
+			return -1;
+		}
+		previous_x = next_x;
+		previous_y = next_y;
+	}
+	return 0;
+}
+
+u32 VectorRasterizer::calc_crossings(float y, u32 & next_edge){
+	u32 i;
+	u32 j;
+
+	//edges are sorted by their top so they become active in order
+	while( (next_edge < m_edges.count()) && (m_edges[next_edge].y_top <= y) ){
+		if( m_active.push_back(next_edge) < 0 ){
+			break;
+		}
+		next_edge++;
+	}
+
+	m_crossings.clear();
+	i = 0;
+	while( i < m_active.count() ){
+		const edge_t & edge = m_edges[m_active[i]];
+		if( edge.y_bottom <= y ){
+			//scanlines only move down so the edge is done
+			m_active[i] = m_active[m_active.count()-1];
+			m_active.pop_back();
+			continue;
+		}
+
+		if( edge.y_top <= y ){
+			crossing_t crossing;
+			crossing.x = edge.x + (y - edge.y_top) * edge.slope;
+			crossing.winding = edge.winding;
+			if( m_crossings.push_back(crossing) < 0 ){
+				return 0;
+			}
+
+			//insertion sort -- the list is short and nearly sorted
+			for(j = m_crossings.count() - 1; (j > 0) && (m_crossings[j-1].x > crossing.x); j--){
+				m_crossings[j] = m_crossings[j-1];
+			}
+			m_crossings[j] = crossing;
+		}
+		i++;
+	}
+
+	return m_crossings.count();
+}
+
+void VectorRasterizer::fill_spans(Bitmap & bitmap, sg_int_t y, u32 count){
+	s32 winding = 0;
+	float span_start = 0.0f;
+	u32 i;
+
+	for(i=0; i < count; i++){
+		bool was_inside = is_inside(winding);
+		winding += m_crossings[i].winding;
+
+		if( !was_inside && is_inside(winding) ){
+			span_start = m_crossings[i].x;
+		} else if( was_inside && !is_inside(winding) ){
+			//fill the pixels whose centers are inside the span
+			s32 x0 = (s32)ceilf(span_start - 0.5f);
+			s32 x1 = (s32)ceilf(m_crossings[i].x - 0.5f);
+			if( x0 < 0 ){ x0 = 0; }
+			if( x1 > m_width ){ x1 = m_width; }
+			if( x0 < x1 ){
+				bitmap.draw_rectangle(sg_point(x0, y), sg_dim(x1 - x0, 1));
+			}
+		}
+	}
+}
+
+void VectorRasterizer::add_coverage(u32 count, float weight){
+	s32 winding = 0;
+	float span_start = 0.0f;
+	u32 i;
+
+	for(i=0; i < count; i++){
+		bool was_inside = is_inside(winding);
+		winding += m_crossings[i].winding;
+
+		if( !was_inside && is_inside(winding) ){
+			span_start = m_crossings[i].x;
+		} else if( was_inside && !is_inside(winding) ){
+			float x0 = span_start < 0.0f ? 0.0f : span_start;
+			float x1 = m_crossings[i].x > m_width ? m_width : m_crossings[i].x;
+			s32 first;
+			s32 last;
+			s32 x;
+
+			if( x0 >= x1 ){
+				continue;
+			}
+
+			first = (s32)x0;
+			last = (s32)x1;
+			if( last >= m_width ){
+				last = m_width - 1;
+			}
+
+			if( first < m_coverage_min ){ m_coverage_min = first; }
+			if( last > m_coverage_max ){ m_coverage_max = last; }
+
+			if( first == last ){
+				m_coverage[first] += (x1 - x0) * weight;
+			} else {
+				//partial pixels at the ends, full pixels between
+				m_coverage[first] += (first + 1 - x0) * weight;
+				for(x = first + 1; x < last; x++){
+					m_coverage[x] += weight;
+				}
+				m_coverage[last] += (x1 - last) * weight;
+			}
+		}
+	}
+}
+
+void VectorRasterizer::draw_coverage(Bitmap & bitmap, sg_int_t y, u32 bits_per_pixel){
+	sg_color_t color = bitmap.pen_color();
+	s32 run_start = -1;
+	s32 x;
+
+	for(x = m_coverage_min; x <= m_coverage_max + 1; x++){
+		float coverage = x <= m_coverage_max ? m_coverage[x] : 0.0f;
+		u32 alpha = (u32)(coverage * 256.0f + 0.5f);
+
+		if( alpha >= 256 ){
+			//fully covered pixels are drawn in runs
+			if( run_start < 0 ){
+				run_start = x;
+			}
+		} else {
+			if( run_start >= 0 ){
+				bitmap.draw_rectangle(sg_point(run_start, y), sg_dim(x - run_start, 1));
+				run_start = -1;
+			}
+
+			if( alpha > 0 ){
+				sg_point_t p = sg_point(x, y);
+				bitmap.store_pen();
+				bitmap.set_pen_flags(SG_PEN_FLAG_IS_SOLID);
+				bitmap.set_pen_color(rasterizer_blend(bitmap.get_pixel(p), color, alpha, bits_per_pixel));
+				bitmap.draw_pixel(p);
+				bitmap.restore_pen();
+			}
+		}
+
+		if( x <= m_coverage_max ){
+			m_coverage[x] = 0.0f;
+		}
+	}
+
+	m_coverage_min = m_width;
+	m_coverage_max = -1;
+}
+
+int VectorRasterizer::fill(Bitmap & bitmap, const sg_vector_path_description_t * items, u32 count, const sg_vector_map_t & map){
+	rasterizer_transform_t transform;
+	float start_x = 0.0f, start_y = 0.0f;
+	float x = 0.0f, y = 0.0f;
+	float curve_x[4];
+	float curve_y[4];
+	float y_bottom;
+	bool is_open = false;
+	bool use_antialias;
+	u32 bits_per_pixel = Bitmap::bits_per_pixel();
+	u32 next_edge;
+	u32 i;
+	s32 row;
+	s32 row_end;
+
+	m_edges.clear();
+	m_active.clear();
+	m_width = bitmap.width();
+	rasterizer_set_transform(transform, map);
+
+	for(i=0; i < count; i++){
+		const sg_vector_path_description_t & item = items[i];
+		int result = 0;
+		switch(item.type){
+		case SG_VECTOR_PATH_MOVE:
+			if( is_open ){
+				result = add_edge(x, y, start_x, start_y);
+			}
+			rasterizer_map(transform, item.move.point, x, y);
+			start_x = x;
+			start_y = y;
+			is_open = true;
+			break;
+		case SG_VECTOR_PATH_LINE:
+			curve_x[0] = x;
+			curve_y[0] = y;
+			rasterizer_map(transform, item.line.point, x, y);
+			result = add_edge(curve_x[0], curve_y[0], x, y);
+			break;
+		case SG_VECTOR_PATH_QUADRATIC_BEZIER:
+			curve_x[0] = x;
+			curve_y[0] = y;
+			rasterizer_map(transform, item.quadratic_bezier.control, curve_x[1], curve_y[1]);
+			rasterizer_map(transform, item.quadratic_bezier.point, x, y);
+			curve_x[2] = x;
+			curve_y[2] = y;
+			result = add_curve(curve_x, curve_y, 2);
+			break;
+		case SG_VECTOR_PATH_CUBIC_BEZIER:
+			curve_x[0] = x;
+			curve_y[0] = y;
+			rasterizer_map(transform, item.cubic_bezier.control[0], curve_x[1], curve_y[1]);
+			rasterizer_map(transform, item.cubic_bezier.control[1], curve_x[2], curve_y[2]);
+			rasterizer_map(transform, item.cubic_bezier.point, x, y);
+			curve_x[3] = x;
+			curve_y[3] = y;
+			result = add_curve(curve_x, curve_y, 3);
+			break;
+		case SG_VECTOR_PATH_CLOSE:
+			result = add_edge(x, y, start_x, start_y);
+			x = start_x;
+			y = start_y;
+			break;
+		default:
+			//pours aren't needed to fill
+			break;
+		}
+
+		if( result < 0 ){
+			set_error_number(ENOMEM);
+			return -1;
+		}
+	}
+
+	if( is_open && (add_edge(x, y, start_x, start_y) < 0) ){
+		set_error_number(ENOMEM);
+		return -1;
+	}
+
+	if( m_edges.count() == 0 ){
+		return 0;
+	}
+
+	qsort(m_edges.vector_data(), m_edges.count(), sizeof(edge_t), compare_edges);
+
+	y_bottom = m_edges[0].y_bottom;
+	for(i=1; i < m_edges.count(); i++){
+		if( m_edges[i].y_bottom > y_bottom ){
+			y_bottom = m_edges[i].y_bottom;
+		}
+	}
+
+	row = (s32)floorf(m_edges[0].y_top);
+	row_end = (s32)ceilf(y_bottom);
+	if( row < 0 ){ row = 0; }
+	if( row_end > bitmap.height() ){ row_end = bitmap.height(); }
+
+	//blending only makes sense for solid pens with enough levels
+	use_antialias = m_is_antialias &&
+			(bits_per_pixel >= 4) &&
+			((bitmap.pen_flags() & (SG_PEN_FLAG_IS_INVERT | SG_PEN_FLAG_IS_ERASE | SG_PEN_FLAG_IS_BLEND)) == 0);
+
+	if( use_antialias ){
+		if( (m_coverage.count() < (u32)m_width) && (m_coverage.resize(m_width) < 0) ){
+			set_error_number(ENOMEM);
+			return -1;
+		}
+		for(i=0; i < (u32)m_width; i++){
+			m_coverage[i] = 0.0f;
+		}
+		m_coverage_min = m_width;
+		m_coverage_max = -1;
+	}
+
+	next_edge = 0;
+	for(; row < row_end; row++){
+		if( use_antialias ){
+			u32 sample;
+			for(sample=0; sample < SUBSAMPLES; sample++){
+				u32 crossings = calc_crossings(row + (sample + 0.5f) / SUBSAMPLES, next_edge);
+				add_coverage(crossings, 1.0f / SUBSAMPLES);
+			}
+			draw_coverage(bitmap, row, bits_per_pixel);
+		} else {
+			fill_spans(bitmap, row, calc_crossings(row + 0.5f, next_edge));
+		}
+	}
+
+	return 0;
+}
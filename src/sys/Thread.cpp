@@ -1,10 +1,10 @@
 //Copyright 2011-2018 Tyler Gilbert; All Rights Reserved
 
-#if !defined __link
-
 #include <errno.h>
 #include "sys/Thread.hpp"
+#if !defined __link
 #include "chrono.hpp"
+#endif
 using namespace sys;
 
 Thread::Thread(int stack_size, bool detached) {
@@ -145,6 +145,11 @@ int Thread::create(handler_function_t func, void * args, int prio, enum Sched::p
 }
 
 bool Thread::is_running() const {
+    //the id is not a thread until create() succeeds
+    if( !is_valid() ){
+        return false;
+    }
+
     //check to see if the thread is running
     if( pthread_kill(m_id, 0) == 0 ){
         return true;
@@ -168,7 +173,11 @@ int Thread::wait(void**ret, int interval){
         } else {
             //just keep sampling until the thread completes
             while( is_running() ){
+#if defined __link
+                usleep(interval*1000);
+#else
                 Timer::wait_milliseconds(interval);
+#endif
             }
         }
     }
@@ -195,7 +204,7 @@ int Thread::reset(){
     return -1;
 }
 
-int Thread::join(int ident, void ** value_ptr){
+int Thread::join(pthread_t ident, void ** value_ptr){
     void * tmp_ptr;
     void ** ptr;
     if( value_ptr == 0 ){
@@ -221,6 +230,3 @@ int Thread::join(void ** value_ptr) const {
     }
     return set_error_number_if_error(pthread_join(id(), ptr));
 }
-
-#endif
-
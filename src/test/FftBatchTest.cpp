@@ -0,0 +1,129 @@
+#include <cstdio>
+#include <cstring>
+#include "chrono/Timer.hpp"
+#include "test/FftBatchTest.hpp"
+
+using namespace test;
+using namespace dsp;
+
+namespace {
+
+bool is_match(const SignalF32 & a, const SignalF32 & b){
+    return memcmp(a.vector_data_const(), b.vector_data_const(), a.count()*sizeof(float32_t)) == 0;
+}
+
+//channels per microsecond times one million
+u32 calc_channels_per_second(u32 channels, u32 iterations, u32 microseconds){
+    if( microseconds == 0 ){
+        microseconds = 1;
+    }
+    return (u32)((u64)channels * iterations * 1000000UL / microseconds);
+}
+
+}
+
+FftBatchTest::FftBatchTest(Test * parent) : Test("fft batch", parent){}
+
+bool FftBatchTest::is_api_installed(){
+    if( api::DspWorkObject::arm_dsp_api_f32() == 0 ){
+        print_case_message("the f32 DSP functions are not installed");
+        return false;
+    }
+    return true;
+}
+
+bool FftBatchTest::execute_class_api_case(){
+    SignalF32 input(SAMPLES*CHANNELS);
+    SignalF32 interleaved(SAMPLES*CHANNELS);
+    SignalF32 expected(SAMPLES*CHANNELS);
+    SignalF32 output(SAMPLES*CHANNELS);
+    bool result = true;
+    u32 seed = 1;
+    u32 threads;
+    u32 i;
+
+    if( is_api_installed() == false ){
+        return false;
+    }
+
+    if( (input.count() != SAMPLES*CHANNELS) || (interleaved.count() != SAMPLES*CHANNELS) ||
+            (expected.count() != SAMPLES*CHANNELS) || (output.count() != SAMPLES*CHANNELS) ){
+        print_case_message("failed to allocate signals");
+        return false;
+    }
+
+    for(i=0; i < SAMPLES*CHANNELS; i++){
+        seed = seed * 1103515245 + 12345;
+        input[i] = ((seed >> 8) & 0xffff) / 65536.0f - 0.5f;
+    }
+
+    for(i=0; i < SAMPLES*CHANNELS; i++){
+        interleaved[(i % SAMPLES)*CHANNELS + i / SAMPLES] = input[i];
+    }
+
+    {
+        FftBatchRealF32 fft(SAMPLES, CHANNELS, 1);
+        if( fft.transform(expected, input) < 0 ){
+            print_case_message("failed to transform");
+            return false;
+        }
+    }
+
+    for(threads = 1; threads <= FftBatchRealF32::MAX_THREADS; threads++){
+        FftBatchRealF32 fft(SAMPLES, CHANNELS, threads);
+
+        if( (fft.transform(output, input) < 0) || !is_match(expected, output) ){
+            print_case_message("channel major with %ld threads doesn't match", threads);
+            result = false;
+        }
+
+        if( (fft.transform(output, interleaved, FftBatchRealF32::INTERLEAVED) < 0) || !is_match(expected, output) ){
+            print_case_message("interleaved with %ld threads doesn't match", threads);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+bool FftBatchTest::execute_class_performance_case(){
+    SignalF32 input(SAMPLES*CHANNELS);
+    SignalF32 output(SAMPLES*CHANNELS);
+    chrono::Timer timer;
+    char key[32];
+    u32 threads;
+    u32 i;
+
+    if( is_api_installed() == false ){
+        return false;
+    }
+
+    if( (input.count() != SAMPLES*CHANNELS) || (output.count() != SAMPLES*CHANNELS) ){
+        print_case_message("failed to allocate signals");
+        return false;
+    }
+
+    for(i=0; i < SAMPLES*CHANNELS; i++){
+        input[i] = (i % 17) / 17.0f - 0.5f;
+    }
+
+    print_case_message_with_key("samples", "%d", SAMPLES);
+    print_case_message_with_key("channels", "%d", CHANNELS);
+
+    for(threads = 1; threads <= FftBatchRealF32::MAX_THREADS; threads *= 2){
+        FftBatchRealF32 fft(SAMPLES, CHANNELS, threads);
+
+        timer.restart();
+        for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+            if( fft.transform(output, input) < 0 ){
+                print_case_message("failed to transform with %ld threads", threads);
+                return false;
+            }
+        }
+        timer.stop();
+        snprintf(key, sizeof(key), "%ld threads channels/s", threads);
+        print_case_message_with_key(key, "%ld", calc_channels_per_second(CHANNELS, PERFORMANCE_ITERATIONS, timer.microseconds()));
+    }
+
+    return true;
+}
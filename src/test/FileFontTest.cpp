@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <cstring>
+#include "chrono/Timer.hpp"
+#include "test/FileFontTest.hpp"
+
+using namespace test;
+using namespace sgfx;
+
+namespace {
+
+//glyphs per microsecond times one million
+u32 calc_glyphs_per_second(u32 glyphs, u32 microseconds){
+    if( microseconds == 0 ){
+        microseconds = 1;
+    }
+    return (u32)((u64)glyphs * 1000000UL / microseconds);
+}
+
+}
+
+FileFontTest::FileFontTest(const char * path, Test * parent) : Test("file font", parent){
+    m_path = path;
+}
+
+bool FileFontTest::open(FileFont & font){
+    if( (font.set_file(m_path) < 0) || (font.get_height() == 0) ){
+        print_case_message("failed to open %s", m_path);
+        return false;
+    }
+    return true;
+}
+
+u32 FileFontTest::draw_all(const FileFont & font, Bitmap & bitmap){
+    sg_point_t point = sg_point(0,0);
+    u32 glyphs = 0;
+    char c;
+
+    //each printable character once, wrapping to the next line at the edge of the bitmap
+    for(c = ' '; c <= '~'; c++){
+        int advance = font.draw_char(c, bitmap, point);
+        if( advance >= 0 ){
+            glyphs++;
+            point.x += advance;
+            if( point.x + font.get_height() > bitmap.width() ){
+                point.x = 0;
+                point.y += font.get_height();
+                if( point.y + font.get_height() > bitmap.height() ){
+                    point.y = 0;
+                }
+            }
+        }
+    }
+    return glyphs;
+}
+
+bool FileFontTest::execute_class_api_case(){
+    FileFont font;
+    Bitmap expected(BITMAP_WIDTH, BITMAP_HEIGHT);
+    Bitmap actual(BITMAP_WIDTH, BITMAP_HEIGHT);
+    u8 cache_size;
+
+    if( (expected.data() == 0) || (actual.data() == 0) ){
+        print_case_message("failed to allocate bitmaps");
+        return false;
+    }
+
+    if( open(font) == false ){
+        return false;
+    }
+
+    cache_size = font.canvas_cache_size();
+
+    //a one canvas cache is reloaded whenever the canvas changes
+    font.set_canvas_cache_size(1);
+    expected.clear();
+    if( draw_all(font, expected) == 0 ){
+        print_case_message("no characters were drawn");
+        return false;
+    }
+
+    font.set_canvas_cache_size(cache_size);
+    actual.clear();
+    draw_all(font, actual);
+    actual.clear();
+    draw_all(font, actual); //drawn from the cache
+
+    if( memcmp(expected.data(), actual.data(), expected.calc_size()) != 0 ){
+        print_case_message("cached canvases don't match canvases read from the file");
+        return false;
+    }
+
+    return true;
+}
+
+bool FileFontTest::execute_class_performance_case(){
+    FileFont font;
+    Bitmap bitmap(BITMAP_WIDTH, BITMAP_HEIGHT);
+    chrono::Timer timer;
+    u32 cold_timer_value = 0;
+    u32 glyphs = 0;
+    u32 loads;
+    u32 i;
+
+    if( bitmap.data() == 0 ){
+        print_case_message("failed to allocate a bitmap");
+        return false;
+    }
+
+    if( open(font) == false ){
+        return false;
+    }
+
+    print_case_message_with_key("canvas cache size", "%d", font.canvas_cache_size());
+
+    //cold -- the canvases are freed before each pass
+    loads = font.canvas_loads();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        font.set_canvas_cache_size(font.canvas_cache_size());
+        timer.restart();
+        glyphs += draw_all(font, bitmap);
+        timer.stop();
+        cold_timer_value += timer.microseconds();
+    }
+    print_case_message_with_key("cold glyphs/s", "%ld", calc_glyphs_per_second(glyphs, cold_timer_value));
+    print_case_message_with_key("cold canvas loads per pass", "%ld", (font.canvas_loads() - loads) / PERFORMANCE_ITERATIONS);
+
+    //warm -- the canvases loaded by the first pass stay in memory
+    draw_all(font, bitmap);
+    loads = font.canvas_loads();
+    glyphs = 0;
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        glyphs += draw_all(font, bitmap);
+    }
+    timer.stop();
+    print_case_message_with_key("warm glyphs/s", "%ld", calc_glyphs_per_second(glyphs, timer.microseconds()));
+    print_case_message_with_key("warm canvas loads per pass", "%ld", (font.canvas_loads() - loads) / PERFORMANCE_ITERATIONS);
+
+    return true;
+}
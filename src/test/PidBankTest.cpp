@@ -0,0 +1,130 @@
+#include <cstdio>
+#include "chrono/Timer.hpp"
+#include "test/PidBankTest.hpp"
+
+using namespace test;
+using namespace calc;
+
+namespace {
+
+//loops per microsecond times one million
+u32 calc_loops_per_second(u32 loops, u32 iterations, u32 microseconds){
+    if( microseconds == 0 ){
+        microseconds = 1;
+    }
+    return (u32)((u64)loops * iterations * 1000000UL / microseconds);
+}
+
+}
+
+PidBankTest::PidBankTest(Test * parent) : Test("pid bank", parent){}
+
+template<typename T> bool PidBankTest::check_bank(PidBank<T> & bank, const char * name){
+    T present_value[LOOP_COUNT];
+    T control_variable[LOOP_COUNT];
+    bool result = true;
+    u32 i;
+
+    if( bank.count() != LOOP_COUNT ){
+        print_case_message("%s failed to allocate %d loops", name, LOOP_COUNT);
+        return false;
+    }
+
+    //with the default gain (kp = 1), the output is the error
+    for(i=0; i < LOOP_COUNT; i++){
+        bank.set_target(i, 1000);
+        present_value[i] = (T)(i*10);
+        control_variable[i] = -1;
+    }
+
+    bank.set_max(1, 500);
+    bank.set_min(2, 995);
+    bank.set_enabled(3, false);
+
+    bank.calc_control_variable(present_value, control_variable);
+
+    for(i=0; i < LOOP_COUNT; i++){
+        T expected = (T)(1000 - i*10);
+        if( i == 1 ){ expected = 500; }
+        if( i == 2 ){ expected = 995; }
+        if( i == 3 ){ expected = -1; }
+        if( control_variable[i] != expected ){
+            print_case_message("%s loop %ld is %ld (not %ld)", name, i, (s32)control_variable[i], (s32)expected);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+template<typename T> void PidBankTest::measure(PidBank<T> & bank, const char * name){
+    T present_value[LOOP_COUNT];
+    T control_variable[LOOP_COUNT];
+    chrono::Timer timer;
+    char key[48];
+    u32 i;
+
+    for(i=0; i < LOOP_COUNT; i++){
+        bank.set_ki(i, 0);
+        bank.set_target(i, 1000);
+        present_value[i] = (T)i;
+    }
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        bank.calc_control_variable(present_value, control_variable);
+        present_value[i % LOOP_COUNT] = control_variable[(i + 1) % LOOP_COUNT];
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s loops/s", name);
+    print_case_message_with_key(key, "%ld", calc_loops_per_second(LOOP_COUNT, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    //half the loops disabled (the enable mask is checked for each loop)
+    for(i=0; i < LOOP_COUNT; i += 2){
+        bank.set_enabled(i, false);
+    }
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        bank.calc_control_variable(present_value, control_variable);
+        present_value[i % LOOP_COUNT] = control_variable[(i + 1) % LOOP_COUNT];
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s half enabled loops/s", name);
+    print_case_message_with_key(key, "%ld", calc_loops_per_second(LOOP_COUNT/2, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    for(i=0; i < LOOP_COUNT; i++){
+        bank.set_enabled(i);
+    }
+}
+
+bool PidBankTest::execute_class_api_case(){
+    bool result = true;
+
+    PidBank_f bank_f(LOOP_COUNT);
+    if( check_bank(bank_f, "float") == false ){
+        result = false;
+    }
+
+    PidBank_s32 bank_s32(LOOP_COUNT);
+    if( check_bank(bank_s32, "s32") == false ){
+        result = false;
+    }
+
+    return result;
+}
+
+bool PidBankTest::execute_class_performance_case(){
+    PidBank_f bank_f(LOOP_COUNT);
+    PidBank_s32 bank_s32(LOOP_COUNT);
+
+    if( (bank_f.count() != LOOP_COUNT) || (bank_s32.count() != LOOP_COUNT) ){
+        print_case_message("failed to allocate %d loops", LOOP_COUNT);
+        return false;
+    }
+
+    print_case_message_with_key("loops", "%d", LOOP_COUNT);
+    measure(bank_f, "float");
+    measure(bank_s32, "s32");
+    return true;
+}
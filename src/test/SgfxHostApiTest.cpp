@@ -0,0 +1,313 @@
+#include <cstdio>
+#include <cstring>
+#include "chrono/Timer.hpp"
+#include "test/SgfxHostApiTest.hpp"
+#include "../api/SgfxHostApi.h"
+
+using namespace test;
+
+namespace {
+
+const u16 check_flags[] = {
+        0,
+        SG_PEN_FLAG_IS_SOLID,
+        SG_PEN_FLAG_IS_BLEND,
+        SG_PEN_FLAG_IS_INVERT,
+        SG_PEN_FLAG_IS_ERASE,
+        SG_PEN_FLAG_IS_SOLID | SG_PEN_FLAG_IS_FILL
+};
+
+//x, y, width, height (the destination is 83 x 9)
+const s16 check_regions[][4] = {
+        { 0, 0, 83, 9 },
+        { 1, 1, 1, 1 },
+        { 3, 2, 70, 5 },
+        { 31, 0, 34, 3 },
+        { -5, -3, 20, 6 },
+        { 60, 4, 40, 20 },
+        { 17, 5, 0, 3 }
+};
+
+const u32 check_colors[] = { 0xffffffff, 0x00000001, 0x5a3c96e1 };
+
+#define CHECK_COUNT(x) (sizeof(x)/sizeof(x[0]))
+
+sg_region_t check_region(u32 i){
+    return sg_region(sg_point(check_regions[i][0], check_regions[i][1]), sg_dim(check_regions[i][2], check_regions[i][3]));
+}
+
+sg_point_t check_point(const s16 point[2]){
+    return sg_point(point[0], point[1]);
+}
+
+//pixels per microsecond is megapixels per second
+u32 calc_megapixels_per_second(u32 pixels, u32 iterations, u32 microseconds){
+    if( microseconds == 0 ){
+        microseconds = 1;
+    }
+    return (u32)((u64)pixels * iterations / microseconds);
+}
+
+}
+
+SgfxHostApiTest::SgfxHostApiTest(Test * parent) : Test("sgfx host api", parent){
+    m_reference = sg_api();
+    m_api = sgfx_host_api();
+    m_seed = 1;
+}
+
+bool SgfxHostApiTest::set_bitmaps(){
+    const sg_dim_t dest_dim = sg_dim(DEST_WIDTH, DEST_HEIGHT);
+    const sg_dim_t src_dim = sg_dim(SRC_WIDTH, SRC_HEIGHT);
+
+    if( (m_reference->calc_bmap_size(dest_dim) > WORDS*sizeof(sg_bmap_data_t)) ||
+            (m_reference->calc_bmap_size(src_dim) > WORDS*sizeof(sg_bmap_data_t)) ){
+        print_case_message("%d bits per pixel is not supported", m_reference->bits_per_pixel);
+        return false;
+    }
+
+    if( m_memory.resize(3*WORDS) < 0 ){
+        print_case_message("failed to allocate bitmaps");
+        return false;
+    }
+
+    m_reference->bmap_set_data(&m_expected, m_memory.vector_data(), dest_dim);
+    m_reference->bmap_set_data(&m_actual, m_memory.vector_data() + WORDS, dest_dim);
+    m_reference->bmap_set_data(&m_src, m_memory.vector_data() + 2*WORDS, src_dim);
+    return true;
+}
+
+void SgfxHostApiTest::reset(u16 o_flags, sg_color_t color){
+    //fills the bitmaps with the same random data and sets the pen
+    sg_bmap_data_t * expected = m_memory.vector_data();
+    sg_bmap_data_t * actual = expected + WORDS;
+    sg_bmap_data_t * src = expected + 2*WORDS;
+    u32 i;
+    for(i=0; i < WORDS; i++){
+        expected[i] = random();
+        src[i] = random();
+    }
+    memcpy(actual, expected, WORDS*sizeof(sg_bmap_data_t));
+    m_expected.pen.o_flags = o_flags;
+    m_expected.pen.color = color;
+    m_expected.pen.thickness = 1;
+    m_actual.pen = m_expected.pen;
+}
+
+bool SgfxHostApiTest::is_match() const {
+    const sg_bmap_data_t * expected = m_memory.vector_data_const();
+    return memcmp(expected, expected + WORDS, WORDS*sizeof(sg_bmap_data_t)) == 0;
+}
+
+u32 SgfxHostApiTest::random(){
+    m_seed = m_seed * 1664525UL + 1013904223UL;
+    return m_seed;
+}
+
+bool SgfxHostApiTest::execute_class_api_case(){
+    bool result = true;
+
+    if( set_bitmaps() == false ){
+        return false;
+    }
+
+    if( check_rectangle() == false ){
+        print_case_message("draw_rectangle() does not match sg_api()");
+        result = false;
+    }
+
+    if( check_pattern() == false ){
+        print_case_message("draw_pattern() does not match sg_api()");
+        result = false;
+    }
+
+    if( check_bitmap() == false ){
+        print_case_message("draw_bitmap() does not match sg_api()");
+        result = false;
+    }
+
+    if( check_sub_bitmap() == false ){
+        print_case_message("draw_sub_bitmap() does not match sg_api()");
+        result = false;
+    }
+
+    if( check_hline() == false ){
+        print_case_message("cursor_draw_hline() does not match sg_api()");
+        result = false;
+    }
+
+    return result;
+}
+
+bool SgfxHostApiTest::check_rectangle(){
+    u32 f, r, c;
+    for(f=0; f < CHECK_COUNT(check_flags); f++){
+        for(r=0; r < CHECK_COUNT(check_regions); r++){
+            for(c=0; c < CHECK_COUNT(check_colors); c++){
+                sg_region_t region = check_region(r);
+                reset(check_flags[f], check_colors[c]);
+                m_reference->draw_rectangle(&m_expected, &region);
+                m_api->draw_rectangle(&m_actual, &region);
+                if( is_match() == false ){ return false; }
+            }
+        }
+    }
+    return true;
+}
+
+bool SgfxHostApiTest::check_pattern(){
+    u32 f, r, h;
+    for(f=0; f < CHECK_COUNT(check_flags); f++){
+        for(r=0; r < CHECK_COUNT(check_regions); r++){
+            for(h=1; h < 4; h++){
+                sg_region_t region = check_region(r);
+                u32 odd = random();
+                u32 even = random();
+                reset(check_flags[f], check_colors[h % CHECK_COUNT(check_colors)]);
+                m_reference->draw_pattern(&m_expected, &region, odd, even, h);
+                m_api->draw_pattern(&m_actual, &region, odd, even, h);
+                if( is_match() == false ){ return false; }
+            }
+        }
+    }
+    return true;
+}
+
+bool SgfxHostApiTest::check_bitmap(){
+    const s16 points[][2] = { {0, 0}, {1, 2}, {33, 1}, {-7, -2}, {70, 6}, {-40, 0} };
+    u32 f, p;
+    for(f=0; f < CHECK_COUNT(check_flags); f++){
+        for(p=0; p < CHECK_COUNT(points); p++){
+            reset(check_flags[f], check_colors[0]);
+            m_reference->draw_bitmap(&m_expected, check_point(points[p]), &m_src);
+            m_api->draw_bitmap(&m_actual, check_point(points[p]), &m_src);
+            if( is_match() == false ){ return false; }
+        }
+    }
+    return true;
+}
+
+bool SgfxHostApiTest::check_sub_bitmap(){
+    const s16 points[][2] = { {0, 0}, {5, 1}, {39, 3}, {-3, -1}, {75, 2} };
+    u32 f, p, r;
+    for(f=0; f < CHECK_COUNT(check_flags); f++){
+        for(p=0; p < CHECK_COUNT(points); p++){
+            for(r=0; r < CHECK_COUNT(check_regions); r++){
+                sg_region_t region = check_region(r);
+                reset(check_flags[f], check_colors[0]);
+                m_reference->draw_sub_bitmap(&m_expected, check_point(points[p]), &m_src, &region);
+                m_api->draw_sub_bitmap(&m_actual, check_point(points[p]), &m_src, &region);
+                if( is_match() == false ){ return false; }
+            }
+        }
+    }
+    return true;
+}
+
+bool SgfxHostApiTest::check_hline(){
+    const s16 points[][2] = { {0, 0}, {3, 1}, {31, 4}, {40, 8} };
+    const sg_size_t widths[] = { 1, 2, 9, 33, 43 };
+    u32 f, p, w, c;
+    for(f=0; f < CHECK_COUNT(check_flags); f++){
+        for(p=0; p < CHECK_COUNT(points); p++){
+            for(w=0; w < CHECK_COUNT(widths); w++){
+                for(c=0; c < CHECK_COUNT(check_colors); c++){
+                    sg_cursor_t expected;
+                    sg_cursor_t actual;
+                    reset(check_flags[f], check_colors[c]);
+                    m_reference->cursor_set(&expected, &m_expected, check_point(points[p]));
+                    m_reference->cursor_set(&actual, &m_actual, check_point(points[p]));
+                    m_reference->cursor_draw_hline(&expected, widths[w]);
+                    m_api->cursor_draw_hline(&actual, widths[w]);
+                    //the cursor must also end on the same pixel
+                    if( (is_match() == false) ||
+                            (expected.target - m_expected.data != actual.target - m_actual.data) ||
+                            (expected.shift != actual.shift) ){
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool SgfxHostApiTest::execute_class_performance_case(){
+    const sg_dim_t dim = sg_dim(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT);
+    const u32 words = (m_reference->calc_bmap_size(dim) + sizeof(sg_bmap_data_t) - 1) / sizeof(sg_bmap_data_t);
+    var::Vector<sg_bmap_data_t> memory;
+    sg_bmap_t dest;
+    sg_bmap_t src;
+
+    if( memory.resize(2*words) < 0 ){
+        print_case_message("failed to allocate bitmaps");
+        return false;
+    }
+    memset(memory.vector_data(), 0x5a, 2*words*sizeof(sg_bmap_data_t));
+
+    m_reference->bmap_set_data(&dest, memory.vector_data(), dim);
+    m_reference->bmap_set_data(&src, memory.vector_data() + words, dim);
+    dest.pen.o_flags = SG_PEN_FLAG_IS_SOLID;
+    dest.pen.color = 0xffffffff;
+    dest.pen.thickness = 1;
+
+    measure("sg_api", m_reference, &dest, &src);
+    measure("host", m_api, &dest, &src);
+    return true;
+}
+
+void SgfxHostApiTest::measure(const char * name, const sg_api_t * api, const sg_bmap_t * dest, const sg_bmap_t * src){
+    //the sub-bitmap and point are not word aligned
+    const sg_region_t all = sg_region(sg_point(0,0), sg_dim(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT));
+    const sg_region_t sub = sg_region(sg_point(3,5), sg_dim(PERFORMANCE_WIDTH - 16, PERFORMANCE_HEIGHT - 16));
+    const u32 pixels = PERFORMANCE_WIDTH * PERFORMANCE_HEIGHT;
+    const u32 sub_pixels = (PERFORMANCE_WIDTH - 16) * (PERFORMANCE_HEIGHT - 16);
+    chrono::Timer timer;
+    char key[48];
+    u32 i;
+    sg_int_t y;
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        api->draw_rectangle(dest, &all);
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s draw_rectangle", name);
+    print_case_message_with_key(key, "%ld megapixels/s", calc_megapixels_per_second(pixels, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        api->draw_pattern(dest, &all, 0xaaaaaaaa, 0x55555555, 2);
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s draw_pattern", name);
+    print_case_message_with_key(key, "%ld megapixels/s", calc_megapixels_per_second(pixels, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        api->draw_bitmap(dest, sg_point(0,0), src);
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s draw_bitmap", name);
+    print_case_message_with_key(key, "%ld megapixels/s", calc_megapixels_per_second(pixels, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        api->draw_sub_bitmap(dest, sg_point(7,1), src, &sub);
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s draw_sub_bitmap", name);
+    print_case_message_with_key(key, "%ld megapixels/s", calc_megapixels_per_second(sub_pixels, PERFORMANCE_ITERATIONS, timer.microseconds()));
+
+    timer.restart();
+    for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+        for(y=0; y < PERFORMANCE_HEIGHT; y++){
+            sg_cursor_t cursor;
+            m_reference->cursor_set(&cursor, dest, sg_point(0,y));
+            api->cursor_draw_hline(&cursor, PERFORMANCE_WIDTH);
+        }
+    }
+    timer.stop();
+    snprintf(key, sizeof(key), "%s cursor_draw_hline", name);
+    print_case_message_with_key(key, "%ld megapixels/s", calc_megapixels_per_second(pixels, PERFORMANCE_ITERATIONS, timer.microseconds()));
+}
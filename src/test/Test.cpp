@@ -115,9 +115,13 @@ void Test::initialize(const char * name, const char * version){
 
     print_indent(0, "{\n");
 
+    print_indent(1, "\"system\": {\n");
+#if defined __link
+    //link builds run on the host (no device is connected)
+    print_indent(2, "\"name\": \"host\"\n");
+#else
     Sys sys;
     sys_info_t info;
-    print_indent(1, "\"system\": {\n");
     if( (sys.open() < 0) || (sys.get_info(info) < 0) ){
         print_indent(2, "\"name\": \"unknown\"\n");
     } else {
@@ -132,6 +136,7 @@ void Test::initialize(const char * name, const char * version){
 
     }
     sys.close();
+#endif
     print_indent(1, "},\n");
     print_indent(1, "\"test\": {\n");
     print_indent(2, "\"name\": \"%s\",\n", name);
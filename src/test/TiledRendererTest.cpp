@@ -0,0 +1,128 @@
+#include <cstdio>
+#include <cstring>
+#include "chrono/Timer.hpp"
+#include "test/TiledRendererTest.hpp"
+
+using namespace test;
+using namespace sgfx;
+
+namespace {
+
+bool is_match(Bitmap & a, Bitmap & b){
+    return memcmp(a.data(), b.data(), a.calc_size()) == 0;
+}
+
+//frames per second for the total microseconds of all iterations
+u32 calc_frames_per_second(u32 iterations, u32 microseconds){
+    if( microseconds == 0 ){
+        microseconds = 1;
+    }
+    return (u32)((u64)iterations * 1000000UL / microseconds);
+}
+
+}
+
+TiledRendererTest::TiledRendererTest(Test * parent) : Test("tiled renderer", parent){}
+
+void TiledRendererTest::record(TiledRenderer & renderer, const Bitmap & src){
+    u32 seed = 1;
+    u32 i;
+
+    renderer.clear();
+    renderer.pen().set_solid();
+    renderer.pen().set_color(0xffffffff);
+    renderer.draw_pattern(sg_region(sg_point(0,0), sg_dim(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT)), 0xaaaaaaaa, 0x55555555, 2);
+
+    //overlapping rectangles, lines and bitmaps spread across every tile
+    renderer.pen().set_invert();
+    for(i=0; i < 64; i++){
+        sg_int_t x, y;
+        seed = seed * 1103515245 + 12345;
+        x = (seed >> 8) % PERFORMANCE_WIDTH - 16;
+        y = (seed >> 20) % PERFORMANCE_HEIGHT - 16;
+        renderer.draw_rectangle(sg_region(sg_point(x,y), sg_dim(48 + i % 32, 32 + i % 24)));
+        renderer.draw_line(sg_point(x,y), sg_point(PERFORMANCE_WIDTH - 1 - x, PERFORMANCE_HEIGHT - 1 - y));
+        if( (i % 4) == 0 ){
+            renderer.draw_bitmap(sg_point(y,x), src);
+        }
+    }
+}
+
+bool TiledRendererTest::execute_class_api_case(){
+    Bitmap src(37, 21);
+    Bitmap expected(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT);
+    Bitmap actual(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT);
+    TiledRenderer renderer;
+    bool result = true;
+    u16 threads;
+
+    if( (src.data() == 0) || (expected.data() == 0) || (actual.data() == 0) ){
+        print_case_message("failed to allocate bitmaps");
+        return false;
+    }
+
+    src.fill(0x5a);
+    record(renderer, src);
+
+    expected.clear();
+    renderer.set_thread_count(1);
+    if( renderer.render(expected) < 0 ){
+        print_case_message("failed to render");
+        return false;
+    }
+
+    for(threads = 1; threads <= THREAD_COUNT_MAX; threads++){
+        renderer.set_thread_count(threads);
+
+        renderer.set_tile_size(0, 0);
+        actual.clear();
+        if( (renderer.render(actual) < 0) || !is_match(expected, actual) ){
+            print_case_message("row bands with %d threads don't match", threads);
+            result = false;
+        }
+
+        renderer.set_tile_size(50, 16);
+        actual.clear();
+        if( (renderer.render(actual) < 0) || !is_match(expected, actual) ){
+            print_case_message("narrow tiles with %d threads don't match", threads);
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+bool TiledRendererTest::execute_class_performance_case(){
+    Bitmap src(37, 21);
+    Bitmap bitmap(PERFORMANCE_WIDTH, PERFORMANCE_HEIGHT);
+    TiledRenderer renderer;
+    chrono::Timer timer;
+    char key[32];
+    u16 threads;
+    u32 i;
+
+    if( (src.data() == 0) || (bitmap.data() == 0) ){
+        print_case_message("failed to allocate bitmaps");
+        return false;
+    }
+
+    src.fill(0x5a);
+    record(renderer, src);
+    print_case_message_with_key("commands", "%ld", renderer.count());
+
+    for(threads = 1; threads <= THREAD_COUNT_MAX; threads *= 2){
+        renderer.set_thread_count(threads);
+        timer.restart();
+        for(i=0; i < PERFORMANCE_ITERATIONS; i++){
+            if( renderer.render(bitmap) < 0 ){
+                print_case_message("failed to render with %d threads", threads);
+                return false;
+            }
+        }
+        timer.stop();
+        snprintf(key, sizeof(key), "%d threads", threads);
+        print_case_message_with_key(key, "%ld frames/s", calc_frames_per_second(PERFORMANCE_ITERATIONS, timer.microseconds()));
+    }
+
+    return true;
+}
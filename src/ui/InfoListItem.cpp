@@ -7,6 +7,9 @@
 
 using namespace ui;
 
+//each item draws a label and a value
+static sgfx::TextLayoutCache layout_cache(2*sgfx::TextLayoutCache::DEFAULT_SIZE);
+
 InfoListItem::InfoListItem(LinkedElement * parent) : ListItem("Label", 0, parent, 0) {
 	// TODO Auto-generated constructor stub
 	set(0,0);
@@ -29,6 +32,7 @@ void InfoListItem::draw_to_scale(const DrawingScaledAttr & attr){
 	sg_dim_t d = attr.dim();
 	sg_point_t p = attr.point();
 	Font * font;
+	const sgfx::TextLayout * layout;
 
 	//draw the label and the icon
 	Dim padded;
@@ -52,12 +56,22 @@ void InfoListItem::draw_to_scale(const DrawingScaledAttr & attr){
 			p.y = p.y + d.height/2 - height/2;
 		}
 
-		font->draw_str(label().text(), attr.bitmap(), p);
+		layout = layout_cache.get(*font, label().text());
+		if( layout ){
+			layout->draw(attr.bitmap(), p);
+		} else {
+			font->draw_str(label().text(), attr.bitmap(), p);
+		}
 
 		//draw the value on the right side
-		len = font->calc_len(value().text());
+		layout = layout_cache.get(*font, value().text());
+		len = layout ? layout->width() : font->calc_len(value().text());
 		p.x = p.x + d.width - len - d.width/40;
-		font->draw_str(value().text(), attr.bitmap(), p);
+		if( layout ){
+			layout->draw(attr.bitmap(), p);
+		} else {
+			font->draw_str(value().text(), attr.bitmap(), p);
+		}
 	}
 }
 
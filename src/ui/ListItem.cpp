@@ -9,6 +9,9 @@
 
 using namespace ui;
 
+//the visible items of a list are drawn on every frame so their layouts are kept
+static sgfx::TextLayoutCache layout_cache;
+
 ListItem::ListItem(const char * label, const sg_vector_icon_t * icon, LinkedElement * parent, LinkedElement * child) : LinkedElement(parent, child){
 	m_text_attr.assign(label);
 	icon_attr().set_attr(icon, Pen(), 0);
@@ -22,6 +25,7 @@ void ListItem::draw_to_scale(const DrawingScaledAttr & attr){
 	Dim d = attr.dim();
 	sg_point_t p = attr.point();
 	char buffer[32];
+	const sgfx::TextLayout * layout;
 
 	int height;
 	sg_point_t icon_point;
@@ -84,7 +88,12 @@ void ListItem::draw_to_scale(const DrawingScaledAttr & attr){
 		}
 	}
 
-	font->draw_str(buffer, attr.bitmap(), p);
+	layout = layout_cache.get(*font, buffer);
+	if( layout ){
+		layout->draw(attr.bitmap(), p);
+	} else {
+		font->draw_str(buffer, attr.bitmap(), p);
+	}
 
 	//draw the icon -- on the right side
 	if( icon_dim.width > 0 ){
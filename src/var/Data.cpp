@@ -30,22 +30,33 @@ u32 Data::block_size(){
     return MALLOC_CHUNK_SIZE;
 }
 
+u32 Data::calc_capacity(u32 size){
+    if( size <= minimum_size() ){
+        return minimum_size();
+    }
+    return minimum_size() + (size - minimum_size() + block_size() - 1) / block_size() * block_size();
+}
+
 Data::Data(){
+    m_o_flags = 0;
     zero();
 }
 
 Data::Data(void * mem, u32 s, bool readonly){
+    m_o_flags = 0;
     zero();
     set(mem, s, readonly);
 }
 
 Data::Data(u32 s){
+    m_o_flags = 0;
     zero();
     alloc(s);
 }
 
 
 Data::Data(const Data & a){
+    m_o_flags = 0;
     zero();
     copy(a);
 }
@@ -132,13 +143,7 @@ int Data::alloc(u32 s, bool resize){
         return 0;
     }
 
-    if( s <= minimum_size() ){
-        s = minimum_size();
-    } else {
-        u32 blocks = (s - minimum_size() + block_size() - 1) / block_size();
-        s = minimum_size() + blocks * block_size();
-    }
-
+    s = calc_capacity(s);
     new_data = malloc(s);
     if( set_error_number_if_null(new_data) == 0 ){
         return -1;